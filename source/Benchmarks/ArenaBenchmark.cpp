@@ -0,0 +1,264 @@
+#include "Benchmark.h"
+#include "Random.h"
+#include "SnakeBody.h"
+#include "SpatialHash.h"
+#include <cmath>
+#include <vector>
+
+using namespace std;
+using namespace Simulation;
+using namespace Benchmarks;
+
+namespace
+{
+	const uint32_t SnakeLength = 32;
+
+	// Cells per snake segment; keeps the arena about 3% occupied at any snake count.
+	const uint32_t CellsPerSegment = 32;
+
+	struct ArenaSnake final
+	{
+		SnakeBody<Cell, SnakeLength> Body;
+		Cell Heading;
+		uint32_t Laid;
+	};
+
+	// Many snakes wandering a square arena, each dying on a wall or on any body and
+	// respawning somewhere free. Hashed arenas answer "what is on this cell" from a
+	// SpatialHash; the others scan every segment of every snake, which is what the hash
+	// replaces.
+	template <bool Hashed>
+	class Arena final
+	{
+	public:
+		Arena(uint32_t snakeCount, uint32_t seed) :
+			mSnakes(snakeCount), mHash(snakeCount * SnakeLength), mRandom(seed), mCollisions(0)
+		{
+			// Past Cell::MaxExtent the coordinates would wrap, so larger arenas are just more crowded.
+			const int32_t side = static_cast<int32_t>(sqrt(static_cast<double>(snakeCount * SnakeLength * CellsPerSegment)));
+			mSide = side < Cell::MaxExtent ? side : Cell::MaxExtent;
+			for (uint32_t id = 0; id < snakeCount; id++)
+			{
+				mSnakes[id].Laid = 0;
+				Spawn(id);
+			}
+		}
+
+		int32_t Side() const
+		{
+			return mSide;
+		}
+
+		uint64_t Collisions() const
+		{
+			return mCollisions;
+		}
+
+		const vector<ArenaSnake>& Snakes() const
+		{
+			return mSnakes;
+		}
+
+		const SpatialHash& Hash() const
+		{
+			return mHash;
+		}
+
+		void Tick()
+		{
+			for (uint32_t id = 0; id < mSnakes.size(); id++)
+			{
+				ArenaSnake& snake = mSnakes[id];
+				const uint32_t turn = mRandom.Next() & 15;
+				if (turn == 0)
+				{
+					snake.Heading = Cell(-snake.Heading.y, snake.Heading.x);
+				}
+				else if (turn == 1)
+				{
+					snake.Heading = Cell(snake.Heading.y, -snake.Heading.x);
+				}
+
+				const Cell next = snake.Body.Front() + snake.Heading;
+				const bool growing = snake.Body.PendingGrowth() > 0 && snake.Body.Size() < snake.Body.Capacity();
+				if (!InBounds(next) || Blocked(next, id, !growing))
+				{
+					++mCollisions;
+					Kill(id);
+					Spawn(id);
+					continue;
+				}
+
+				// The tail leaves before the head arrives, so a snake may chase its own tail.
+				if (Hashed && !growing)
+				{
+					mHash.Erase(snake.Body.Back());
+				}
+				snake.Body.Advance(next);
+				if (Hashed)
+				{
+					mHash.Insert(next, id, snake.Laid);
+				}
+				++snake.Laid;
+			}
+		}
+
+	private:
+		bool InBounds(const Cell& cell) const
+		{
+			return cell.x >= 0 && cell.x < mSide && cell.y >= 0 && cell.y < mSide;
+		}
+
+		bool Blocked(const Cell& cell, uint32_t self, bool tailLeaving) const
+		{
+			const ArenaSnake& snake = mSnakes[self];
+			if (Hashed)
+			{
+				const SpatialHash::Occupant* occupant = mHash.Find(cell);
+				return occupant != nullptr && !(tailLeaving && occupant->SnakeId == self && occupant->Segment == snake.Laid - snake.Body.Size());
+			}
+
+			for (uint32_t id = 0; id < mSnakes.size(); id++)
+			{
+				const SnakeBody<Cell, SnakeLength>& body = mSnakes[id].Body;
+				for (uint32_t i = 0; i < body.Size(); i++)
+				{
+					if (body[i] == cell && !(tailLeaving && id == self && i == body.Size() - 1))
+					{
+						return true;
+					}
+				}
+			}
+
+			return false;
+		}
+
+		void Kill(uint32_t id)
+		{
+			SnakeBody<Cell, SnakeLength>& body = mSnakes[id].Body;
+			if (Hashed)
+			{
+				for (uint32_t i = 0; i < body.Size(); i++)
+				{
+					mHash.Erase(body[i]);
+				}
+			}
+			body.Clear();
+		}
+
+		void Spawn(uint32_t id)
+		{
+			ArenaSnake& snake = mSnakes[id];
+			Cell cell;
+			do
+			{
+				cell = Cell(mRandom.Next() % mSide, mRandom.Next() % mSide);
+			} while (Blocked(cell, id, false));
+
+			static const Cell Headings[] = { Cell(0, 1), Cell(0, -1), Cell(-1, 0), Cell(1, 0) };
+			snake.Heading = Headings[mRandom.Next() & 3];
+			snake.Body.Grow(SnakeLength);
+			snake.Body.Advance(cell);
+			if (Hashed)
+			{
+				mHash.Insert(cell, id, snake.Laid);
+			}
+			++snake.Laid;
+		}
+
+		vector<ArenaSnake> mSnakes;
+		SpatialHash mHash;
+		Random mRandom;
+		int32_t mSide;
+		uint64_t mCollisions;
+	};
+
+	// Both arenas draw the same random numbers, so they must agree on every collision and
+	// every segment; the hash must also hold exactly the live segments.
+	bool Verify(uint32_t snakeCount, uint32_t ticks)
+	{
+		Arena<true> hashed(snakeCount, 11);
+		Arena<false> scanned(snakeCount, 11);
+		for (uint32_t tick = 0; tick < ticks; tick++)
+		{
+			hashed.Tick();
+			scanned.Tick();
+		}
+
+		if (hashed.Collisions() != scanned.Collisions())
+		{
+			return false;
+		}
+
+		uint32_t segments = 0;
+		for (uint32_t id = 0; id < snakeCount; id++)
+		{
+			const SnakeBody<Cell, SnakeLength>& body = hashed.Snakes()[id].Body;
+			const SnakeBody<Cell, SnakeLength>& expected = scanned.Snakes()[id].Body;
+			if (body.Size() != expected.Size())
+			{
+				return false;
+			}
+
+			for (uint32_t i = 0; i < body.Size(); i++)
+			{
+				const SpatialHash::Occupant* occupant = hashed.Hash().Find(body[i]);
+				if (body[i] != expected[i] || occupant == nullptr || occupant->SnakeId != id)
+				{
+					return false;
+				}
+			}
+			segments += body.Size();
+		}
+
+		return hashed.Hash().Size() == segments;
+	}
+
+	template <bool Hashed>
+	double MeasureTick(uint32_t snakeCount, uint32_t ticks, uint64_t& collisions)
+	{
+		Arena<Hashed> arena(snakeCount, 7);
+		const double nanoseconds = MeasureNanoseconds(ticks, [&](uint64_t) {
+			arena.Tick();
+		});
+		collisions = arena.Collisions();
+		Consume(arena.Snakes()[0].Body.Front());
+
+		return nanoseconds / snakeCount;
+	}
+
+	void Run(uint32_t snakeCount)
+	{
+		// Roughly the same number of snake-steps per run; the scan is quadratic, so it gets
+		// only as many ticks as it can finish in reasonable time.
+		const uint32_t hashTicks = 20000000 / snakeCount;
+		const uint64_t scanWork = static_cast<uint64_t>(snakeCount) * snakeCount * SnakeLength;
+		const uint32_t scanTicks = static_cast<uint32_t>(max<uint64_t>(1, 2000000000ull / scanWork));
+
+		uint64_t hashCollisions = 0;
+		uint64_t scanCollisions = 0;
+		const double hashed = MeasureTick<true>(snakeCount, hashTicks, hashCollisions);
+		const double scanned = MeasureTick<false>(snakeCount, scanTicks, scanCollisions);
+
+		Arena<true> arena(snakeCount, 7);
+		const uint64_t denseBytes = static_cast<uint64_t>(arena.Side()) * arena.Side() * sizeof(SpatialHash::Occupant);
+		const uint64_t hashBytes = static_cast<uint64_t>(arena.Hash().Capacity()) * (sizeof(SpatialHash::Occupant) + sizeof(uint32_t));
+
+		printf("%5u snakes on %4dx%-4d: hash %6.1f ns per snake-step, scan %10.1f ns (%.0fx), %llu collisions in %u ticks, hash %6llu KB vs dense %6llu KB, %s\n",
+			snakeCount, arena.Side(), arena.Side(), hashed, scanned, scanned / hashed,
+			static_cast<unsigned long long>(hashCollisions), hashTicks,
+			static_cast<unsigned long long>(hashBytes / 1024), static_cast<unsigned long long>(denseBytes / 1024),
+			Verify(snakeCount, max<uint32_t>(2, scanTicks / 4)) ? "matches scan" : "MISMATCH");
+		Consume(scanCollisions);
+	}
+}
+
+int main()
+{
+	printf("Snake length %u, arena sized to %u cells per segment\n", SnakeLength, CellsPerSegment);
+	Run(100);
+	Run(1000);
+	Run(10000);
+
+	return 0;
+}
@@ -0,0 +1,141 @@
+#include "Benchmark.h"
+#include "BatchSimulator.h"
+#include "Board.h"
+#include "Random.h"
+#include "Tour.h"
+#include <vector>
+
+using namespace std;
+using namespace Simulation;
+using namespace Benchmarks;
+
+namespace
+{
+	// Actions are drawn up front so the measurement covers the simulator alone.
+	const uint32_t ActionFrames = 251;
+
+	void Run(uint32_t gameCount, uint64_t totalSteps)
+	{
+		BatchSimulator simulator(gameCount);
+		vector<Action> actions(static_cast<size_t>(gameCount) * ActionFrames);
+		vector<float> rewards(gameCount);
+		vector<uint8_t> dones(gameCount);
+
+		uint32_t random = 0x2545F491u;
+		for (Action& action : actions)
+		{
+			Random::Next(random);
+
+			// Mostly keep going so games last long enough to eat
+			action = random % 4 != 0 ? Action::Continue : static_cast<Action>(1 + (random >> 8) % 4);
+		}
+
+		uint64_t episodes = 0;
+		uint64_t food = 0;
+		const uint64_t ticks = max<uint64_t>(totalSteps / gameCount, 1);
+		double nanoseconds = MeasureNanoseconds(ticks, [&](uint64_t tick) {
+			simulator.StepAll(&actions[(tick % ActionFrames) * gameCount], rewards.data(), dones.data());
+			for (uint32_t game = 0; game < gameCount; game++)
+			{
+				episodes += dones[game];
+				food += rewards[game] > 0.0f ? 1 : 0;
+			}
+		});
+
+		const double perGameStep = nanoseconds / gameCount;
+		printf("%6u games: %7.2f ns/game-step, %7.2f million game-steps/s (%llu episodes, %llu food)\n", gameCount, perGameStep, 1000.0 / perGameStep,
+			static_cast<unsigned long long>(episodes), static_cast<unsigned long long>(food));
+	}
+
+	// Steers every game along the tour until its snake fills the board, and checks where
+	// food respawns: never on the body, and on crowded boards, where sampling gives up and
+	// the free cells are counted through, at a uniformly random one of them. Ranked among
+	// the free cells in board order, the chosen cell then sits halfway on average.
+	bool CheckFood(uint32_t gameCount)
+	{
+		const vector<TourCell> tour = BuildTour(Board::Width, Board::Height);
+		vector<Action> autopilot(Board::CellCount);
+		for (size_t i = 0; i < tour.size(); i++)
+		{
+			const TourCell& from = tour[i];
+			const TourCell& to = tour[(i + 1) % tour.size()];
+			autopilot[from.y * Board::Width + from.x] = to.x > from.x ? Action::Right : to.x < from.x ? Action::Left : to.y > from.y ? Action::Up : Action::Down;
+		}
+
+		BatchSimulator simulator(gameCount, 7);
+		vector<Action> actions(gameCount);
+		vector<float> rewards(gameCount);
+		vector<uint8_t> dones(gameCount);
+		vector<uint8_t> filled(gameCount);
+		vector<uint8_t> occupancy(Board::CellCount);
+
+		const uint32_t crowded = 64;
+		uint64_t placements = 0;
+		uint64_t onBody = 0;
+		uint64_t crowdedPlacements = 0;
+		double rankSum = 0.0;
+		uint32_t finished = 0;
+		while (finished < gameCount)
+		{
+			for (uint32_t game = 0; game < gameCount; game++)
+			{
+				actions[game] = autopilot[Board::CellIndex(simulator.Head(game))];
+			}
+			simulator.StepAll(actions.data(), rewards.data(), dones.data());
+
+			for (uint32_t game = 0; game < gameCount; game++)
+			{
+				if (dones[game] != 0 && filled[game] == 0)
+				{
+					filled[game] = 1;
+					++finished;
+				}
+				if (rewards[game] <= 0.0f || dones[game] != 0)
+				{
+					continue;
+				}
+
+				fill(occupancy.begin(), occupancy.end(), static_cast<uint8_t>(0));
+				for (uint32_t i = 0; i < simulator.Length(game); i++)
+				{
+					occupancy[Board::CellIndex(simulator.BodyAt(game, i))] = 1;
+				}
+
+				const uint32_t food = static_cast<uint32_t>(Board::CellIndex(simulator.Food(game)));
+				const uint32_t freeCount = Board::CellCount - simulator.Length(game);
+				++placements;
+				onBody += occupancy[food];
+				if (freeCount <= crowded)
+				{
+					uint32_t rank = 0;
+					for (uint32_t cell = 0; cell < food; cell++)
+					{
+						rank += occupancy[cell] == 0 ? 1 : 0;
+					}
+					rankSum += (rank + 0.5) / freeCount;
+					++crowdedPlacements;
+				}
+			}
+		}
+
+		const double meanRank = rankSum / crowdedPlacements;
+		printf("%llu food placements, %llu on the body; %llu with %u or fewer cells free, mean rank %.3f (uniform 0.500)\n",
+			static_cast<unsigned long long>(placements), static_cast<unsigned long long>(onBody), static_cast<unsigned long long>(crowdedPlacements),
+			crowded, meanRank);
+
+		return onBody == 0 && crowdedPlacements > 0 && meanRank > 0.45 && meanRank < 0.55;
+	}
+}
+
+int main()
+{
+	const uint64_t totalSteps = 50000000;
+
+	Run(1, totalSteps);
+	Run(64, totalSteps);
+	Run(4096, totalSteps);
+
+	const bool valid = CheckFood(256);
+	printf("Food %s\n", valid ? "respawns uniformly on free cells" : "RESPAWNS ON THE BODY OR UNEVENLY");
+	return valid ? 0 : 1;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+namespace Benchmarks
+{
+	// Runs body(iteration) the requested number of times and returns the mean cost of one call.
+	template <typename TBody>
+	double MeasureNanoseconds(std::uint64_t iterations, const TBody& body)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (std::uint64_t i = 0; i < iterations; i++)
+		{
+			body(i);
+		}
+		auto end = std::chrono::steady_clock::now();
+
+		return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(iterations);
+	}
+
+	inline volatile std::uint8_t& Sink()
+	{
+		static volatile std::uint8_t sink = 0;
+		return sink;
+	}
+
+	// Keeps the optimizer from discarding work whose result is otherwise unused.
+	template <typename T>
+	void Consume(const T& value)
+	{
+		const volatile std::uint8_t* bytes = reinterpret_cast<const volatile std::uint8_t*>(&value);
+		Sink() = bytes[0];
+	}
+}
@@ -0,0 +1,131 @@
+#include "Benchmark.h"
+#include "OccupancyGrid.h"
+#include "SnakeBody.h"
+#include "Tour.h"
+#include <vector>
+
+using namespace std;
+using namespace Simulation;
+using namespace Benchmarks;
+
+namespace
+{
+	const int32_t BoardWidth = 54;
+	const int32_t BoardHeight = 26;
+
+	// One tick of the incremental scheme: move, keep the grid in sync, look up the head cell.
+	double OccupancyTick(const vector<TourCell>& tour, uint32_t length, uint64_t ticks)
+	{
+		SnakeBody<TourCell, BoardWidth * BoardHeight> body;
+		OccupancyGrid grid;
+		body.Grow(length);
+		uint32_t alive = 0;
+
+		auto step = [&](uint64_t tick) {
+			const TourCell& head = tour[tick % tour.size()];
+			TourCell retracted;
+			if (body.Advance(head, &retracted))
+			{
+				grid.RemoveBody(retracted.x, retracted.y);
+			}
+			grid.AddBody(head.x, head.y);
+			alive += grid.BodyCount(head.x, head.y) > 1 ? 0 : 1;
+		};
+
+		for (uint32_t i = 0; i < length; i++)
+		{
+			step(i);
+		}
+		double nanoseconds = MeasureNanoseconds(ticks, [&](uint64_t tick) { step(tick + length); });
+		Consume(alive);
+
+		return nanoseconds;
+	}
+
+	// After each spurt of growth the snake keeps moving, so it retracts its oldest segment
+	// while the ring buffer is still far from full; the grid must then count exactly the
+	// segments a scan of the body finds in every cell.
+	bool GridMatchesBody(const vector<TourCell>& tour)
+	{
+		SnakeBody<TourCell, BoardWidth * BoardHeight> body;
+		OccupancyGrid grid;
+		uint64_t tick = 0;
+		const uint32_t growths[] = { 1, 9, 90, 400 };
+		for (uint32_t growth : growths)
+		{
+			body.Grow(growth);
+			for (uint64_t end = tick + growth + tour.size() / 3; tick < end; tick++)
+			{
+				const TourCell& head = tour[tick % tour.size()];
+				TourCell retracted;
+				if (body.Advance(head, &retracted))
+				{
+					grid.RemoveBody(retracted.x, retracted.y);
+				}
+				grid.AddBody(head.x, head.y);
+			}
+
+			for (int32_t y = 0; y < BoardHeight; y++)
+			{
+				for (int32_t x = 0; x < BoardWidth; x++)
+				{
+					uint32_t scanned = 0;
+					for (uint32_t i = 0; i < body.Size(); i++)
+					{
+						scanned += (body[i].x == x && body[i].y == y) ? 1 : 0;
+					}
+					if (grid.BodyCount(x, y) != scanned)
+					{
+						return false;
+					}
+				}
+			}
+		}
+		return true;
+	}
+
+	// The previous scheme: move, then compare the head against every body segment.
+	double LinearScanTick(const vector<TourCell>& tour, uint32_t length, uint64_t ticks)
+	{
+		SnakeBody<TourCell, BoardWidth * BoardHeight> body;
+		body.Grow(length);
+		uint32_t alive = 0;
+
+		auto step = [&](uint64_t tick) {
+			const TourCell& head = tour[tick % tour.size()];
+			body.Advance(head);
+			bool collided = false;
+			for (uint32_t i = 1; i < body.Size(); i++)
+			{
+				collided |= (body[i].x == head.x && body[i].y == head.y);
+			}
+			alive += collided ? 0 : 1;
+		};
+
+		for (uint32_t i = 0; i < length; i++)
+		{
+			step(i);
+		}
+		double nanoseconds = MeasureNanoseconds(ticks, [&](uint64_t tick) { step(tick + length); });
+		Consume(alive);
+
+		return nanoseconds;
+	}
+}
+
+int main()
+{
+	const vector<TourCell> tour = BuildTour(BoardWidth, BoardHeight);
+	const bool valid = GridMatchesBody(tour);
+	const uint32_t lengths[] = { 10, 100, 500, 1000, static_cast<uint32_t>(BoardWidth * BoardHeight) };
+	const uint64_t ticks = 2000000;
+
+	printf("%12s %18s %18s\n", "length", "grid ns/tick", "scan ns/tick");
+	for (uint32_t length : lengths)
+	{
+		printf("%12u %18.2f %18.2f\n", length, OccupancyTick(tour, length, ticks), LinearScanTick(tour, length, ticks / 10));
+	}
+
+	printf("Occupancy grid %s\n", valid ? "matches a scan of the body" : "DISAGREES WITH THE BODY");
+	return valid ? 0 : 1;
+}
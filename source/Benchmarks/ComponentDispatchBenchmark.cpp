@@ -0,0 +1,265 @@
+#include "Benchmark.h"
+#include "ComponentList.h"
+#include "Random.h"
+#include <memory>
+#include <vector>
+
+using namespace std;
+using namespace Simulation;
+using namespace Benchmarks;
+
+namespace
+{
+	const uint32_t ComponentCount = 10000;
+
+	// Stand-ins for DX::GameComponent and DX::DrawableGameComponent. Update() and Render()
+	// only log their calls, so the dispatch is what gets timed.
+	class Component
+	{
+	public:
+		Component(uint32_t id, vector<uint32_t>& log) :
+			mId(id), mLog(&log), mEnabled(true)
+		{
+		}
+		Component(const Component&) = default;
+		Component& operator=(const Component&) = default;
+		Component(Component&&) = default;
+		Component& operator=(Component&&) = default;
+		virtual ~Component() = default;
+
+		uint32_t Id() const { return mId; }
+		bool Enabled() const { return mEnabled; }
+		void SetEnabled(bool enabled) { mEnabled = enabled; }
+
+		virtual void Update()
+		{
+			mLog->push_back(mId);
+		}
+
+	protected:
+		uint32_t mId;
+		vector<uint32_t>* mLog;
+		bool mEnabled;
+	};
+
+	class DrawableComponent final : public Component
+	{
+	public:
+		DrawableComponent(uint32_t id, vector<uint32_t>& log) :
+			Component(id, log), mVisible(true)
+		{
+		}
+
+		bool Visible() const { return mVisible; }
+		void SetVisible(bool visible) { mVisible = visible; }
+
+		void Render()
+		{
+			mLog->push_back(mId | 0x80000000u);
+		}
+
+	private:
+		bool mVisible;
+	};
+
+	// Half the components draw; one in ten is disabled and one in ten drawables is hidden.
+	vector<shared_ptr<Component>> BuildComponents(vector<uint32_t>& log)
+	{
+		Random random(77);
+		vector<shared_ptr<Component>> components;
+		for (uint32_t i = 0; i < ComponentCount; i++)
+		{
+			if (random.Next() % 2 == 0)
+			{
+				auto drawable = make_shared<DrawableComponent>(i, log);
+				drawable->SetVisible(random.Next() % 10 != 0);
+				components.push_back(drawable);
+			}
+			else
+			{
+				components.push_back(make_shared<Component>(i, log));
+			}
+			components.back()->SetEnabled(random.Next() % 10 != 0);
+		}
+
+		return components;
+	}
+
+	// GameMain before the registry: update everything, then cast every component to see
+	// whether it draws.
+	void DispatchByCasting(const vector<shared_ptr<Component>>& components)
+	{
+		for (auto& component : components)
+		{
+			component->Update();
+		}
+		for (auto& component : components)
+		{
+			auto drawable = dynamic_pointer_cast<DrawableComponent>(component);
+			if (drawable != nullptr && drawable->Visible())
+			{
+				drawable->Render();
+			}
+		}
+	}
+
+	class Registry final
+	{
+	public:
+		void Add(const shared_ptr<Component>& component)
+		{
+			mUpdateList.Add(component.get(), component->Enabled());
+			auto drawable = dynamic_cast<DrawableComponent*>(component.get());
+			if (drawable != nullptr)
+			{
+				mRenderList.Add(drawable, drawable->Visible());
+			}
+		}
+
+		void Remove(const shared_ptr<Component>& component)
+		{
+			mUpdateList.Remove(component.get());
+			mRenderList.Remove(dynamic_cast<const DrawableComponent*>(component.get()));
+		}
+
+		void SetEnabled(Component& component, bool enabled)
+		{
+			component.SetEnabled(enabled);
+			mUpdateList.SetActive(&component, enabled);
+		}
+
+		void SetVisible(DrawableComponent& component, bool visible)
+		{
+			component.SetVisible(visible);
+			mRenderList.SetActive(&component, visible);
+		}
+
+		void Dispatch()
+		{
+			for (Component* component : mUpdateList.Active())
+			{
+				component->Update();
+			}
+			for (DrawableComponent* component : mRenderList.Active())
+			{
+				component->Render();
+			}
+		}
+
+	private:
+		ComponentList<Component> mUpdateList;
+		ComponentList<DrawableComponent> mRenderList;
+	};
+
+	// What a frame should call, worked out the slow way.
+	vector<uint32_t> ExpectedCalls(const vector<shared_ptr<Component>>& components)
+	{
+		vector<uint32_t> calls;
+		for (auto& component : components)
+		{
+			if (component->Enabled())
+			{
+				calls.push_back(component->Id());
+			}
+		}
+		for (auto& component : components)
+		{
+			auto drawable = dynamic_pointer_cast<DrawableComponent>(component);
+			if (drawable != nullptr && drawable->Visible())
+			{
+				calls.push_back(drawable->Id() | 0x80000000u);
+			}
+		}
+
+		return calls;
+	}
+}
+
+int main()
+{
+	vector<uint32_t> log;
+	log.reserve(2 * ComponentCount);
+	vector<shared_ptr<Component>> components = BuildComponents(log);
+
+	const double castNanoseconds = MeasureNanoseconds(1000, [&](uint64_t) {
+		log.clear();
+		DispatchByCasting(components);
+	});
+
+	Registry registry;
+	const double addNanoseconds = MeasureNanoseconds(1, [&](uint64_t) {
+		for (auto& component : components)
+		{
+			registry.Add(component);
+		}
+	});
+
+	log.clear();
+	registry.Dispatch();
+	bool valid = log == ExpectedCalls(components);
+
+	const double listNanoseconds = MeasureNanoseconds(1000, [&](uint64_t) {
+		log.clear();
+		registry.Dispatch();
+	});
+
+	// Switch 1, 10 and 100 components a frame, then check the lists followed.
+	Random random(5);
+	const uint32_t toggleCounts[] = { 1, 10, 100 };
+	double toggleNanoseconds[3];
+	for (uint32_t run = 0; run < 3; run++)
+	{
+		toggleNanoseconds[run] = MeasureNanoseconds(1000, [&](uint64_t) {
+			for (uint32_t i = 0; i < toggleCounts[run]; i++)
+			{
+				Component& component = *components[random.Next() % ComponentCount];
+				registry.SetEnabled(component, !component.Enabled());
+				auto drawable = dynamic_cast<DrawableComponent*>(&component);
+				if (drawable != nullptr)
+				{
+					registry.SetVisible(*drawable, !drawable->Visible());
+				}
+			}
+			log.clear();
+			registry.Dispatch();
+		});
+	}
+	log.clear();
+	registry.Dispatch();
+	valid = valid && log == ExpectedCalls(components);
+
+	// Remove every third component and add them back at the end.
+	vector<shared_ptr<Component>> reordered;
+	vector<shared_ptr<Component>> removed;
+	for (uint32_t i = 0; i < ComponentCount; i++)
+	{
+		(i % 3 == 0 ? removed : reordered).push_back(components[i]);
+	}
+	const double churnNanoseconds = MeasureNanoseconds(1, [&](uint64_t) {
+		for (auto& component : removed)
+		{
+			registry.Remove(component);
+		}
+		for (auto& component : removed)
+		{
+			registry.Add(component);
+		}
+	});
+	reordered.insert(reordered.end(), removed.begin(), removed.end());
+	log.clear();
+	registry.Dispatch();
+	valid = valid && log == ExpectedCalls(reordered);
+
+	printf("%u components, %zu updated and rendered a frame\n", ComponentCount, log.size());
+	printf("dynamic_pointer_cast every frame | %8.1f us/frame\n", castNanoseconds / 1000.0);
+	printf("packed update and render lists   | %8.1f us/frame\n", listNanoseconds / 1000.0);
+	for (uint32_t run = 0; run < 3; run++)
+	{
+		printf("  with %3u toggled a frame       | %8.1f us/frame\n", toggleCounts[run], toggleNanoseconds[run] / 1000.0);
+	}
+	printf("  registering all                | %8.1f us\n", addNanoseconds / 1000.0);
+	printf("  removing and re-adding a third | %8.1f us\n", churnNanoseconds / 1000.0);
+	printf("Component lists %s\n", valid ? "call exactly the enabled and visible components, in registration order" : "CALLED THE WRONG COMPONENTS");
+
+	return valid ? 0 : 1;
+}
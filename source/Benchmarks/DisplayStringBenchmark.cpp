@@ -0,0 +1,237 @@
+#include "Benchmark.h"
+#include "RenderStats.h"
+#include "SegmentFont.h"
+#include "TextCache.h"
+#include <cctype>
+#include <cstring>
+#include <vector>
+
+using namespace std;
+using namespace Simulation;
+using namespace Benchmarks;
+
+namespace
+{
+	const uint32_t MatrixBytes = 64;
+	const uint32_t ColorBytes = 16;
+	const uint32_t SegmentVertexBytes = 2 * 16;
+
+	// SixteenSegmentManager's character lookup before the table.
+	uint16_t LegacyMask(char c)
+	{
+		switch (tolower(c))
+		{
+		case 'a': return SegmentFont::A;
+		case 'b': return SegmentFont::B;
+		case 'c': return SegmentFont::C;
+		case 'd': return SegmentFont::D;
+		case 'e': return SegmentFont::E;
+		case 'f': return SegmentFont::F;
+		case 'g': return SegmentFont::G;
+		case 'h': return SegmentFont::H;
+		case 'i': return SegmentFont::I;
+		case 'j': return SegmentFont::J;
+		case 'k': return SegmentFont::K;
+		case 'l': return SegmentFont::L;
+		case 'm': return SegmentFont::M;
+		case 'n': return SegmentFont::N;
+		case 'o': return SegmentFont::O;
+		case 'p': return SegmentFont::P;
+		case 'q': return SegmentFont::Q;
+		case 'r': return SegmentFont::R;
+		case 's': return SegmentFont::S;
+		case 't': return SegmentFont::T;
+		case 'u': return SegmentFont::U;
+		case 'v': return SegmentFont::V;
+		case 'w': return SegmentFont::W;
+		case 'x': return SegmentFont::X;
+		case 'y': return SegmentFont::Y;
+		case 'z': return SegmentFont::Z;
+		case '0': return SegmentFont::ZERO;
+		case '1': return SegmentFont::ONE;
+		case '2': return SegmentFont::TWO;
+		case '3': return SegmentFont::THREE;
+		case '4': return SegmentFont::FOUR;
+		case '5': return SegmentFont::FIVE;
+		case '6': return SegmentFont::SIX;
+		case '7': return SegmentFont::SEVEN;
+		case '8': return SegmentFont::EIGHT;
+		case '9': return SegmentFont::NINE;
+		default: return 0;
+		}
+	}
+
+	uint32_t PopCount(uint16_t mask)
+	{
+		uint32_t count = 0;
+		for (; mask != 0; mask &= mask - 1)
+		{
+			++count;
+		}
+
+		return count;
+	}
+
+	// The old DisplayString(): strlen every iteration, the pipeline and matrix set up again
+	// for every character, then a vertex map, a color upload and a draw per lit segment.
+	void LegacyDisplayString(const char* word, float x, float y, RenderStats& stats)
+	{
+		for (uint32_t i = 0; i < strlen(word); i++)
+		{
+			stats.RecordUpload(MatrixBytes);
+			uint16_t mask = LegacyMask(word[i]);
+			for (uint32_t segment = 0; segment < SegmentFont::SegmentCount; segment++, mask >>= 1)
+			{
+				if (mask & 1)
+				{
+					const SegmentFont::Line& line = SegmentFont::Segment(segment);
+					const SegmentFont::Line vertices = { x + 50 * i + line.FromX, y + line.FromY, x + 50 * i + line.ToX, y + line.ToY };
+					Consume(vertices);
+					stats.RecordUpload(SegmentVertexBytes);
+					stats.RecordUpload(ColorBytes);
+					stats.RecordDraw();
+				}
+			}
+		}
+	}
+
+	// SixteenSegmentManager::DisplayString() with the cache holding each string's line
+	// count where the game holds its StaticGeometry. A miss bakes the lines (the immutable
+	// buffers are created with their data, so only the matrix counts as an upload, on the
+	// first draw); a hit is one draw.
+	class CachedText final
+	{
+	public:
+		CachedText() :
+			mBuilds(0)
+		{
+		}
+
+		uint32_t Builds() const
+		{
+			return mBuilds;
+		}
+
+		TextCache<uint32_t>& Cache()
+		{
+			return mCache;
+		}
+
+		void DisplayString(const char* word, float x, float y, RenderStats& stats)
+		{
+			if (mCache.Find(word, x, y) == nullptr)
+			{
+				mLines.clear();
+				mCache.Insert(word, x, y, SegmentFont::AppendLines(word, x, y, mLines));
+				stats.RecordUpload(MatrixBytes);
+				++mBuilds;
+			}
+			stats.RecordDraw();
+		}
+
+	private:
+		TextCache<uint32_t> mCache;
+		vector<SegmentFont::Line> mLines;
+		uint32_t mBuilds;
+	};
+
+	bool CheckFont()
+	{
+		bool valid = true;
+		vector<SegmentFont::Line> lines;
+		for (int c = -128; c < 128; c++)
+		{
+			const char character = static_cast<char>(c);
+			valid = valid && SegmentFont::Mask(character) == (c >= 0 ? LegacyMask(character) : 0);
+
+			lines.clear();
+			const uint32_t count = SegmentFont::AppendLines(SegmentFont::Mask(character), 0.0f, 0.0f, lines);
+			valid = valid && count == PopCount(SegmentFont::Mask(character)) && lines.size() == count;
+		}
+
+		const char* text = "Press Start to Continue";
+		uint32_t expected = 0;
+		for (const char* c = text; *c != '\0'; c++)
+		{
+			expected += PopCount(SegmentFont::Mask(*c));
+		}
+		lines.clear();
+		valid = valid && SegmentFont::AppendLines(text, -550.0f, -100.0f, lines) == expected;
+
+		// The last character starts 22 advances in.
+		const SegmentFont::Line& e = SegmentFont::Segment(0);
+		valid = valid && lines.back().FromX >= -550.0f + 22 * SegmentFont::Advance && lines.front().FromX == -550.0f + e.FromX;
+
+		return valid;
+	}
+
+	// The game-over screen: the same two strings every frame.
+	bool MeasureGameOver(uint32_t frameCount)
+	{
+		RenderStats legacy;
+		RenderStats cached;
+		CachedText text;
+
+		const double legacyNanoseconds = MeasureNanoseconds(frameCount, [&](uint64_t) {
+			legacy.BeginFrame();
+			LegacyDisplayString("Game Over", -225, 50, legacy);
+			LegacyDisplayString("Press Start to Continue", -550, -100, legacy);
+		});
+
+		bool valid = true;
+		const double cachedNanoseconds = MeasureNanoseconds(frameCount, [&](uint64_t frame) {
+			cached.BeginFrame();
+			text.DisplayString("Game Over", -225, 50, cached);
+			text.DisplayString("Press Start to Continue", -550, -100, cached);
+			text.Cache().EndFrame();
+
+			const RenderStats::Counters& counters = cached.CurrentFrame();
+			valid = valid && counters.DrawCalls == 2 && counters.BufferUploads == (frame == 0 ? 2u : 0u);
+		});
+		valid = valid && text.Builds() == 2;
+
+		printf("game over screen | legacy %5u draws %5u uploads %8.0f ns/frame | cached %u draws %u uploads %6.1f ns/frame\n",
+			legacy.CurrentFrame().DrawCalls, legacy.CurrentFrame().BufferUploads, legacyNanoseconds,
+			cached.CurrentFrame().DrawCalls, cached.CurrentFrame().BufferUploads, cachedNanoseconds);
+
+		return valid;
+	}
+
+	// A score that changes every tenth frame: each value is built once and the stale
+	// ones are evicted, so the cache stays small.
+	bool MeasureChangingText(uint32_t frameCount)
+	{
+		RenderStats cached;
+		CachedText text;
+		char score[16];
+		uint32_t largest = 0;
+
+		const double nanoseconds = MeasureNanoseconds(frameCount, [&](uint64_t frame) {
+			cached.BeginFrame();
+			snprintf(score, sizeof(score), "Score %u", static_cast<uint32_t>(frame / 10));
+			text.DisplayString(score, 300, 400, cached);
+			text.DisplayString("Super Snake X", -300, -450, cached);
+			text.Cache().EndFrame();
+
+			largest = text.Cache().Count() > largest ? text.Cache().Count() : largest;
+		});
+
+		const uint32_t values = (frameCount + 9) / 10;
+		const uint32_t bound = 1 + (TextCache<uint32_t>::DefaultMaxIdleFrames + 9) / 10 + 1;
+		const bool valid = text.Builds() == values + 1 && largest <= bound;
+
+		printf("changing score   | %u strings built, at most %u cached, %6.1f ns/frame\n", text.Builds(), largest, nanoseconds);
+
+		return valid;
+	}
+}
+
+int main()
+{
+	bool valid = CheckFont();
+	valid = MeasureGameOver(200000) && valid;
+	valid = MeasureChangingText(200000) && valid;
+	printf("Segment text %s\n", valid ? "matches the old font and redraws unchanged strings in one draw with no uploads" : "BROKE ITS BUDGET");
+
+	return valid ? 0 : 1;
+}
@@ -0,0 +1,222 @@
+#include "Benchmark.h"
+#include "Board.h"
+#include "Game.h"
+#include "SnakeInstances.h"
+#include "Tour.h"
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace std;
+using namespace Simulation;
+using namespace Benchmarks;
+
+namespace
+{
+	// The time frames of frameSeconds add up to, rounded once rather than frame by frame.
+	uint64_t ElapsedNanoseconds(uint64_t frames, double frameSeconds)
+	{
+		return static_cast<uint64_t>(llround(static_cast<double>(frames) * frameSeconds * 1e9));
+	}
+
+	// A snake just turned onto the bottom row along the tour, with the whole row ahead of it,
+	// grown until it ticks at least every intervalMilliseconds.
+	Game StartOfBottomRow(uint32_t intervalMilliseconds)
+	{
+		const vector<Direction> autopilot = BuildAutopilot(Board::Width, Board::Height);
+		Game game(3);
+		const Cell start(1, 0);
+		do
+		{
+			game.Move(autopilot[Board::CellIndex(game.GetSnake().Position())]);
+			game.Step();
+		} while (game.GetSnake().Position() != start);
+
+		while (game.StepInterval() > intervalMilliseconds * 1000000ull)
+		{
+			game.IncreaseTail();
+		}
+
+		return game;
+	}
+
+	// Runs the snake down the bottom row at the given display rate, checking after every
+	// frame that the game has ticked exactly as often as the time fed to it covers. Returns
+	// the ticks run, or 0 if any frame was off.
+	uint64_t RunAlongRow(const Game& start, double framesPerSecond, uint64_t& frames)
+	{
+		Game game = start;
+		const uint64_t interval = game.StepInterval();
+		const uint64_t firstStep = game.StepCount();
+		const int32_t ticksPerFrame = static_cast<int32_t>(ElapsedNanoseconds(1, 1.0 / framesPerSecond) / interval) + 1;
+		frames = 0;
+
+		while (game.GetSnake().Position().x + ticksPerFrame < Board::Width - 1)
+		{
+			game.Update(1.0 / framesPerSecond);
+			++frames;
+
+			// Eating a powerup speeds the snake up mid-frame; the count is only checked at one speed.
+			if (game.StepInterval() != interval)
+			{
+				break;
+			}
+			if (!game.GetSnake().Alive() || game.StepCount() - firstStep != ElapsedNanoseconds(frames, 1.0 / framesPerSecond) / interval)
+			{
+				return 0;
+			}
+		}
+
+		return game.StepCount() - firstStep;
+	}
+
+	// A snake that never moves never dies, so its clock can be run for hours of game time.
+	bool RunForHours(double frameSeconds)
+	{
+		Game game(5);
+		const uint64_t interval = game.StepInterval();
+		const uint64_t frameCount = static_cast<uint64_t>(4 * 3600.0 / frameSeconds);
+		for (uint64_t frame = 1; frame <= frameCount; frame++)
+		{
+			game.Update(frameSeconds);
+			if (game.StepCount() != ElapsedNanoseconds(frame, frameSeconds) / interval)
+			{
+				return false;
+			}
+		}
+
+		return game.GetSnake().Alive();
+	}
+
+	// Feeds the snake down the bottom row in frames of frameSeconds, each owing several
+	// ticks, for as many frames as the row has room for. The seconds fed must come to exactly
+	// floor(seconds / interval) ticks, none dropped. Returns the ticks run, or 0 if any were.
+	uint64_t RunInLongFrames(const Game& start, double frameSeconds)
+	{
+		Game game = start;
+		const uint64_t interval = game.StepInterval();
+		const uint64_t firstStep = game.StepCount();
+		const uint64_t room = static_cast<uint64_t>(Board::Width - 2 - game.GetSnake().Position().x);
+		const uint64_t frames = room * interval / ElapsedNanoseconds(1, frameSeconds);
+		for (uint64_t frame = 0; frame < frames; frame++)
+		{
+			game.Update(frameSeconds);
+		}
+
+		const uint64_t ticks = game.StepCount() - firstStep;
+		const bool exact = game.GetSnake().Alive() && game.StepInterval() == interval && ticks == ElapsedNanoseconds(frames, frameSeconds) / interval;
+		return frames > 0 && exact ? ticks : 0;
+	}
+
+	// Draws a snake moving near its starting speed at 60 frames per second; between ticks every
+	// segment must sit exactly the tick's progress of the way from where the segment behind
+	// it is to where it is.
+	bool CheckInterpolation()
+	{
+		Game game = StartOfBottomRow(200);
+		unique_ptr<SnakeInstances> instances = make_unique<SnakeInstances>();
+		bool valid = true;
+		for (uint32_t frame = 0; frame < 600 && game.GetSnake().Position().x < Board::Width - 2; frame++)
+		{
+			game.Update(1.0 / 60.0);
+			const float blend = game.TickProgress();
+			instances->Update(game);
+
+			// The tail covers the head's cell, so instance i is tail segment i, on its way from
+			// where segment i + 1 is now. The head glides like the rest of the body.
+			const Snake& snake = game.GetSnake();
+			const uint32_t count = snake.GetTailSize();
+			valid = valid && instances->Count() == count && snake.GetTailAt(0) == snake.Position();
+			for (uint32_t i = 0; valid && i + 1 < count; i++)
+			{
+				const Vector2f to = Board::ToWorld(snake.GetTailAt(i));
+				const Vector2f from = Board::ToWorld(snake.GetTailAt(i + 1));
+				const Vector2f drawn = instances->Position(i, blend);
+				valid = fabs(drawn.x - (from.x + (to.x - from.x) * blend)) < 1e-3f && fabs(drawn.y - (from.y + (to.y - from.y) * blend)) < 1e-3f;
+			}
+		}
+
+		return valid;
+	}
+}
+
+int main()
+{
+	bool valid = true;
+
+	const uint32_t intervals[] = { 250, 100, 50, 20, 10, 5 };
+	const double displayRates[] = { 30.0, 60.0, 144.0 };
+	for (uint32_t interval : intervals)
+	{
+		const Game start = StartOfBottomRow(interval);
+		printf("%3.0f ticks/s |", 1e9 / static_cast<double>(start.StepInterval()));
+		for (double displayRate : displayRates)
+		{
+			uint64_t frames = 0;
+			const uint64_t ticks = RunAlongRow(start, displayRate, frames);
+			valid = valid && ticks > 0;
+			printf(" %3.0f Hz: %3llu ticks in %3llu frames, %4.2f a frame%s |", displayRate, static_cast<unsigned long long>(ticks), static_cast<unsigned long long>(frames),
+				static_cast<double>(ticks) / static_cast<double>(frames), ticks > 0 ? "" : " OFF");
+		}
+		printf("\n");
+	}
+
+	const double frameSeconds[] = { 1.0 / 144.0, 1.0 / 60.0, 0.1, 0.3, 0.7, 1.0 };
+	for (double frame : frameSeconds)
+	{
+		const bool exact = RunForHours(frame);
+		valid = valid && exact;
+		printf("4 hours of %7.4f s frames at 4 ticks/s: %s\n", frame, exact ? "exact" : "OFF");
+	}
+
+	// Frames long enough to owe dozens of ticks still run every one of them.
+	const double longFrames[] = { 0.05, 0.1, 0.25 };
+	for (uint32_t interval : intervals)
+	{
+		const Game start = StartOfBottomRow(interval);
+		printf("%3.0f ticks/s |", 1e9 / static_cast<double>(start.StepInterval()));
+		for (double frame : longFrames)
+		{
+			const uint64_t ticks = RunInLongFrames(start, frame);
+			valid = valid && ticks > 0;
+			printf(" %4.2f s frames: %3llu ticks%s |", frame, static_cast<unsigned long long>(ticks), ticks > 0 ? "" : " OFF");
+		}
+		printf("\n");
+	}
+
+	// Powerups stop speeding the snake up at Snake::MinSpeed.
+	Game fastest(5);
+	for (uint32_t i = 0; i < 100; i++)
+	{
+		fastest.IncreaseTail();
+	}
+	const bool floored = fastest.StepInterval() == static_cast<uint64_t>(llround(Snake::MinSpeed * 1e6)) * 1000;
+	valid = valid && floored;
+	printf("Fastest tick: %s\n", floored ? "Snake::MinSpeed" : "OFF");
+
+	// A stall runs the ticks MaxCatchUpNanoseconds covers and drops the rest.
+	Game stalled(5);
+	const uint64_t stallInterval = stalled.StepInterval();
+	stalled.Update(60.0);
+	const bool capped = stalled.StepCount() == Game::MaxCatchUpNanoseconds / stallInterval && stalled.TickProgress() == 0.0f;
+	valid = valid && capped;
+	printf("A 60 s stall runs %llu ticks\n", static_cast<unsigned long long>(stalled.StepCount()));
+
+	const bool interpolated = CheckInterpolation();
+	valid = valid && interpolated;
+
+	Game timed = StartOfBottomRow(10);
+	const double update = MeasureNanoseconds(20, [&](uint64_t) {
+		Game game = timed;
+		for (uint32_t frame = 0; frame < 60; frame++)
+		{
+			game.Update(1.0 / 60.0);
+		}
+		Consume(game.StepCount());
+	});
+	printf("Update at 100 ticks/s, 60 Hz: %.0f ns a frame (including copying the game)\n", update / 60.0);
+
+	printf("Snake drawn between ticks %s\n", interpolated ? "where the tick's progress puts it" : "OFF THE INTERPOLATED POSITIONS");
+	printf("Fixed-step updates %s\n", valid ? "tick exactly as often as the time fed to them covers" : "TICKED THE WRONG NUMBER OF TIMES");
+	return valid ? 0 : 1;
+}
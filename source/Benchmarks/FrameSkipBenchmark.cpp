@@ -0,0 +1,184 @@
+#include "Benchmark.h"
+#include "Board.h"
+#include "FrameSkipper.h"
+#include "Game.h"
+#include "SoftwareRasterizer.h"
+#include "Tour.h"
+#include <vector>
+
+using namespace std;
+using namespace Simulation;
+using namespace Benchmarks;
+
+namespace
+{
+	const uint32_t ScreenWidth = 1600;
+	const uint32_t ScreenHeight = 900;
+	const double FrameSeconds = 1.0 / 60;
+	const uint32_t FrameCount = 60 * 30;
+
+	// What the game's components compare against the last drawn frame: the snake and the
+	// powerups only move on a tick, and the game-over text follows Alive().
+	struct VisualState final
+	{
+		uint64_t StepCount;
+		bool Alive;
+
+		bool operator!=(const VisualState& other) const
+		{
+			return StepCount != other.StepCount || Alive != other.Alive;
+		}
+	};
+
+	VisualState Capture(const Game& game)
+	{
+		return { game.StepCount(), game.GetSnake().Alive() };
+	}
+
+	// The walls, powerups and snake as DX::QuadBatch would hand them over.
+	class SceneRenderer final
+	{
+	public:
+		SceneRenderer() :
+			mRasterizer(ScreenWidth, ScreenHeight, 1)
+		{
+			Matrix4 viewProjection = {};
+			viewProjection.M[0][0] = 2.0f / ScreenWidth;
+			viewProjection.M[1][1] = 2.0f / ScreenHeight;
+			viewProjection.M[2][2] = 1.0f;
+			viewProjection.M[3][3] = 1.0f;
+			mRasterizer.SetViewProjection(viewProjection);
+		}
+
+		uint64_t Render(const Game& game)
+		{
+			mRasterizer.Clear(0.0f, 0.0f, 0.0f, 1.0f);
+
+			const float cell = static_cast<float>(Board::CellSize);
+			AddQuad(-800.0f, Board::Top(), 800.0f, 450.0f, 0.3f, 0.3f, 0.3f);
+			AddQuad(-800.0f, Board::Bottom() - cell, 800.0f, Board::Bottom(), 0.3f, 0.3f, 0.3f);
+			AddQuad(-800.0f, Board::Bottom(), Board::Left(), Board::Top(), 0.3f, 0.3f, 0.3f);
+			AddQuad(Board::Right(), Board::Bottom(), 800.0f, Board::Top(), 0.3f, 0.3f, 0.3f);
+
+			const Vector2f cherry = Board::ToWorld(game.GetPowerups().GetCherryPosition());
+			const Vector2f coin = Board::ToWorld(game.GetPowerups().GetCoinPosition());
+			AddQuad(cherry.x + 1, cherry.y + 1, cherry.x + cell - 1, cherry.y + cell - 1, 1.0f, 0.0f, 0.0f);
+			AddQuad(coin.x + 1, coin.y + 1, coin.x + cell - 1, coin.y + cell - 1, 1.0f, 1.0f, 0.0f);
+
+			const Snake& snake = game.GetSnake();
+			for (uint32_t i = 0; i <= snake.GetTailSize(); i++)
+			{
+				const Vector2f position = Board::ToWorld(i == 0 ? snake.Position() : snake.GetTailAt(i - 1));
+				AddQuad(position.x + 1, position.y + 1, position.x + cell - 1, position.y + cell - 1, 0.0f, 1.0f, 1.0f);
+			}
+
+			mRasterizer.DrawIndexed(Topology::TriangleList, mVertices.data(), static_cast<uint32_t>(mVertices.size()), mIndices.data(), static_cast<uint32_t>(mIndices.size()));
+			mRasterizer.Submit();
+			mVertices.clear();
+			mIndices.clear();
+
+			return mRasterizer.GetFramebuffer().Hash();
+		}
+
+	private:
+		void AddQuad(float left, float bottom, float right, float top, float red, float green, float blue)
+		{
+			static const uint16_t quadIndices[] = { 0, 1, 2, 2, 1, 3 };
+			const uint16_t first = static_cast<uint16_t>(mVertices.size());
+			for (uint16_t index : quadIndices)
+			{
+				mIndices.push_back(static_cast<uint16_t>(first + index));
+			}
+
+			mVertices.push_back({ { left, top, 0.0f, 1.0f }, { red, green, blue, 1.0f } });
+			mVertices.push_back({ { right, top, 0.0f, 1.0f }, { red, green, blue, 1.0f } });
+			mVertices.push_back({ { left, bottom, 0.0f, 1.0f }, { red, green, blue, 1.0f } });
+			mVertices.push_back({ { right, bottom, 0.0f, 1.0f }, { red, green, blue, 1.0f } });
+		}
+
+		SoftwareRasterizer mRasterizer;
+		vector<ColorVertex> mVertices;
+		vector<uint16_t> mIndices;
+	};
+
+	struct Result final
+	{
+		FrameSkipper::Counters Counters;
+		double CpuMillisecondsPerSecond;
+		uint64_t StepCount;
+		uint64_t LastHash;
+		bool Valid;
+	};
+
+	// Thirty seconds of the game loop at 60 frames a second, with the snake on autopilot.
+	// The loop runs flat out, so each frame's CPU time is charged against the 1/60 s it
+	// would have had, as if it waited for the vertical blank like the game does.
+	Result Run(bool renderOnChange)
+	{
+		const vector<Direction> autopilot = BuildAutopilot(Board::Width, Board::Height);
+		Game game(7);
+		SceneRenderer renderer;
+		FrameSkipper skipper;
+		skipper.SetEnabled(renderOnChange);
+
+		Result result = { {}, 0.0, 0, 0, true };
+		VisualState drawn = {};
+		double cpuSecondsPerSecond = 0.0;
+		uint32_t seconds = 0;
+		for (uint32_t frame = 0; frame < FrameCount; frame++)
+		{
+			const double start = FrameSkipper::ThreadCpuSeconds();
+
+			game.Move(autopilot[Board::CellIndex(game.GetSnake().Position())]);
+			game.Update(FrameSeconds);
+
+			const VisualState current = Capture(game);
+			const bool changed = current != drawn;
+			if (skipper.ShouldRender(changed))
+			{
+				const uint64_t hash = renderer.Render(game);
+
+				// Every frame the check called unchanged must look like the one before it.
+				result.Valid = result.Valid && (frame == 0 || changed || hash == result.LastHash);
+				result.LastHash = hash;
+				drawn = current;
+			}
+
+			if (skipper.AddTime(FrameSkipper::ThreadCpuSeconds() - start, FrameSeconds))
+			{
+				cpuSecondsPerSecond += skipper.CpuSecondsPerSecond();
+				++seconds;
+			}
+		}
+
+		result.Counters = skipper.GetCounters();
+		result.CpuMillisecondsPerSecond = 1000.0 * cpuSecondsPerSecond / seconds;
+		result.StepCount = game.StepCount();
+		return result;
+	}
+}
+
+int main()
+{
+	const Result always = Run(false);
+	const Result onChange = Run(true);
+
+	for (const Result* result : { &always, &onChange })
+	{
+		printf("%-17s | %5llu frames rendered, %5llu skipped | %7.2f ms CPU per second\n",
+			result == &always ? "render every frame" : "render on change",
+			static_cast<unsigned long long>(result->Counters.RenderedFrames), static_cast<unsigned long long>(result->Counters.SkippedFrames),
+			result->CpuMillisecondsPerSecond);
+	}
+
+	// The snake moves on every tick, so render-on-change draws the first frame and one per
+	// tick, and both runs end on the same picture.
+	const bool valid = always.Valid && onChange.Valid && always.StepCount == onChange.StepCount &&
+		always.Counters.RenderedFrames == FrameCount && always.Counters.SkippedFrames == 0 &&
+		onChange.Counters.RenderedFrames == 1 + onChange.StepCount &&
+		onChange.Counters.RenderedFrames + onChange.Counters.SkippedFrames == FrameCount &&
+		always.LastHash == onChange.LastHash;
+	printf("Render on change %s\n", valid ? "skips only frames that would have looked the same" : "SKIPPED A FRAME THAT CHANGED");
+
+	return valid ? 0 : 1;
+}
@@ -0,0 +1,141 @@
+#include "Benchmark.h"
+#include "Board.h"
+#include "OccupancyGrid.h"
+#include "Random.h"
+#include <vector>
+
+using namespace std;
+using namespace Simulation;
+using namespace Benchmarks;
+
+namespace
+{
+	// Cells in a fixed random order, so the first n of them make a scattered body.
+	vector<Cell> ShuffledCells(Random& random)
+	{
+		vector<Cell> cells;
+		for (int32_t y = 0; y < Board::Height; y++)
+		{
+			for (int32_t x = 0; x < Board::Width; x++)
+			{
+				cells.push_back(Cell(x, y));
+			}
+		}
+
+		for (size_t i = cells.size() - 1; i > 0; i--)
+		{
+			swap(cells[i], cells[random.Next() % (i + 1)]);
+		}
+
+		return cells;
+	}
+
+	// Fills the board one cell at a time down to the last free cell, checking that sampling
+	// only ever returns free cells and finally nothing at all.
+	bool VerifyFill()
+	{
+		Random random(7);
+		const vector<Cell> cells = ShuffledCells(random);
+		OccupancyGrid grid;
+		const Cell nowhere(-1, -1);
+
+		for (size_t filled = 0; filled < cells.size(); filled++)
+		{
+			if (grid.FreeCount() != cells.size() - filled)
+			{
+				return false;
+			}
+
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				Cell cell;
+				if (!grid.SampleFreeCell(random.Next(), nowhere, cell) || grid.At(cell.x, cell.y) != 0)
+				{
+					return false;
+				}
+			}
+
+			grid.AddBody(cells[filled].x, cells[filled].y);
+		}
+
+		// One cell left: it is the only answer, and excluding it leaves none.
+		const Cell& last = cells.back();
+		grid.RemoveBody(last.x, last.y);
+		Cell cell;
+		if (!grid.SampleFreeCell(random.Next(), nowhere, cell) || cell != last || grid.SampleFreeCell(random.Next(), last, cell))
+		{
+			return false;
+		}
+
+		// Powerup flags take a cell out of the set just like the body does.
+		grid.SetFlag(last.x, last.y, OccupancyGrid::CherryFlag);
+		if (grid.FreeCount() != 0 || grid.SampleFreeCell(random.Next(), nowhere, cell))
+		{
+			return false;
+		}
+		grid.ClearFlag(last.x, last.y, OccupancyGrid::CherryFlag);
+
+		for (const Cell& filledCell : cells)
+		{
+			if (filledCell != last)
+			{
+				grid.RemoveBody(filledCell.x, filledCell.y);
+			}
+		}
+
+		return grid.FreeCount() == cells.size();
+	}
+
+	void Run(uint32_t filled, uint64_t samples)
+	{
+		Random random(11);
+		const vector<Cell> cells = ShuffledCells(random);
+		OccupancyGrid grid;
+		for (uint32_t i = 0; i < filled; i++)
+		{
+			grid.AddBody(cells[i].x, cells[i].y);
+		}
+
+		const Cell nowhere(-1, -1);
+		uint32_t checksum = 0;
+		const double indexed = MeasureNanoseconds(samples, [&](uint64_t) {
+			Cell cell = nowhere;
+			grid.SampleFreeCell(random.Next(), nowhere, cell);
+			checksum += cell.Key();
+		});
+
+		// The previous approach: draw cells until an empty one turns up.
+		const double rejection = MeasureNanoseconds(samples, [&](uint64_t) {
+			Cell cell;
+			do
+			{
+				const uint32_t index = random.Next() % Board::CellCount;
+				cell = Cell(index % Board::Width, index / Board::Width);
+			} while (grid.At(cell.x, cell.y) != 0);
+			checksum += cell.Key();
+		});
+		Consume(checksum);
+
+		printf("%7.3f%% full (%4u free): free-cell set %6.2f ns, rejection sampling %9.2f ns\n",
+			100.0 * filled / Board::CellCount, Board::CellCount - filled, indexed, rejection);
+	}
+}
+
+int main()
+{
+	if (!VerifyFill())
+	{
+		printf("Free-cell set check FAILED\n");
+		return 1;
+	}
+	printf("Free-cell set check passed\n");
+
+	const uint32_t cellCount = static_cast<uint32_t>(Board::CellCount);
+	const uint32_t fills[] = { 0, cellCount / 2, cellCount * 9 / 10, cellCount * 99 / 100, cellCount - 1 };
+	for (uint32_t filled : fills)
+	{
+		Run(filled, 200000);
+	}
+
+	return 0;
+}
@@ -0,0 +1,128 @@
+#include "Benchmark.h"
+#include "Clock.h"
+#include "Game.h"
+#include "GameTimer.h"
+#include "Random.h"
+#include <chrono>
+#include <cmath>
+#include <memory>
+
+using namespace std;
+using namespace Simulation;
+using namespace Benchmarks;
+
+namespace
+{
+	struct Run final
+	{
+		uint64_t Updates;
+		uint64_t TotalTicks;
+		uint32_t FramesPerSecond;
+	};
+
+	// Presents frameCount frames at the display's refresh rate on a virtual clock, with the
+	// game updating at a fixed 60 Hz.
+	Run Present(double refreshRate, uint64_t frameCount)
+	{
+		auto clock = make_shared<VirtualClock>();
+		GameTimer timer(clock);
+		timer.SetFixedTimeStep(true);
+		timer.SetTargetElapsedSeconds(1.0 / 60);
+
+		Run run = {};
+		for (uint64_t frame = 0; frame < frameCount; frame++)
+		{
+			clock->AdvanceSeconds(1.0 / refreshRate);
+			timer.Tick([&]() { ++run.Updates; });
+		}
+
+		run.TotalTicks = timer.GetTotalTicks();
+		run.FramesPerSecond = timer.GetFramesPerSecond();
+		return run;
+	}
+
+	// A game driven the way GameMain drives it, by a 60 Hz timer, for seconds of game time on
+	// a virtual clock, with random input from the seed. Returns a hash of where it ended up.
+	uint64_t Play(uint32_t seed, uint64_t seconds, uint64_t& updates)
+	{
+		auto clock = make_shared<VirtualClock>();
+		GameTimer timer(clock);
+		timer.SetFixedTimeStep(true);
+		timer.SetTargetElapsedSeconds(1.0 / 60);
+
+		Game game(seed);
+		Random input(seed);
+		const Direction directions[] = { Direction::Up, Direction::Left, Direction::Down, Direction::Right };
+		updates = 0;
+		for (uint64_t frame = 0; frame < seconds * 60; frame++)
+		{
+			clock->AdvanceSeconds(1.0 / 60);
+			timer.Tick([&]()
+			{
+				if (!game.GetSnake().Alive())
+				{
+					game = Game(input.Next());
+				}
+				if (input.Next() % 8 == 0)
+				{
+					game.Move(directions[input.Next() % 4]);
+				}
+
+				game.Update(timer.GetElapsedSeconds());
+				++updates;
+			});
+		}
+
+		uint64_t hash = 14695981039346656037ull;
+		hash = (hash ^ game.StepCount()) * 1099511628211ull;
+		hash = (hash ^ game.GetSnake().Position().Key()) * 1099511628211ull;
+		hash = (hash ^ game.GetSnake().GetTailSize()) * 1099511628211ull;
+		hash = (hash ^ input.State()) * 1099511628211ull;
+		return hash;
+	}
+}
+
+int main()
+{
+	bool valid = true;
+	const uint64_t hourOfFrames = 3600 * 60;
+	const uint64_t target = GameTimer::TicksPerSecond / 60;
+
+	// At the update rate, every frame is one update, and the ticks add up to the frame count
+	// times the target exactly.
+	const Run vsync = Present(60.0, hourOfFrames);
+	valid = valid && vsync.Updates == hourOfFrames && vsync.TotalTicks == hourOfFrames * target && vsync.FramesPerSecond == 60;
+	printf("60 Hz display,    1 hour: %7llu updates, %llu fps\n", static_cast<unsigned long long>(vsync.Updates), static_cast<unsigned long long>(vsync.FramesPerSecond));
+
+	// Close enough to the target is clamped to it, so an NTSC display drops nothing.
+	const Run ntsc = Present(59.94, hourOfFrames);
+	valid = valid && ntsc.Updates == hourOfFrames;
+	printf("59.94 Hz display, 1 hour: %7llu updates, %llu fps\n", static_cast<unsigned long long>(ntsc.Updates), static_cast<unsigned long long>(ntsc.FramesPerSecond));
+
+	// Faster displays update only once enough time has built up.
+	const uint64_t refreshTicks = static_cast<uint64_t>(llround(GameTimer::TicksPerSecond / 144.0));
+	const Run fast = Present(144.0, 3600 * 144);
+	valid = valid && fast.Updates == 3600 * 144 * refreshTicks / target;
+	printf("144 Hz display,   1 hour: %7llu updates, %llu fps\n", static_cast<unsigned long long>(fast.Updates), static_cast<unsigned long long>(fast.FramesPerSecond));
+
+	uint64_t updates = 0;
+	const uint64_t seconds = 3600;
+	const auto start = chrono::steady_clock::now();
+	const uint64_t first = Play(11, seconds, updates);
+	const double wallSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	uint64_t replayedUpdates = 0;
+	const uint64_t second = Play(11, seconds, replayedUpdates);
+	valid = valid && first == second && updates == seconds * 60 && replayedUpdates == updates;
+	printf("An hour of play on a virtual clock: %llu updates in %.1f ms, %.0fx real time, %s\n",
+		static_cast<unsigned long long>(updates), wallSeconds * 1e3, static_cast<double>(seconds) / wallSeconds, first == second ? "same game both times" : "GAMES DIFFER");
+
+	// The real clock keeps counting up.
+	auto steady = Clock::CreateDefault();
+	const uint64_t before = steady->Now();
+	const double read = MeasureNanoseconds(1000000, [&](uint64_t) { Consume(steady->Now()); });
+	valid = valid && steady->Now() > before;
+	printf("Reading the default clock: %.1f ns\n", read);
+
+	printf("Virtual-clock timing %s\n", valid ? "is exact and reproducible" : "WAS OFF");
+	return valid ? 0 : 1;
+}
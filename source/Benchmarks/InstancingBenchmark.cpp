@@ -0,0 +1,212 @@
+#include "Benchmark.h"
+#include "Board.h"
+#include "Game.h"
+#include "RenderStats.h"
+#include "SnakeInstances.h"
+#include "Tour.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace std;
+using namespace Simulation;
+using namespace Benchmarks;
+
+namespace
+{
+	const double FrameSeconds = 1.0 / 60.0;
+	const uint32_t MatrixBytes = 64;
+	const uint32_t ColorBytes = 16;
+	const uint32_t SquareVertexBytes = 4 * 16;
+
+	// What Player submitted before instancing: the view-projection matrix, then a vertex
+	// buffer and color upload plus a draw for the head and every tail segment.
+	void SubmitPerSegment(const Game& game, RenderStats& stats)
+	{
+		stats.RecordUpload(MatrixBytes);
+		for (uint32_t i = 0; i <= game.GetSnake().GetTailSize(); i++)
+		{
+			stats.RecordUpload(SquareVertexBytes);
+			stats.RecordUpload(ColorBytes);
+			stats.RecordDraw();
+		}
+	}
+
+	// The per-object constants Player uploads: the view-projection matrix and the blend,
+	// padded to a multiple of 16 bytes.
+	const uint32_t ConstantBytes = 80;
+
+	float Blend(const Game& game)
+	{
+		const Snake& snake = game.GetSnake();
+		return snake.Alive() && snake.CurrentDirection() != Direction::Stop ? game.TickProgress() : 1.0f;
+	}
+
+	// What Player submits now: the instance buffer when the game has stepped, the constants
+	// when the blend has moved on, and one instanced draw. The vertex shader blends.
+	void SubmitInstanced(const Game& game, SnakeInstances& instances, float& uploadedBlend, RenderStats& stats)
+	{
+		if (instances.Update(game))
+		{
+			Consume(instances.Data()[instances.Count() - 1].To);
+			stats.RecordUpload(instances.ByteCount());
+		}
+		const float blend = Blend(game);
+		if (blend != uploadedBlend)
+		{
+			stats.RecordConstantBufferUpload(ConstantBytes);
+			uploadedBlend = blend;
+		}
+		stats.RecordDraw(instances.Count());
+	}
+
+	// Blending on the CPU instead rewrites every segment's position whenever the blend moves.
+	void SubmitCpuBlended(const Game& game, uint64_t& blendedStep, float& blendedBlend, RenderStats& stats)
+	{
+		const float blend = Blend(game);
+		if (game.StepCount() != blendedStep || blend != blendedBlend)
+		{
+			stats.RecordUpload(max(game.GetSnake().GetTailSize(), 1u) * sizeof(Vector2f));
+			blendedStep = game.StepCount();
+			blendedBlend = blend;
+		}
+		stats.RecordUpload(MatrixBytes);
+		stats.RecordDraw(max(game.GetSnake().GetTailSize(), 1u));
+	}
+
+	struct Window final
+	{
+		uint64_t Frames;
+		uint64_t Steps;
+		RenderStats::Counters PerSegment;
+		RenderStats::Counters Instanced;
+		RenderStats::Counters CpuBlended;
+	};
+
+	void Accumulate(RenderStats::Counters& total, const RenderStats::Counters& frame)
+	{
+		total.DrawCalls += frame.DrawCalls;
+		total.Instances += frame.Instances;
+		total.BufferUploads += frame.BufferUploads;
+		total.UploadBytes += frame.UploadBytes;
+	}
+
+	void Print(uint32_t tailSize, const Window& window)
+	{
+		const double frames = static_cast<double>(window.Frames);
+		printf("up to tail %4u: %5llu frames, %4llu steps | per-segment %7.1f draws %7.1f uploads %8.0f bytes/frame | cpu-blended %.2f uploads %6.0f bytes/frame | instanced %.1f draws %.2f uploads %6.0f bytes/frame\n",
+			tailSize, static_cast<unsigned long long>(window.Frames), static_cast<unsigned long long>(window.Steps),
+			window.PerSegment.DrawCalls / frames, window.PerSegment.BufferUploads / frames, window.PerSegment.UploadBytes / frames,
+			window.CpuBlended.BufferUploads / frames, window.CpuBlended.UploadBytes / frames,
+			window.Instanced.DrawCalls / frames, window.Instanced.BufferUploads / frames, window.Instanced.UploadBytes / frames);
+	}
+
+	// Plays a game at 60 frames per second along the tour until the snake is full length,
+	// counting the submission schemes frame by frame. The instanced path must issue exactly
+	// one draw per frame covering the whole snake, and upload its instances only on frames
+	// where the game stepped: a frame between ticks changes only the blend in the constants.
+	bool Play()
+	{
+		const vector<Direction> autopilot = BuildAutopilot(Board::Width, Board::Height);
+		unique_ptr<Game> game = make_unique<Game>(3);
+		unique_ptr<SnakeInstances> instances = make_unique<SnakeInstances>();
+		RenderStats perSegment;
+		RenderStats instanced;
+		RenderStats cpuBlended;
+		float uploadedBlend = -1.0f;
+		uint64_t blendedStep = UINT64_MAX;
+		float blendedBlend = -1.0f;
+
+		const uint32_t checkpoints[] = { 0, 100, 500, 1000, Snake::MaxLength };
+		const uint32_t checkpointCount = sizeof(checkpoints) / sizeof(checkpoints[0]);
+		uint32_t nextCheckpoint = 0;
+		Window window = {};
+		bool firstFrame = true;
+		bool valid = true;
+		uint64_t framesBetweenTicks = 0;
+		uint64_t uploadsBetweenTicks = 0;
+
+		while (game->GetSnake().Alive() && nextCheckpoint < checkpointCount)
+		{
+			const uint64_t stepCount = game->StepCount();
+			// At most one tick a frame, so the autopilot gets to steer every tick once the snake
+			// outpaces the display.
+			game->Move(autopilot[Board::CellIndex(game->GetSnake().Position())]);
+			if (static_cast<double>(game->StepInterval()) < FrameSeconds * 1e9)
+			{
+				game->Step();
+			}
+			else
+			{
+				game->Update(FrameSeconds);
+			}
+
+			perSegment.BeginFrame();
+			instanced.BeginFrame();
+			cpuBlended.BeginFrame();
+			SubmitPerSegment(*game, perSegment);
+			SubmitInstanced(*game, *instances, uploadedBlend, instanced);
+			SubmitCpuBlended(*game, blendedStep, blendedBlend, cpuBlended);
+
+			const bool stepped = game->StepCount() != stepCount;
+			const RenderStats::Counters& frame = instanced.CurrentFrame();
+			const uint32_t instanceUploads = frame.BufferUploads - frame.ConstantBufferUploads;
+			valid = valid && frame.DrawCalls == 1 && frame.Instances == max(game->GetSnake().GetTailSize(), 1u) &&
+				instanceUploads == (stepped || firstFrame ? 1u : 0u);
+			if (!stepped && !firstFrame && Blend(*game) > 0.0f && Blend(*game) < 1.0f)
+			{
+				++framesBetweenTicks;
+				uploadsBetweenTicks += instanceUploads;
+			}
+			firstFrame = false;
+
+			++window.Frames;
+			window.Steps += stepped ? 1 : 0;
+			Accumulate(window.PerSegment, perSegment.CurrentFrame());
+			Accumulate(window.Instanced, frame);
+			Accumulate(window.CpuBlended, cpuBlended.CurrentFrame());
+
+			if (game->GetSnake().GetTailSize() >= checkpoints[nextCheckpoint])
+			{
+				Print(checkpoints[nextCheckpoint], window);
+				window = Window();
+				++nextCheckpoint;
+			}
+		}
+
+		printf("%llu frames drawn between ticks made %llu instance uploads\n",
+			static_cast<unsigned long long>(framesBetweenTicks), static_cast<unsigned long long>(uploadsBetweenTicks));
+		return valid && nextCheckpoint == checkpointCount && framesBetweenTicks > 0 && uploadsBetweenTicks == 0;
+	}
+
+	void MeasureRebuild()
+	{
+		const vector<Direction> autopilot = BuildAutopilot(Board::Width, Board::Height);
+		unique_ptr<Game> game = make_unique<Game>(3);
+		while (game->GetSnake().GetTailSize() < Snake::MaxLength && game->GetSnake().Alive())
+		{
+			game->Move(autopilot[Board::CellIndex(game->GetSnake().Position())]);
+			game->Step();
+		}
+
+		unique_ptr<SnakeInstances> instances = make_unique<SnakeInstances>();
+		const double rebuild = MeasureNanoseconds(100000, [&](uint64_t) {
+			instances->Invalidate();
+			instances->Update(*game);
+		});
+		const double unchanged = MeasureNanoseconds(10000000, [&](uint64_t) {
+			Consume(instances->Update(*game));
+		});
+
+		printf("Instance list for %u cells: %.0f ns to rebuild, %.2f ns to confirm unchanged\n", instances->Count(), rebuild, unchanged);
+	}
+}
+
+int main()
+{
+	const bool valid = Play();
+	MeasureRebuild();
+	printf("Instanced submission %s\n", valid ? "is one draw per frame, uploading instances only on steps" : "BROKE ITS BUDGET");
+
+	return valid ? 0 : 1;
+}
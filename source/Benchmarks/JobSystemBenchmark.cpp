@@ -0,0 +1,305 @@
+#include "Benchmark.h"
+#include "Board.h"
+#include "Game.h"
+#include "JobSystem.h"
+#include "Random.h"
+#include "TaskGraph.h"
+#include "Tour.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace Simulation;
+using namespace Benchmarks;
+
+namespace
+{
+	const uint32_t FieldCount = 4;
+	const uint32_t BallsPerField = 60000;
+	const uint32_t BallGrainSize = 2048;
+	const uint32_t GameCount = 6;
+	const uint32_t StepsPerFrame = 8;
+	const uint32_t FrameCount = 200;
+	const float ElapsedSeconds = 1.0f / 60.0f;
+
+	uint64_t Mix(uint64_t hash, uint64_t value)
+	{
+		return (hash ^ value) * 1099511628211ull;
+	}
+
+	uint32_t Bits(float value)
+	{
+		uint32_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	}
+
+	// The walls every field bounces its balls off; it breathes a little every frame.
+	struct Arena final
+	{
+		float HalfWidth;
+		float HalfHeight;
+	};
+
+	// Like DirectXGame::BallManager: balls that only move themselves, bouncing off the arena.
+	class BallField final
+	{
+	public:
+		explicit BallField(uint32_t seed) :
+			mChecksum(0)
+		{
+			Random random(seed);
+			mBalls.resize(BallsPerField);
+			for (Ball& ball : mBalls)
+			{
+				ball.X = static_cast<float>(random.Next() % 800) - 400.0f;
+				ball.Y = static_cast<float>(random.Next() % 400) - 200.0f;
+				ball.VelocityX = static_cast<float>(random.Next() % 600) - 300.0f;
+				ball.VelocityY = static_cast<float>(random.Next() % 600) - 300.0f;
+			}
+		}
+
+		uint64_t Checksum() const
+		{
+			return mChecksum;
+		}
+
+		// Splits the balls into parallel-for chunks when given a job system.
+		void Update(const Arena& arena, JobSystem* jobs)
+		{
+			if (jobs != nullptr)
+			{
+				jobs->ParallelFor(0, BallsPerField, BallGrainSize, [&](uint32_t first, uint32_t last) { Move(arena, first, last); });
+			}
+			else
+			{
+				Move(arena, 0, BallsPerField);
+			}
+
+			mChecksum = 14695981039346656037ull;
+			for (uint32_t i = 0; i < BallsPerField; i += 97)
+			{
+				mChecksum = Mix(Mix(mChecksum, Bits(mBalls[i].X)), Bits(mBalls[i].Y));
+			}
+		}
+
+	private:
+		struct Ball final
+		{
+			float X;
+			float Y;
+			float VelocityX;
+			float VelocityY;
+		};
+
+		void Move(const Arena& arena, uint32_t first, uint32_t last)
+		{
+			for (uint32_t i = first; i < last; i++)
+			{
+				Ball& ball = mBalls[i];
+				ball.X += ball.VelocityX * ElapsedSeconds;
+				ball.Y += ball.VelocityY * ElapsedSeconds;
+				if (ball.X > arena.HalfWidth || ball.X < -arena.HalfWidth)
+				{
+					ball.X = min(max(ball.X, -arena.HalfWidth), arena.HalfWidth);
+					ball.VelocityX = -ball.VelocityX;
+				}
+				if (ball.Y > arena.HalfHeight || ball.Y < -arena.HalfHeight)
+				{
+					ball.Y = min(max(ball.Y, -arena.HalfHeight), arena.HalfHeight);
+					ball.VelocityY = -ball.VelocityY;
+				}
+			}
+		}
+
+		vector<Ball> mBalls;
+		uint64_t mChecksum;
+	};
+
+	// One entry per GameComponent: what it touches, if it says, and its Update().
+	struct Component final
+	{
+		function<void(JobSystem* jobs)> Update;
+		TaskGraph::Access Access;
+		bool Declared;
+	};
+
+	// Headless stand-ins for GameMain's components: input on the calling thread, ball fields,
+	// snake games, a scoreboard reading the fields and games, and the arena changing after
+	// every field has used it.
+	class Scene final
+	{
+	public:
+		Scene() :
+			mArena{ 400.0f, 200.0f }, mAutopilot(BuildAutopilot(Board::Width, Board::Height)), mInputFrames(0), mScore(14695981039346656037ull)
+		{
+			for (uint32_t i = 0; i < FieldCount; i++)
+			{
+				mFields.push_back(make_unique<BallField>(31 + i));
+			}
+			for (uint32_t i = 0; i < GameCount; i++)
+			{
+				mGames.push_back(make_unique<Game>(7 + i));
+			}
+
+			mComponents.push_back({ [this](JobSystem*) { ++mInputFrames; }, {}, false });
+			for (const unique_ptr<BallField>& field : mFields)
+			{
+				BallField* const ballField = field.get();
+				mComponents.push_back({ [this, ballField](JobSystem* jobs) { ballField->Update(mArena, jobs); }, { { &mArena }, { ballField } }, true });
+			}
+			for (const unique_ptr<Game>& game : mGames)
+			{
+				Game* const snakeGame = game.get();
+				mComponents.push_back({ [this, snakeGame](JobSystem*) { StepGame(*snakeGame); }, { {}, { snakeGame } }, true });
+			}
+
+			Component scoreboard = { [this](JobSystem*) { Score(); }, {}, true };
+			for (const unique_ptr<BallField>& field : mFields)
+			{
+				scoreboard.Access.Reads.push_back(field.get());
+			}
+			for (const unique_ptr<Game>& game : mGames)
+			{
+				scoreboard.Access.Reads.push_back(game.get());
+			}
+			scoreboard.Access.Writes.push_back(&mScore);
+			mComponents.push_back(scoreboard);
+
+			mComponents.push_back({ [this](JobSystem*) { Breathe(); }, { {}, { &mArena } }, true });
+		}
+
+		// GameMain before the job system.
+		void UpdateSerially()
+		{
+			for (const Component& component : mComponents)
+			{
+				component.Update(nullptr);
+			}
+		}
+
+		// What DX::ComponentRegistry::Update() does.
+		void UpdateInParallel(JobSystem& jobs, TaskGraph& graph)
+		{
+			for (const Component& component : mComponents)
+			{
+				const Component* const scheduled = &component;
+				if (component.Declared)
+				{
+					graph.Add([scheduled, &jobs]() { scheduled->Update(&jobs); }, component.Access);
+				}
+				else
+				{
+					graph.AddExclusive([scheduled, &jobs]() { scheduled->Update(&jobs); });
+				}
+			}
+
+			graph.Run(jobs);
+			graph.Clear();
+		}
+
+		uint64_t Hash() const
+		{
+			uint64_t hash = Mix(mScore, mInputFrames);
+			hash = Mix(Mix(hash, Bits(mArena.HalfWidth)), Bits(mArena.HalfHeight));
+			for (const unique_ptr<BallField>& field : mFields)
+			{
+				hash = Mix(hash, field->Checksum());
+			}
+			return hash;
+		}
+
+	private:
+		void StepGame(Game& game)
+		{
+			for (uint32_t i = 0; i < StepsPerFrame; i++)
+			{
+				game.Move(mAutopilot[Board::CellIndex(game.GetSnake().Position())]);
+				game.Step();
+			}
+		}
+
+		void Score()
+		{
+			for (const unique_ptr<BallField>& field : mFields)
+			{
+				mScore = Mix(mScore, field->Checksum());
+			}
+			for (const unique_ptr<Game>& game : mGames)
+			{
+				const Cell& position = game->GetSnake().Position();
+				mScore = Mix(Mix(mScore, game->StepCount()), Mix(position.Key(), game->GetSnake().GetTailSize()));
+			}
+		}
+
+		void Breathe()
+		{
+			mArena.HalfWidth = 380.0f + static_cast<float>(mInputFrames % 40);
+			mArena.HalfHeight = 190.0f + static_cast<float>(mInputFrames % 20);
+		}
+
+		Arena mArena;
+		vector<Direction> mAutopilot;
+		vector<unique_ptr<BallField>> mFields;
+		vector<unique_ptr<Game>> mGames;
+		vector<Component> mComponents;
+		uint64_t mInputFrames;
+		uint64_t mScore;
+	};
+
+	uint64_t UpdateSerially(double& frameNanoseconds)
+	{
+		Scene scene;
+		frameNanoseconds = MeasureNanoseconds(FrameCount, [&](uint64_t) { scene.UpdateSerially(); });
+		return scene.Hash();
+	}
+
+	uint64_t UpdateInParallel(uint32_t threadCount, double& frameNanoseconds)
+	{
+		Scene scene;
+		JobSystem jobs(threadCount);
+		TaskGraph graph;
+		frameNanoseconds = MeasureNanoseconds(FrameCount, [&](uint64_t) { scene.UpdateInParallel(jobs, graph); });
+		return scene.Hash();
+	}
+}
+
+int main()
+{
+	double serialFrame = 0.0;
+	const uint64_t serialHash = UpdateSerially(serialFrame);
+	printf("%u fields of %u balls, %u games of %u steps a frame\n", FieldCount, BallsPerField, GameCount, StepsPerFrame);
+	printf("%-22s | frame %7.3f ms\n", "serial", serialFrame / 1e6);
+
+	bool valid = true;
+	vector<uint32_t> threadCounts = { 1, 2, 4 };
+	const uint32_t coreCount = max(thread::hardware_concurrency(), 1u);
+	if (coreCount > 4)
+	{
+		threadCounts.push_back(coreCount);
+	}
+
+	double oneThreadFrame = 0.0;
+	for (uint32_t threadCount : threadCounts)
+	{
+		double frame = 0.0;
+		const uint64_t hash = UpdateInParallel(threadCount, frame);
+		valid = valid && hash == serialHash;
+		if (threadCount == 1)
+		{
+			oneThreadFrame = frame;
+		}
+
+		const string name = "job system, " + to_string(threadCount) + (threadCount == 1 ? " thread" : " threads");
+		printf("%-22s | frame %7.3f ms | %5.2fx one thread%s\n", name.c_str(), frame / 1e6, oneThreadFrame / frame, hash == serialHash ? "" : "  STATE DIFFERS");
+	}
+
+	printf("(%u cores)\n", coreCount);
+	printf("Parallel updates %s\n", valid ? "leave the same state as serial updates on every thread count" : "LEFT A DIFFERENT STATE");
+	return valid ? 0 : 1;
+}
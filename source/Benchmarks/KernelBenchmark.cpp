@@ -0,0 +1,159 @@
+#include "Benchmark.h"
+#include "BatchKernels.h"
+#include "BatchSimulator.h"
+#include "Board.h"
+#include "Random.h"
+#include <vector>
+
+using namespace std;
+using namespace Simulation;
+using namespace Benchmarks;
+
+namespace
+{
+	const uint32_t ActionFrames = 251;
+
+	// Kernel inputs and outputs for a batch of games in arbitrary mid-game states,
+	// including heads on the edge of the board and food right next to them.
+	struct Columns final
+	{
+		explicit Columns(uint32_t gameCount, uint32_t seed) :
+			Actions(gameCount), Headings(gameCount), Lengths(gameCount), HeadX(gameCount), HeadY(gameCount), Food(gameCount),
+			NextX(gameCount), NextY(gameCount), NextCells(gameCount), Events(gameCount)
+		{
+			for (uint32_t game = 0; game < gameCount; game++)
+			{
+				Actions[game] = static_cast<Action>(Random::Next(seed) % 5);
+				Headings[game] = static_cast<Action>(Random::Next(seed) % 5);
+				Lengths[game] = static_cast<uint16_t>(1 + Random::Next(seed) % 3);
+				HeadX[game] = static_cast<int16_t>(Random::Next(seed) % Board::Width);
+				HeadY[game] = static_cast<int16_t>(Random::Next(seed) % Board::Height);
+				const int32_t foodX = HeadX[game] + static_cast<int32_t>(Random::Next(seed) % 3) - 1;
+				const int32_t foodY = HeadY[game] + static_cast<int32_t>(Random::Next(seed) % 3) - 1;
+				Food[game] = static_cast<uint16_t>(foodY * Board::Width + foodX);
+			}
+		}
+
+		StepLanes Lanes()
+		{
+			StepLanes lanes;
+			lanes.Actions = Actions.data();
+			lanes.Headings = Headings.data();
+			lanes.Lengths = Lengths.data();
+			lanes.HeadX = HeadX.data();
+			lanes.HeadY = HeadY.data();
+			lanes.Food = Food.data();
+			lanes.NextX = NextX.data();
+			lanes.NextY = NextY.data();
+			lanes.NextCells = NextCells.data();
+			lanes.Events = Events.data();
+			return lanes;
+		}
+
+		bool operator==(const Columns& rhs) const
+		{
+			return Headings == rhs.Headings && NextX == rhs.NextX && NextY == rhs.NextY && NextCells == rhs.NextCells && Events == rhs.Events;
+		}
+
+		vector<Action> Actions;
+		vector<Action> Headings;
+		vector<uint16_t> Lengths;
+		vector<int16_t> HeadX;
+		vector<int16_t> HeadY;
+		vector<uint16_t> Food;
+		vector<int16_t> NextX;
+		vector<int16_t> NextY;
+		vector<uint16_t> NextCells;
+		vector<uint8_t> Events;
+	};
+
+	// The SIMD kernels must agree with the scalar one lane for lane, remainder included.
+	bool Verify(KernelSet kernelSet)
+	{
+		for (uint32_t gameCount = 1; gameCount <= 67; gameCount++)
+		{
+			Columns expected(gameCount, 0x1234567u + gameCount);
+			Columns actual(expected);
+			ScalarStepKernel(expected.Lanes(), 0, gameCount);
+			GetStepKernel(kernelSet)(actual.Lanes(), 0, gameCount);
+			if (!(expected == actual))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	double KernelOnly(KernelSet kernelSet, uint32_t gameCount, uint64_t totalSteps)
+	{
+		Columns columns(gameCount, 0x2545F491u);
+		StepLanes lanes = columns.Lanes();
+		const StepKernel kernel = GetStepKernel(kernelSet);
+		const uint64_t ticks = max<uint64_t>(totalSteps / gameCount, 1);
+		double nanoseconds = MeasureNanoseconds(ticks, [&](uint64_t) { kernel(lanes, 0, gameCount); });
+		Consume(columns.Events[0]);
+
+		return nanoseconds / gameCount;
+	}
+
+	double FullStep(KernelSet kernelSet, uint32_t gameCount, uint64_t totalSteps)
+	{
+		BatchSimulator simulator(gameCount);
+		simulator.SetKernelSet(kernelSet);
+		vector<Action> actions(static_cast<size_t>(gameCount) * ActionFrames);
+		vector<float> rewards(gameCount);
+		vector<uint8_t> dones(gameCount);
+
+		uint32_t random = 0x2545F491u;
+		for (Action& action : actions)
+		{
+			const uint32_t value = Random::Next(random);
+			action = value % 4 != 0 ? Action::Continue : static_cast<Action>(1 + (value >> 8) % 4);
+		}
+
+		const uint64_t ticks = max<uint64_t>(totalSteps / gameCount, 1);
+		double nanoseconds = MeasureNanoseconds(ticks, [&](uint64_t tick) {
+			simulator.StepAll(&actions[(tick % ActionFrames) * gameCount], rewards.data(), dones.data());
+		});
+		Consume(dones[0]);
+
+		return nanoseconds / gameCount;
+	}
+}
+
+int main()
+{
+	const uint64_t totalSteps = 20000000;
+	const KernelSet kernelSets[] = { KernelSet::Scalar, KernelSet::Sse41, KernelSet::Avx2, KernelSet::Neon };
+	const uint32_t gameCounts[] = { 1, 8, 64, 4096 };
+
+	printf("Best kernel set: %s\n", KernelSetName(BestKernelSet()));
+
+	int result = 0;
+	for (KernelSet kernelSet : kernelSets)
+	{
+		if (!IsKernelSetSupported(kernelSet))
+		{
+			printf("%-7s not supported\n", KernelSetName(kernelSet));
+			continue;
+		}
+
+		if (!Verify(kernelSet))
+		{
+			printf("%-7s MISMATCH against the scalar kernel\n", KernelSetName(kernelSet));
+			result = 1;
+			continue;
+		}
+
+		for (uint32_t gameCount : gameCounts)
+		{
+			const double kernel = KernelOnly(kernelSet, gameCount, totalSteps);
+			const double full = FullStep(kernelSet, gameCount, totalSteps);
+			printf("%-7s %5u games: kernel %6.2f ns/game (%8.1f M/s), StepAll %6.2f ns/game (%6.1f M/s)\n",
+				KernelSetName(kernelSet), gameCount, kernel, 1000.0 / kernel, full, 1000.0 / full);
+		}
+	}
+
+	return result;
+}
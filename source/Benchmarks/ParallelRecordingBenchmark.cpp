@@ -0,0 +1,317 @@
+#include "Benchmark.h"
+#include "Board.h"
+#include "Game.h"
+#include "ParallelRecorder.h"
+#include "Random.h"
+#include "SegmentFont.h"
+#include "SoftwareRasterizer.h"
+#include "Tour.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace Simulation;
+using namespace Benchmarks;
+
+namespace
+{
+	const uint32_t ScreenWidth = 1600;
+	const uint32_t ScreenHeight = 900;
+	const uint32_t CircleResolution = 32;
+	const uint32_t FrameCount = 20;
+
+	Matrix4 ViewProjection()
+	{
+		Matrix4 viewProjection = {};
+		viewProjection.M[0][0] = 2.0f / ScreenWidth;
+		viewProjection.M[1][1] = 2.0f / ScreenHeight;
+		viewProjection.M[2][2] = 1.0f;
+		viewProjection.M[3][3] = 1.0f;
+		return viewProjection;
+	}
+
+	float Uniform(Random& random, float minimum, float maximum)
+	{
+		return minimum + (maximum - minimum) * static_cast<float>(random.Next() % 65536) / 65535.0f;
+	}
+
+	// Like DirectXGame::BallManager: every ball transforms the unit circle on the CPU,
+	// outlines into one line list and solid balls into one triangle list.
+	class BallField final
+	{
+	public:
+		BallField(uint32_t seed, uint32_t count, float left, float bottom, float right, float top)
+		{
+			const float increment = 6.28318530718f / CircleResolution;
+			for (uint32_t i = 0; i < CircleResolution; i++)
+			{
+				const float from[2] = { cosf(i * increment), sinf(i * increment) };
+				const float to[2] = { cosf((i + 1) * increment), sinf((i + 1) * increment) };
+				mLineShape.insert(mLineShape.end(), { from[0], from[1], to[0], to[1] });
+				mTriangleShape.insert(mTriangleShape.end(), { from[0], from[1], 0.0f, 0.0f, to[0], to[1] });
+			}
+
+			Random random(seed);
+			for (uint32_t i = 0; i < count; i++)
+			{
+				Ball ball;
+				ball.X = Uniform(random, left, right);
+				ball.Y = Uniform(random, bottom, top);
+				ball.Radius = Uniform(random, 2.0f, 12.0f);
+				ball.Rotation = Uniform(random, 0.0f, 6.28318530718f);
+				ball.Color[0] = Uniform(random, 0.2f, 1.0f);
+				ball.Color[1] = Uniform(random, 0.2f, 1.0f);
+				ball.Color[2] = Uniform(random, 0.2f, 1.0f);
+				ball.Solid = random.Next() % 2 == 0;
+				mBalls.push_back(ball);
+			}
+		}
+
+		void Record(RenderBackend& backend)
+		{
+			mLines.clear();
+			mTriangles.clear();
+			for (const Ball& ball : mBalls)
+			{
+				const vector<float>& shape = ball.Solid ? mTriangleShape : mLineShape;
+				vector<ColorVertex>& vertices = ball.Solid ? mTriangles : mLines;
+				const float cosine = cosf(ball.Rotation) * ball.Radius;
+				const float sine = sinf(ball.Rotation) * ball.Radius;
+				for (size_t i = 0; i < shape.size(); i += 2)
+				{
+					const float x = ball.X + shape[i] * cosine - shape[i + 1] * sine;
+					const float y = ball.Y + shape[i] * sine + shape[i + 1] * cosine;
+					vertices.push_back({ { x, y, 0.0f, 1.0f }, { ball.Color[0], ball.Color[1], ball.Color[2], 1.0f } });
+				}
+			}
+
+			backend.SetViewProjection(ViewProjection());
+			backend.Draw(Topology::LineList, mLines.data(), static_cast<uint32_t>(mLines.size()));
+			backend.Draw(Topology::TriangleList, mTriangles.data(), static_cast<uint32_t>(mTriangles.size()));
+		}
+
+	private:
+		struct Ball final
+		{
+			float X;
+			float Y;
+			float Radius;
+			float Rotation;
+			float Color[3];
+			bool Solid;
+		};
+
+		vector<float> mLineShape;
+		vector<float> mTriangleShape;
+		vector<Ball> mBalls;
+		vector<ColorVertex> mLines;
+		vector<ColorVertex> mTriangles;
+	};
+
+	// Rows of sixteen-segment text, laid out from scratch every frame.
+	void RecordText(RenderBackend& backend, uint32_t rowCount)
+	{
+		vector<SegmentFont::Line> lines;
+		for (uint32_t row = 0; row < rowCount; row++)
+		{
+			SegmentFont::AppendLines(("Player " + to_string(row) + " Score " + to_string(row * 1234567u)).c_str(), -780.0f, 400.0f - row * 40.0f, lines);
+		}
+
+		vector<ColorVertex> vertices;
+		for (const SegmentFont::Line& line : lines)
+		{
+			vertices.push_back({ { line.FromX * 0.5f, line.FromY * 0.5f, 0.0f, 1.0f }, { 1.0f, 1.0f, 1.0f, 1.0f } });
+			vertices.push_back({ { line.ToX * 0.5f, line.ToY * 0.5f, 0.0f, 1.0f }, { 1.0f, 1.0f, 1.0f, 1.0f } });
+		}
+
+		backend.SetViewProjection(ViewProjection());
+		backend.Draw(Topology::LineList, vertices.data(), static_cast<uint32_t>(vertices.size()));
+	}
+
+	// The snake's cells as indexed quads, the way DX::QuadBatch draws them.
+	void RecordSnake(RenderBackend& backend, const Game& game)
+	{
+		static const uint16_t quadIndices[] = { 0, 1, 2, 2, 1, 3 };
+		vector<ColorVertex> vertices;
+		vector<uint16_t> indices;
+		const Snake& snake = game.GetSnake();
+		const float cell = static_cast<float>(Board::CellSize);
+		for (uint32_t i = 0; i <= snake.GetTailSize(); i++)
+		{
+			const Vector2f position = Board::ToWorld(i == 0 ? snake.Position() : snake.GetTailAt(i - 1));
+			const uint16_t first = static_cast<uint16_t>(vertices.size());
+			for (uint16_t index : quadIndices)
+			{
+				indices.push_back(static_cast<uint16_t>(first + index));
+			}
+			vertices.push_back({ { position.x + 1, position.y + cell - 1, 0.0f, 1.0f }, { 0.0f, 1.0f, 1.0f, 1.0f } });
+			vertices.push_back({ { position.x + cell - 1, position.y + cell - 1, 0.0f, 1.0f }, { 0.0f, 1.0f, 1.0f, 1.0f } });
+			vertices.push_back({ { position.x + 1, position.y + 1, 0.0f, 1.0f }, { 0.0f, 1.0f, 1.0f, 1.0f } });
+			vertices.push_back({ { position.x + cell - 1, position.y + 1, 0.0f, 1.0f }, { 0.0f, 1.0f, 1.0f, 1.0f } });
+		}
+
+		backend.SetViewProjection(ViewProjection());
+		backend.DrawIndexed(Topology::TriangleList, vertices.data(), static_cast<uint32_t>(vertices.size()), indices.data(), static_cast<uint32_t>(indices.size()));
+	}
+
+	// Like DirectXGame::SpriteDemoManager: a grid of blended sprites.
+	void RecordSprites(RenderBackend& backend, RenderBackend::TextureId texture, uint32_t rowCount, uint32_t columnCount)
+	{
+		vector<TextureVertex> vertices;
+		for (uint32_t row = 0; row < rowCount; row++)
+		{
+			for (uint32_t column = 0; column < columnCount; column++)
+			{
+				const float left = 300.0f + column * 30.0f;
+				const float bottom = -420.0f + row * 30.0f;
+				const TextureVertex corners[] =
+				{
+					{ { left, bottom + 24.0f, 0.0f, 1.0f }, { 0.0f, 0.0f } },
+					{ { left + 24.0f, bottom + 24.0f, 0.0f, 1.0f }, { 1.0f, 0.0f } },
+					{ { left, bottom, 0.0f, 1.0f }, { 0.0f, 1.0f } },
+					{ { left + 24.0f, bottom, 0.0f, 1.0f }, { 1.0f, 1.0f } },
+				};
+				vertices.insert(vertices.end(), { corners[0], corners[1], corners[2], corners[2], corners[1], corners[3] });
+			}
+		}
+
+		backend.SetViewProjection(ViewProjection());
+		backend.DrawTextured(texture, Topology::TriangleList, vertices.data(), static_cast<uint32_t>(vertices.size()));
+	}
+
+	// A game some way in, with a long snake winding along the tour.
+	unique_ptr<Game> PlayTo(uint32_t tailSize)
+	{
+		const vector<Direction> autopilot = BuildAutopilot(Board::Width, Board::Height);
+		unique_ptr<Game> game = make_unique<Game>(3);
+		while (game->GetSnake().GetTailSize() < tailSize && game->GetSnake().Alive())
+		{
+			game->IncreaseTail();
+			game->Move(autopilot[Board::CellIndex(game->GetSnake().Position())]);
+			game->Step();
+		}
+
+		return game;
+	}
+
+	// The sprite demo, four ball fields, the text and the snake, each independent of the
+	// others, in the order GameMain would draw them.
+	class Scene final
+	{
+	public:
+		explicit Scene(RenderBackend& target) :
+			mGame(PlayTo(400))
+		{
+			vector<uint32_t> texels(16 * 16);
+			for (uint32_t i = 0; i < texels.size(); i++)
+			{
+				texels[i] = ((i % 16 / 4 + i / 64) % 2 == 0) ? 0xFF3080FFu : 0x80FF2020u;
+			}
+			mTexture = target.CreateTexture(16, 16, texels.data());
+
+			for (uint32_t i = 0; i < 4; i++)
+			{
+				mBallFields.push_back(make_unique<BallField>(100 + i, 3000, -780.0f + i * 390.0f, -440.0f, -400.0f + i * 390.0f, 440.0f));
+			}
+
+			mComponents.push_back([this](RenderBackend& backend) { RecordSprites(backend, mTexture, 12, 15); });
+			for (const unique_ptr<BallField>& field : mBallFields)
+			{
+				BallField* const ballField = field.get();
+				mComponents.push_back([ballField](RenderBackend& backend) { ballField->Record(backend); });
+			}
+			mComponents.push_back([](RenderBackend& backend) { RecordText(backend, 20); });
+			mComponents.push_back([this](RenderBackend& backend) { RecordSnake(backend, *mGame); });
+		}
+
+		const vector<ParallelRecorder::RecordFunction>& Components() const
+		{
+			return mComponents;
+		}
+
+	private:
+		unique_ptr<Game> mGame;
+		RenderBackend::TextureId mTexture;
+		vector<unique_ptr<BallField>> mBallFields;
+		vector<ParallelRecorder::RecordFunction> mComponents;
+	};
+
+	// Every component straight into the rasterizer on the calling thread.
+	uint64_t RenderSerially(double& frameNanoseconds)
+	{
+		SoftwareRasterizer rasterizer(ScreenWidth, ScreenHeight);
+		Scene scene(rasterizer);
+		auto frame = [&](uint64_t) {
+			rasterizer.Clear(0.0f, 0.0f, 0.0f, 1.0f);
+			for (const ParallelRecorder::RecordFunction& component : scene.Components())
+			{
+				component(rasterizer);
+			}
+			rasterizer.Submit();
+		};
+
+		frame(0);
+		frameNanoseconds = MeasureNanoseconds(FrameCount, frame);
+		return rasterizer.GetFramebuffer().Hash();
+	}
+
+	uint64_t RenderInParallel(uint32_t threadCount, double& recordNanoseconds, double& replayNanoseconds)
+	{
+		SoftwareRasterizer rasterizer(ScreenWidth, ScreenHeight);
+		Scene scene(rasterizer);
+		ParallelRecorder recorder(threadCount);
+		for (const ParallelRecorder::RecordFunction& component : scene.Components())
+		{
+			recorder.Add(component);
+		}
+
+		auto replay = [&](uint64_t) {
+			rasterizer.Clear(0.0f, 0.0f, 0.0f, 1.0f);
+			recorder.ReplayAll(rasterizer);
+			rasterizer.Submit();
+		};
+
+		recorder.Record();
+		replay(0);
+		recordNanoseconds = MeasureNanoseconds(FrameCount, [&](uint64_t) {
+			recorder.Record();
+		});
+		replayNanoseconds = MeasureNanoseconds(FrameCount, replay);
+		return rasterizer.GetFramebuffer().Hash();
+	}
+}
+
+int main()
+{
+	double serialFrame = 0.0;
+	const uint64_t serialHash = RenderSerially(serialFrame);
+	printf("%-28s |                  |                          | frame %7.2f ms\n", "serial, into the rasterizer", serialFrame / 1e6);
+
+	bool valid = true;
+	vector<uint32_t> threadCounts = { 1, 2, 4 };
+	const uint32_t coreCount = max(thread::hardware_concurrency(), 1u);
+	if (coreCount > 4)
+	{
+		threadCounts.push_back(coreCount);
+	}
+
+	for (uint32_t threadCount : threadCounts)
+	{
+		double record = 0.0;
+		double replay = 0.0;
+		const uint64_t hash = RenderInParallel(threadCount, record, replay);
+		valid = valid && hash == serialHash;
+
+		const string name = "parallel, " + to_string(threadCount) + (threadCount == 1 ? " thread" : " threads");
+		printf("%-28s | record %7.2f ms | replay + submit %7.2f ms | frame %7.2f ms%s\n",
+			name.c_str(), record / 1e6, replay / 1e6, (record + replay) / 1e6, hash == serialHash ? "" : "  IMAGE DIFFERS");
+	}
+
+	printf("Parallel recording %s\n", valid ? "draws the same image as serial recording on every thread count" : "DREW A DIFFERENT IMAGE");
+	return valid ? 0 : 1;
+}
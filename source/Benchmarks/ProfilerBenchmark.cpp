@@ -0,0 +1,173 @@
+#include "Benchmark.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace Simulation;
+using namespace Benchmarks;
+
+namespace
+{
+	const uint32_t ZonesPerRound = 50000;
+	const uint32_t Rounds = 20;
+
+	// Mean nanoseconds per call of body, over rounds of ZonesPerRound calls with the
+	// profiler cleared before each, so recording never runs into a full buffer.
+	template <typename TBody>
+	double Measure(const TBody& body)
+	{
+		Profiler& profiler = Profiler::GetInstance();
+		double total = 0;
+		for (uint32_t round = 0; round < Rounds; round++)
+		{
+			profiler.Clear();
+			total += MeasureNanoseconds(ZonesPerRound, body);
+		}
+		profiler.Clear();
+		return total / Rounds;
+	}
+
+	// A trivial amount of work for a zone to wrap.
+	inline void Work(uint64_t i)
+	{
+		Consume(i * 2654435761u);
+	}
+
+	uint64_t Count(const string& text, const char* pattern)
+	{
+		uint64_t count = 0;
+		for (size_t at = text.find(pattern); at != string::npos; at = text.find(pattern, at + 1))
+		{
+			++count;
+		}
+		return count;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	bool valid = true;
+	Profiler& profiler = Profiler::GetInstance();
+
+	// What a zone costs on top of the work it wraps. Release builds without
+	// SIMULATION_PROFILING compile the macro out, which costs what the baseline does.
+	const double baseline = Measure([](uint64_t i) { Work(i); });
+	profiler.SetEnabled(false);
+	const double disabled = Measure([](uint64_t i)
+	{
+		SIMULATION_PROFILE_ZONE("Disabled");
+		Work(i);
+	});
+	const uint64_t disabledEvents = profiler.EventCount();
+	profiler.SetEnabled(true);
+	const double enabled = Measure([](uint64_t i)
+	{
+		SIMULATION_PROFILE_ZONE("Enabled");
+		Work(i);
+	});
+	const double clock = Measure([](uint64_t) { Consume(Profiler::Now()); });
+	valid = valid && disabledEvents == 0;
+	printf("Reading the clock:             %6.2f ns, twice per recorded zone\n", clock);
+	printf("Baseline (zones compiled out): %6.2f ns per call\n", baseline);
+	printf("Zone, recording disabled:      %6.2f ns per call, %+.2f ns per zone\n", disabled, disabled - baseline);
+	printf("Zone, recording:               %6.2f ns per call, %+.2f ns per zone\n", enabled, enabled - baseline);
+
+	// Every zone lands, and a full buffer drops the rest and says how many.
+	profiler.Clear();
+	for (uint32_t i = 0; i < Profiler::DefaultEventsPerThread + 100; i++)
+	{
+		SIMULATION_PROFILE_ZONE("Fill");
+	}
+	valid = valid && profiler.EventCount() == Profiler::DefaultEventsPerThread && profiler.DroppedCount() == 100;
+	printf("Past a full buffer: %llu zones kept, %llu dropped\n",
+		static_cast<unsigned long long>(profiler.EventCount()), static_cast<unsigned long long>(profiler.DroppedCount()));
+	profiler.Clear();
+
+	// Zones nest on one thread, and a frame's worth of work spread over the job system
+	// records from every thread that ran it.
+	const uint32_t threadCount = max(thread::hardware_concurrency(), 4u);
+	JobSystem jobs(threadCount);
+	const uint32_t frameCount = 100;
+	const uint32_t itemCount = 256;
+	const uint32_t grainSize = 16;
+	const uint32_t rangesPerFrame = itemCount / grainSize;
+	for (uint32_t frame = 0; frame < frameCount; frame++)
+	{
+		SIMULATION_PROFILE_ZONE("Frame");
+		{
+			SIMULATION_PROFILE_ZONE("Update");
+			jobs.ParallelFor(0, itemCount, grainSize, [](uint32_t first, uint32_t last)
+			{
+				SIMULATION_PROFILE_ZONE("Range \"quoted\"");
+				for (uint32_t i = first; i < last; i++)
+				{
+					Work(i);
+				}
+			});
+		}
+		{
+			SIMULATION_PROFILE_ZONE("Render");
+			Work(frame);
+		}
+	}
+	profiler.SetEnabled(false);
+
+	map<string, uint64_t> zoneCounts;
+	vector<uint32_t> threadIds;
+	bool nested = true;
+	uint64_t lastFrameStart = 0;
+	uint64_t lastFrameEnd = 0;
+	profiler.ForEachEvent([&](uint32_t threadId, const Profiler::Event& event)
+	{
+		++zoneCounts[event.Name];
+		if (find(threadIds.begin(), threadIds.end(), threadId) == threadIds.end())
+		{
+			threadIds.push_back(threadId);
+		}
+
+		// A zone closes before the one around it, so each Frame comes after its Update and
+		// Render and contains them.
+		if (strcmp(event.Name, "Update") == 0 || strcmp(event.Name, "Render") == 0)
+		{
+			lastFrameStart = event.Start;
+			lastFrameEnd = max(lastFrameEnd, event.Start + event.Duration);
+		}
+		else if (strcmp(event.Name, "Frame") == 0)
+		{
+			nested = nested && event.Start <= lastFrameStart && lastFrameEnd <= event.Start + event.Duration;
+		}
+	});
+	valid = valid && nested && zoneCounts["Frame"] == frameCount && zoneCounts["Update"] == frameCount && zoneCounts["Render"] == frameCount &&
+		zoneCounts["Range \"quoted\""] == frameCount * rangesPerFrame;
+	printf("%u frames on %u threads: %llu zones from %zu threads, %s\n", frameCount, threadCount,
+		static_cast<unsigned long long>(profiler.EventCount()), threadIds.size(), nested ? "nested correctly" : "NESTING BROKEN");
+
+	// The trace holds one complete event per zone, with the quotes in a name escaped.
+	ostringstream trace;
+	const auto start = chrono::steady_clock::now();
+	profiler.WriteChromeTrace(trace);
+	const double exportMilliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+	const string json = trace.str();
+	valid = valid && Count(json, "\"ph\":\"X\"") == profiler.EventCount() &&
+		Count(json, "Range \\\"quoted\\\"") == frameCount * rangesPerFrame &&
+		Count(json, "{") == Count(json, "}") && json.compare(0, 1, "{") == 0;
+	printf("Chrome trace: %zu bytes in %.2f ms\n", json.size(), exportMilliseconds);
+
+	if (argc > 1)
+	{
+		ofstream file(argv[1], ios::binary);
+		file << json;
+		printf("Wrote %s\n", argv[1]);
+	}
+
+	printf("Profiler %s\n", valid ? "recorded every zone" : "LOST OR MANGLED ZONES");
+	return valid ? 0 : 1;
+}
@@ -0,0 +1,192 @@
+#include "Benchmark.h"
+#include "Random.h"
+#include "RenderStats.h"
+#include "RingAllocator.h"
+#include <cstring>
+#include <vector>
+
+using namespace std;
+using namespace Simulation;
+using namespace Benchmarks;
+
+namespace
+{
+	// Mirrors DX::QuadBatch: 4096 quads of four position-and-color vertices.
+	const uint32_t Capacity = 4096;
+	const uint32_t VerticesPerQuad = 4;
+	const uint32_t MatrixBytes = 64;
+	const uint32_t ColorBytes = 16;
+	const uint32_t PositionVertexBytes = 16;
+
+	struct ColorVertex final
+	{
+		float Position[4];
+		float Color[4];
+	};
+
+	void AddQuad(vector<ColorVertex>& vertices, float left, float bottom, float right, float top)
+	{
+		const float corners[VerticesPerQuad][2] = { { left, top }, { right, top }, { left, bottom }, { right, bottom } };
+		for (const auto& corner : corners)
+		{
+			vertices.push_back({ { corner[0], corner[1], 0.0f, 1.0f }, { 0.3f, 0.3f, 0.3f, 1.0f } });
+		}
+	}
+
+	// What each shape component submitted before batching: its matrix, then a vertex
+	// buffer map, a color constant buffer upload and a draw for every quad.
+	void SubmitPerQuad(uint32_t componentCount, uint32_t quadCount, RenderStats& stats)
+	{
+		for (uint32_t component = 0; component < componentCount; component++)
+		{
+			stats.RecordConstantBufferUpload(MatrixBytes);
+		}
+		for (uint32_t quad = 0; quad < quadCount; quad++)
+		{
+			stats.RecordUpload(VerticesPerQuad * PositionVertexBytes);
+			stats.RecordConstantBufferUpload(ColorBytes);
+			stats.RecordDraw();
+		}
+	}
+
+	// QuadBatch::Flush() against a CPU stand-in for the dynamic vertex buffer. Besides
+	// counting, it checks the one rule that makes NO_OVERWRITE safe: a range mapped without
+	// discarding never touches quads written since the last discard, which earlier draws in
+	// the frame may still be reading.
+	class BatchModel final
+	{
+	public:
+		BatchModel() :
+			mBuffer(Capacity * VerticesPerQuad), mRing(Capacity), mWrittenSinceDiscard(0), mDiscards(0), mValid(true)
+		{
+		}
+
+		bool Valid() const
+		{
+			return mValid;
+		}
+
+		uint64_t Discards() const
+		{
+			return mDiscards;
+		}
+
+		void Flush(const vector<ColorVertex>& vertices, RenderStats& stats)
+		{
+			const uint32_t quadCount = static_cast<uint32_t>(vertices.size()) / VerticesPerQuad;
+			if (quadCount == 0)
+			{
+				return;
+			}
+
+			stats.RecordConstantBufferUpload(MatrixBytes);
+			for (uint32_t first = 0; first < quadCount; )
+			{
+				const RingAllocator::Range range = mRing.Allocate(quadCount - first);
+				if (range.Discard)
+				{
+					mWrittenSinceDiscard = 0;
+					++mDiscards;
+				}
+				mValid = mValid && range.Count > 0 && range.Offset >= mWrittenSinceDiscard && range.Offset + range.Count <= Capacity;
+				mWrittenSinceDiscard = range.Offset + range.Count;
+
+				const uint32_t byteCount = sizeof(ColorVertex) * VerticesPerQuad * range.Count;
+				memcpy(&mBuffer[range.Offset * VerticesPerQuad], &vertices[first * VerticesPerQuad], byteCount);
+				stats.RecordUpload(byteCount);
+				stats.RecordDraw();
+
+				first += range.Count;
+			}
+		}
+
+	private:
+		vector<ColorVertex> mBuffer;
+		RingAllocator mRing;
+		uint32_t mWrittenSinceDiscard;
+		uint64_t mDiscards;
+		bool mValid;
+	};
+
+	// Runs frames of about quadsPerFrame quads from componentCount components; the count
+	// wobbles by up to a quarter so the ring wraps at varying offsets. Every frame must
+	// come to one draw and one vertex upload per Capacity quads, plus the matrix.
+	bool Run(const char* label, uint32_t componentCount, uint32_t quadsPerFrame, uint32_t frameCount)
+	{
+		Random random(5);
+		RenderStats perQuad;
+		RenderStats batched;
+		BatchModel model;
+		vector<ColorVertex> vertices;
+		vertices.reserve(2 * Capacity * VerticesPerQuad);
+
+		uint64_t perQuadDraws = 0;
+		uint64_t perQuadUploads = 0;
+		uint64_t perQuadConstantUploads = 0;
+		uint64_t batchedDraws = 0;
+		uint64_t batchedUploads = 0;
+		bool valid = true;
+
+		const double nanoseconds = MeasureNanoseconds(frameCount, [&](uint64_t) {
+			const uint32_t wobble = quadsPerFrame / 4;
+			const uint32_t quadCount = quadsPerFrame - wobble + (wobble > 0 ? random.Next() % (2 * wobble + 1) : 0);
+
+			perQuad.BeginFrame();
+			batched.BeginFrame();
+
+			vertices.clear();
+			for (uint32_t quad = 0; quad < quadCount; quad++)
+			{
+				const float x = static_cast<float>(quad % 64) * 25.0f;
+				const float y = static_cast<float>(quad / 64) * 25.0f;
+				AddQuad(vertices, x, y, x + 24.0f, y + 24.0f);
+			}
+			model.Flush(vertices, batched);
+			SubmitPerQuad(componentCount, quadCount, perQuad);
+
+			const uint32_t ranges = (quadCount + Capacity - 1) / Capacity;
+			const RenderStats::Counters& frame = batched.CurrentFrame();
+			valid = valid && frame.DrawCalls == ranges && frame.BufferUploads == ranges + 1 && frame.ConstantBufferUploads == 1;
+
+			perQuadDraws += perQuad.CurrentFrame().DrawCalls;
+			perQuadUploads += perQuad.CurrentFrame().BufferUploads;
+			perQuadConstantUploads += perQuad.CurrentFrame().ConstantBufferUploads;
+			batchedDraws += frame.DrawCalls;
+			batchedUploads += frame.BufferUploads;
+		});
+
+		const double frames = static_cast<double>(frameCount);
+		printf("%-22s %6u quads/frame | per-quad %8.1f draws %8.1f uploads (%8.1f constant) | batched %4.1f draws %4.1f uploads (1 constant), %5.2f discards/frame, %9.0f ns/frame\n",
+			label, quadsPerFrame, perQuadDraws / frames, perQuadUploads / frames, perQuadConstantUploads / frames,
+			batchedDraws / frames, batchedUploads / frames, model.Discards() / frames, nanoseconds);
+
+		return valid && model.Valid();
+	}
+
+	void MeasureAllocate()
+	{
+		RingAllocator ring(Capacity);
+		uint64_t checksum = 0;
+		const double nanoseconds = MeasureNanoseconds(100000000, [&](uint64_t i) {
+			const RingAllocator::Range range = ring.Allocate(static_cast<uint32_t>(i & 63) + 1);
+			checksum += range.Offset + (range.Discard ? 1 : 0);
+		});
+		Consume(checksum);
+
+		printf("RingAllocator::Allocate: %.2f ns\n", nanoseconds);
+	}
+}
+
+int main()
+{
+	// The game itself: cherry and coin from PowerupManager, four walls from BoundaryManager.
+	bool valid = Run("game (2 components)", 2, 6, 100000);
+	valid = Run("100 objects", 4, 100, 100000) && valid;
+	valid = Run("1k objects", 8, 1000, 10000) && valid;
+	valid = Run("4k objects", 8, 4000, 2000) && valid;
+	valid = Run("10k objects", 8, 10000, 1000) && valid;
+	MeasureAllocate();
+	printf("Quad batch %s\n", valid ? "flushes in O(1) draws and never overwrites in-flight quads" : "BROKE ITS BUDGET");
+
+	return valid ? 0 : 1;
+}
@@ -0,0 +1,412 @@
+#include "Benchmark.h"
+#include "Board.h"
+#include "Game.h"
+#include "SegmentFont.h"
+#include "SoftwareRasterizer.h"
+#include "Tour.h"
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace Simulation;
+using namespace Benchmarks;
+
+namespace
+{
+	const uint32_t ScreenWidth = 1600;
+	const uint32_t ScreenHeight = 900;
+
+	// The reference frame, as rendered when the rasterizer was written. Any change to how
+	// it covers or shades pixels changes this; rerun with --write to look at the new image
+	// before updating it.
+	const uint64_t GoldenHash = 0x936eebca30e0debaull;
+
+	// OrthographicCamera's default view: 1600 x 900 world units centered on the origin.
+	Matrix4 ViewProjection()
+	{
+		Matrix4 viewProjection = {};
+		viewProjection.M[0][0] = 2.0f / ScreenWidth;
+		viewProjection.M[1][1] = 2.0f / ScreenHeight;
+		viewProjection.M[2][2] = 1.0f;
+		viewProjection.M[3][3] = 1.0f;
+		return viewProjection;
+	}
+
+	ColorVertex Vertex(float x, float y, float red, float green, float blue)
+	{
+		return { { x, y, 0.0f, 1.0f }, { red, green, blue, 1.0f } };
+	}
+
+	// Builds solid quads the way DX::QuadBatch does: four corners and six indices apiece.
+	class Quads final
+	{
+	public:
+		void Add(float left, float bottom, float right, float top, float red, float green, float blue)
+		{
+			static const uint16_t quadIndices[] = { 0, 1, 2, 2, 1, 3 };
+			const uint16_t first = static_cast<uint16_t>(mVertices.size());
+			for (uint16_t index : quadIndices)
+			{
+				mIndices.push_back(static_cast<uint16_t>(first + index));
+			}
+
+			mVertices.push_back(Vertex(left, top, red, green, blue));
+			mVertices.push_back(Vertex(right, top, red, green, blue));
+			mVertices.push_back(Vertex(left, bottom, red, green, blue));
+			mVertices.push_back(Vertex(right, bottom, red, green, blue));
+		}
+
+		void Draw(RenderBackend& backend)
+		{
+			backend.DrawIndexed(Topology::TriangleList, mVertices.data(), static_cast<uint32_t>(mVertices.size()), mIndices.data(), static_cast<uint32_t>(mIndices.size()));
+			mVertices.clear();
+			mIndices.clear();
+		}
+
+	private:
+		vector<ColorVertex> mVertices;
+		vector<uint16_t> mIndices;
+	};
+
+	void AddText(const char* text, float x, float y, vector<ColorVertex>& vertices)
+	{
+		vector<SegmentFont::Line> lines;
+		SegmentFont::AppendLines(text, x, y, lines);
+		for (const SegmentFont::Line& line : lines)
+		{
+			vertices.push_back(Vertex(line.FromX, line.FromY, 1.0f, 1.0f, 1.0f));
+			vertices.push_back(Vertex(line.ToX, line.ToY, 1.0f, 1.0f, 1.0f));
+		}
+	}
+
+	// A 16 x 16 checkerboard whose dark squares are half transparent.
+	vector<uint32_t> SpriteTexels()
+	{
+		vector<uint32_t> texels(16 * 16);
+		for (uint32_t y = 0; y < 16; y++)
+		{
+			for (uint32_t x = 0; x < 16; x++)
+			{
+				texels[y * 16 + x] = ((x / 4 + y / 4) % 2 == 0) ? 0xFF3080FFu : 0x80FF2020u;
+			}
+		}
+
+		return texels;
+	}
+
+	// One frame of the game as its components draw it, in every primitive the backend
+	// takes: walls, powerups and snake as indexed quads, the title and score as lines, a
+	// line strip around the board, a vertex-colored triangle strip and a blended sprite.
+	void RecordFrame(RenderBackend& backend, const Game& game, RenderBackend::TextureId sprite)
+	{
+		backend.Clear(0.0f, 0.0f, 0.0f, 1.0f);
+		backend.SetViewProjection(ViewProjection());
+
+		Quads quads;
+		const float cell = static_cast<float>(Board::CellSize);
+		quads.Add(-800.0f, Board::Top(), 800.0f, 450.0f, 0.3f, 0.3f, 0.3f);
+		quads.Add(-800.0f, Board::Bottom() - cell, 800.0f, Board::Bottom(), 0.3f, 0.3f, 0.3f);
+		quads.Add(-800.0f, Board::Bottom(), Board::Left(), Board::Top(), 0.3f, 0.3f, 0.3f);
+		quads.Add(Board::Right(), Board::Bottom(), 800.0f, Board::Top(), 0.3f, 0.3f, 0.3f);
+
+		const Powerups& powerups = game.GetPowerups();
+		const Vector2f cherry = Board::ToWorld(powerups.GetCherryPosition());
+		const Vector2f coin = Board::ToWorld(powerups.GetCoinPosition());
+		quads.Add(cherry.x + 1, cherry.y + 1, cherry.x + cell - 1, cherry.y + cell - 1, 1.0f, 0.0f, 0.0f);
+		quads.Add(coin.x + 1, coin.y + 1, coin.x + cell - 1, coin.y + cell - 1, 1.0f, 1.0f, 0.0f);
+		quads.Draw(backend);
+
+		const Snake& snake = game.GetSnake();
+		for (uint32_t i = 0; i <= snake.GetTailSize(); i++)
+		{
+			const Vector2f position = Board::ToWorld(i == 0 ? snake.Position() : snake.GetTailAt(i - 1));
+			quads.Add(position.x + 1, position.y + 1, position.x + cell - 1, position.y + cell - 1, 0.0f, 1.0f, 1.0f);
+		}
+		quads.Draw(backend);
+
+		vector<ColorVertex> lines;
+		AddText("Super Snake X", -300.0f, -450.0f, lines);
+		AddText(("Score " + to_string(snake.GetTailSize())).c_str(), 300.0f, 360.0f, lines);
+		backend.Draw(Topology::LineList, lines.data(), static_cast<uint32_t>(lines.size()));
+
+		const ColorVertex outline[] =
+		{
+			Vertex(Board::Left() - 2, Board::Bottom() - 2, 1.0f, 0.5f, 0.0f),
+			Vertex(Board::Right() + 2, Board::Bottom() - 2, 1.0f, 0.5f, 0.0f),
+			Vertex(Board::Right() + 2, Board::Top() + 2, 0.0f, 0.5f, 1.0f),
+			Vertex(Board::Left() - 2, Board::Top() + 2, 0.0f, 0.5f, 1.0f),
+			Vertex(Board::Left() - 2, Board::Bottom() - 2, 1.0f, 0.5f, 0.0f),
+		};
+		backend.Draw(Topology::LineStrip, outline, 5);
+
+		const ColorVertex banner[] =
+		{
+			Vertex(-780.0f, 440.0f, 1.0f, 0.0f, 0.0f),
+			Vertex(-780.0f, 380.0f, 0.0f, 1.0f, 0.0f),
+			Vertex(-480.0f, 430.0f, 0.0f, 0.0f, 1.0f),
+			Vertex(-480.0f, 390.0f, 1.0f, 1.0f, 1.0f),
+		};
+		backend.Draw(Topology::TriangleStrip, banner, 4);
+
+		const TextureVertex spriteQuad[] =
+		{
+			{ { 500.0f, -380.0f, 0.0f, 1.0f }, { 0.0f, 0.0f } },
+			{ { 628.0f, -380.0f, 0.0f, 1.0f }, { 1.0f, 0.0f } },
+			{ { 500.0f, -440.0f, 0.0f, 1.0f }, { 0.0f, 1.0f } },
+			{ { 628.0f, -440.0f, 0.0f, 1.0f }, { 1.0f, 1.0f } },
+		};
+		backend.DrawTextured(sprite, Topology::TriangleStrip, spriteQuad, 4);
+
+		backend.Submit();
+	}
+
+	// A game some way in, with a long snake winding along the tour.
+	unique_ptr<Game> PlayTo(uint32_t tailSize)
+	{
+		const vector<Direction> autopilot = BuildAutopilot(Board::Width, Board::Height);
+		unique_ptr<Game> game = make_unique<Game>(3);
+		while (game->GetSnake().GetTailSize() < tailSize && game->GetSnake().Alive())
+		{
+			game->IncreaseTail();
+			game->Move(autopilot[Board::CellIndex(game->GetSnake().Position())]);
+			game->Step();
+		}
+
+		return game;
+	}
+
+	uint64_t RenderReference(const Game& game, uint32_t threadCount, const char* writePath)
+	{
+		SoftwareRasterizer rasterizer(ScreenWidth, ScreenHeight, threadCount);
+		const vector<uint32_t> texels = SpriteTexels();
+		const RenderBackend::TextureId sprite = rasterizer.CreateTexture(16, 16, texels.data());
+		RecordFrame(rasterizer, game, sprite);
+
+		if (writePath != nullptr)
+		{
+			ofstream file(writePath, ios::binary);
+			rasterizer.GetFramebuffer().WritePpm(file);
+			printf("Wrote %s\n", writePath);
+		}
+
+		return rasterizer.GetFramebuffer().Hash();
+	}
+
+	// Coverage rules that hold whatever the scene: a pixel-aligned square covers exactly
+	// its pixels, and a quad split into two triangles, or a line strip, draws every pixel
+	// once. Drawing a half-transparent texel over black shows any pixel drawn twice.
+	bool CheckCoverage()
+	{
+		SoftwareRasterizer rasterizer(64, 64, 2);
+		Matrix4 pixels = {};
+		pixels.M[0][0] = 2.0f / 64;
+		pixels.M[1][1] = -2.0f / 64;
+		pixels.M[2][2] = 1.0f;
+		pixels.M[3][0] = -1.0f;
+		pixels.M[3][1] = 1.0f;
+		pixels.M[3][3] = 1.0f;
+		rasterizer.SetViewProjection(pixels);
+
+		const uint32_t halfWhite = 0x80FFFFFF;
+		const RenderBackend::TextureId texture = rasterizer.CreateTexture(1, 1, &halfWhite);
+		const TextureVertex square[] =
+		{
+			{ { 10.0f, 10.0f, 0.0f, 1.0f }, { 0.0f, 0.0f } },
+			{ { 30.0f, 10.0f, 0.0f, 1.0f }, { 0.0f, 0.0f } },
+			{ { 10.0f, 30.0f, 0.0f, 1.0f }, { 0.0f, 0.0f } },
+			{ { 30.0f, 30.0f, 0.0f, 1.0f }, { 0.0f, 0.0f } },
+		};
+		const ColorVertex strip[] =
+		{
+			Vertex(40.5f, 40.5f, 1.0f, 0.0f, 0.0f),
+			Vertex(60.5f, 40.5f, 1.0f, 0.0f, 0.0f),
+			Vertex(60.5f, 60.5f, 1.0f, 0.0f, 0.0f),
+		};
+
+		rasterizer.Clear(0.0f, 0.0f, 0.0f, 1.0f);
+		rasterizer.DrawTextured(texture, Topology::TriangleStrip, square, 4);
+		rasterizer.Draw(Topology::LineStrip, strip, 3);
+		rasterizer.Submit();
+
+		const Framebuffer& framebuffer = rasterizer.GetFramebuffer();
+		uint32_t squarePixels = 0;
+		uint32_t linePixels = 0;
+		bool valid = true;
+		for (uint32_t y = 0; y < 64; y++)
+		{
+			for (uint32_t x = 0; x < 64; x++)
+			{
+				const uint32_t pixel = framebuffer.Pixel(x, y);
+				const bool inSquare = x >= 10 && x < 30 && y >= 10 && y < 30;
+				valid = valid && (!inSquare || (pixel & 0xFFFFFF) == 0x808080);
+				squarePixels += (pixel & 0xFFFFFF) == 0x808080 ? 1 : 0;
+				linePixels += (pixel & 0xFFFFFF) == 0x0000FF ? 1 : 0;
+			}
+		}
+
+		// Twenty pixels along the bottom, twenty up the side; the corner once.
+		return valid && squarePixels == 400 && linePixels == 40;
+	}
+
+	// Forwards to another backend in pieces of at most Capacity vertices or indices, split
+	// the way DX::D3D11RenderBackend splits draws bigger than its buffers.
+	class SplittingBackend final : public RenderBackend
+	{
+	public:
+		static const uint32_t Capacity = 7;
+
+		explicit SplittingBackend(RenderBackend& target) :
+			mTarget(target)
+		{
+		}
+
+		virtual void Clear(float red, float green, float blue, float alpha) override
+		{
+			mTarget.Clear(red, green, blue, alpha);
+		}
+
+		virtual void SetViewProjection(const Matrix4& viewProjection) override
+		{
+			mTarget.SetViewProjection(viewProjection);
+		}
+
+		virtual void Draw(Topology topology, const ColorVertex* vertices, uint32_t vertexCount) override
+		{
+			ForEachPrimitiveChunk(topology, vertexCount, Capacity, [&](uint32_t first, uint32_t count) {
+				mTarget.Draw(topology, vertices + first, count);
+			});
+		}
+
+		virtual void DrawIndexed(Topology topology, const ColorVertex* vertices, uint32_t vertexCount, const uint16_t* indices, uint32_t indexCount) override
+		{
+			if (vertexCount > Capacity)
+			{
+				vector<ColorVertex> expanded(indexCount);
+				for (uint32_t i = 0; i < indexCount; i++)
+				{
+					expanded[i] = vertices[indices[i]];
+				}
+				Draw(topology, expanded.data(), indexCount);
+				return;
+			}
+
+			ForEachPrimitiveChunk(topology, indexCount, Capacity, [&](uint32_t first, uint32_t count) {
+				mTarget.DrawIndexed(topology, vertices, vertexCount, indices + first, count);
+			});
+		}
+
+		virtual TextureId CreateTexture(uint32_t width, uint32_t height, const uint32_t* texels) override
+		{
+			return mTarget.CreateTexture(width, height, texels);
+		}
+
+		virtual void DrawTextured(TextureId texture, Topology topology, const TextureVertex* vertices, uint32_t vertexCount) override
+		{
+			ForEachPrimitiveChunk(topology, vertexCount, Capacity, [&](uint32_t first, uint32_t count) {
+				mTarget.DrawTextured(texture, topology, vertices + first, count);
+			});
+		}
+
+		virtual void Submit() override
+		{
+			mTarget.Submit();
+		}
+
+	private:
+		RenderBackend& mTarget;
+	};
+
+	// A vertex-colored zigzag, as a triangle strip and as the line strip along its edge.
+	void RecordZigzag(RenderBackend& backend)
+	{
+		vector<ColorVertex> vertices;
+		for (uint32_t i = 0; i < 41; i++)
+		{
+			const float x = -700.0f + 30.0f * i;
+			vertices.push_back(Vertex(x, (i % 2 == 0) ? -300.0f : -200.0f, (i % 3) / 2.0f, (i % 5) / 4.0f, (i % 7) / 6.0f));
+		}
+
+		backend.Clear(0.0f, 0.0f, 0.0f, 1.0f);
+		backend.SetViewProjection(ViewProjection());
+		backend.Draw(Topology::TriangleStrip, vertices.data(), static_cast<uint32_t>(vertices.size()));
+		for (ColorVertex& vertex : vertices)
+		{
+			vertex.Position[1] += 200.0f;
+		}
+		backend.Draw(Topology::LineStrip, vertices.data(), static_cast<uint32_t>(vertices.size()));
+		backend.Submit();
+	}
+
+	// Splitting a draw must not lose or change a single primitive: the frame and the zigzag
+	// render the same whole and in pieces.
+	bool CheckSplitting(const Game& game)
+	{
+		SoftwareRasterizer whole(ScreenWidth, ScreenHeight, 2);
+		SoftwareRasterizer pieces(ScreenWidth, ScreenHeight, 2);
+		SplittingBackend splitter(pieces);
+		const vector<uint32_t> texels = SpriteTexels();
+		const RenderBackend::TextureId wholeSprite = whole.CreateTexture(16, 16, texels.data());
+		const RenderBackend::TextureId piecesSprite = splitter.CreateTexture(16, 16, texels.data());
+
+		RecordFrame(whole, game, wholeSprite);
+		RecordFrame(splitter, game, piecesSprite);
+		bool valid = whole.GetFramebuffer().Hash() == pieces.GetFramebuffer().Hash();
+
+		RecordZigzag(whole);
+		RecordZigzag(splitter);
+		valid = valid && whole.GetFramebuffer().Hash() == pieces.GetFramebuffer().Hash();
+		return valid;
+	}
+
+	void MeasureThroughput(const Game& game, uint32_t threadCount, uint32_t frameCount)
+	{
+		SoftwareRasterizer rasterizer(ScreenWidth, ScreenHeight, threadCount);
+		const vector<uint32_t> texels = SpriteTexels();
+		const RenderBackend::TextureId sprite = rasterizer.CreateTexture(16, 16, texels.data());
+
+		const double nanoseconds = MeasureNanoseconds(frameCount, [&](uint64_t) {
+			RecordFrame(rasterizer, game, sprite);
+		});
+		Consume(rasterizer.GetFramebuffer().Pixel(0, 0));
+
+		printf("%2u threads: %7.3f ms/frame (%6.1f fps) at %ux%u\n", threadCount, nanoseconds / 1000000.0, 1000000000.0 / nanoseconds, ScreenWidth, ScreenHeight);
+	}
+}
+
+// RasterizerBenchmark [--write frame.ppm] writes the reference frame for inspection.
+int main(int argc, char* argv[])
+{
+	const char* writePath = (argc == 3 && string(argv[1]) == "--write") ? argv[2] : nullptr;
+	const unique_ptr<Game> game = PlayTo(600);
+
+	const uint32_t cores = max(thread::hardware_concurrency(), 1u);
+	const uint64_t hash = RenderReference(*game, 1, writePath);
+	bool deterministic = true;
+	for (uint32_t threadCount = 2; threadCount <= max(cores, 4u); threadCount *= 2)
+	{
+		deterministic = RenderReference(*game, threadCount, nullptr) == hash && deterministic;
+	}
+	const bool covered = CheckCoverage();
+	const bool split = CheckSplitting(*game);
+	printf("reference frame hash %016llx (golden %016llx)\n", static_cast<unsigned long long>(hash), static_cast<unsigned long long>(GoldenHash));
+
+	for (uint32_t threadCount = 1; threadCount <= cores; threadCount *= 2)
+	{
+		MeasureThroughput(*game, threadCount, 200);
+	}
+	if ((cores & (cores - 1)) != 0)
+	{
+		MeasureThroughput(*game, cores, 200);
+	}
+
+	printf("draws split into pieces of %u %s\n", SplittingBackend::Capacity, split ? "render the same frame" : "RENDER A DIFFERENT FRAME");
+
+	const bool valid = deterministic && covered && split && hash == GoldenHash;
+	printf("Software rasterizer %s\n", valid ? "matches the golden frame on every thread count" :
+		!deterministic ? "DEPENDS ON THE THREAD COUNT" : !covered ? "BROKE THE FILL RULES" : !split ? "CHANGES WHEN DRAWS ARE SPLIT" : "NO LONGER MATCHES THE GOLDEN FRAME");
+
+	return valid ? 0 : 1;
+}
@@ -0,0 +1,244 @@
+#include "Benchmark.h"
+#include "Random.h"
+#include "RenderQueue.h"
+#include <vector>
+
+using namespace std;
+using namespace Simulation;
+using namespace Benchmarks;
+
+namespace
+{
+	// Pipeline and topology ids as DX::D3D11RenderQueue hands them out in the game.
+	const uint8_t ColorShapePipeline = 0;
+	const uint8_t SnakeBodyPipeline = 1;
+	const uint8_t LineList = 2;
+	const uint8_t TriangleList = 4;
+	const uint8_t TriangleStrip = 5;
+
+	struct QueuedDraw final
+	{
+		RenderQueue::DrawState State;
+		bool Opaque;
+	};
+
+	// Stands in for the device context: it tracks what is bound, checks that every draw
+	// runs exactly once with the state it was submitted with, and in an order the key allows.
+	class CheckingExecutor final : public RenderQueue::Executor
+	{
+	public:
+		explicit CheckingExecutor(const vector<QueuedDraw>& draws) :
+			mDraws(draws), mBound(), mDrawn(draws.size(), false), mLastKey(0), mLastCommand(0), mStarted(false), mValid(true)
+		{
+		}
+
+		bool Valid() const
+		{
+			for (bool drawn : mDrawn)
+			{
+				if (!drawn)
+				{
+					return false;
+				}
+			}
+			return mValid;
+		}
+
+		virtual void BindPipeline(uint8_t pipeline) override
+		{
+			mBound.Pipeline = pipeline;
+		}
+
+		virtual void BindTopology(uint8_t topology) override
+		{
+			mBound.Topology = topology;
+		}
+
+		virtual void BindTexture(uint16_t texture) override
+		{
+			mBound.Texture = texture;
+		}
+
+		virtual void BindGeometry(uintptr_t geometry) override
+		{
+			mBound.Geometry = geometry;
+		}
+
+		virtual void BindConstants(uintptr_t constants) override
+		{
+			mBound.Constants = constants;
+		}
+
+		virtual void Draw(uint32_t command) override
+		{
+			if (command >= mDraws.size() || mDrawn[command])
+			{
+				mValid = false;
+				return;
+			}
+			mDrawn[command] = true;
+
+			const QueuedDraw& draw = mDraws[command];
+			const RenderQueue::DrawState& state = draw.State;
+			if (draw.Opaque)
+			{
+				// The opaque draw leaves the context in a state the queue knows nothing about.
+				mBound = { 0, 0xEE, 0xEE, 0xEEEE, 0xEEEE, 0xEEEE };
+			}
+			else
+			{
+				mValid = mValid && mBound.Pipeline == state.Pipeline && mBound.Topology == state.Topology && mBound.Texture == state.Texture &&
+					mBound.Geometry == state.Geometry && mBound.Constants == state.Constants;
+			}
+
+			// Keys never decrease, and equal keys keep their submission order.
+			const uint64_t key = draw.Opaque ? RenderQueue::SortKey({ state.Layer, 0xFF, 0xFF, 0xFFFF, 0, 0 }) : RenderQueue::SortKey(state);
+			mValid = mValid && (!mStarted || key > mLastKey || (key == mLastKey && command > mLastCommand));
+			mLastKey = key;
+			mLastCommand = command;
+			mStarted = true;
+		}
+
+	private:
+		const vector<QueuedDraw>& mDraws;
+		RenderQueue::DrawState mBound;
+		vector<bool> mDrawn;
+		uint64_t mLastKey;
+		uint32_t mLastCommand;
+		bool mStarted;
+		bool mValid;
+	};
+
+	// An executor that does nothing, for timing the queue itself.
+	class NullExecutor final : public RenderQueue::Executor
+	{
+	public:
+		virtual void BindPipeline(uint8_t) override {}
+		virtual void BindTopology(uint8_t) override {}
+		virtual void BindTexture(uint16_t) override {}
+		virtual void BindGeometry(uintptr_t) override {}
+		virtual void BindConstants(uintptr_t) override {}
+		virtual void Draw(uint32_t command) override
+		{
+			Consume(command);
+		}
+	};
+
+	void Submit(RenderQueue& queue, const vector<QueuedDraw>& draws)
+	{
+		for (uint32_t i = 0; i < draws.size(); i++)
+		{
+			if (draws[i].Opaque)
+			{
+				queue.SubmitOpaque(draws[i].State.Layer, i);
+			}
+			else
+			{
+				queue.Submit(draws[i].State, i);
+			}
+		}
+	}
+
+	// What the components did before the queue: every draw binds every slot.
+	uint32_t RebindEverything(const vector<QueuedDraw>& draws)
+	{
+		uint32_t changes = 0;
+		for (const QueuedDraw& draw : draws)
+		{
+			changes += draw.Opaque ? 0 : RenderQueue::SlotCount;
+		}
+		return changes;
+	}
+
+	// Elision without sorting, in submission order.
+	uint32_t ElideInOrder(const vector<QueuedDraw>& draws)
+	{
+		uint32_t changes = 0;
+		const RenderQueue::DrawState* bound = nullptr;
+		for (const QueuedDraw& draw : draws)
+		{
+			if (draw.Opaque)
+			{
+				bound = nullptr;
+				continue;
+			}
+
+			const RenderQueue::DrawState& state = draw.State;
+			changes += bound == nullptr ? RenderQueue::SlotCount :
+				(state.Pipeline != bound->Pipeline) + (state.Topology != bound->Topology) + (state.Texture != bound->Texture) +
+				(state.Geometry != bound->Geometry) + (state.Constants != bound->Constants);
+			bound = &state;
+		}
+		return changes;
+	}
+
+	bool Measure(const char* name, const vector<QueuedDraw>& draws, uint32_t frameCount)
+	{
+		RenderQueue queue;
+		CheckingExecutor checker(draws);
+		Submit(queue, draws);
+		const RenderQueue::Statistics statistics = queue.Execute(checker);
+
+		bool valid = checker.Valid() && queue.Count() == 0 && statistics.Draws == draws.size() &&
+			statistics.StateChanges + statistics.ElidedStateChanges == RebindEverything(draws);
+
+		NullExecutor executor;
+		const double nanoseconds = MeasureNanoseconds(frameCount, [&](uint64_t) {
+			Submit(queue, draws);
+			Consume(queue.Execute(executor));
+		});
+
+		printf("%-22s | %5zu draws | state changes: rebind all %6u, elided in order %6u, sorted %6u | %8.0f ns/frame\n",
+			name, draws.size(), RebindEverything(draws), ElideInOrder(draws), statistics.StateChanges, nanoseconds);
+
+		return valid;
+	}
+
+	// GameMain's component order: the snake, the game-over text, the walls, the quad
+	// batch and the title, each with its own buffers.
+	vector<QueuedDraw> GameFrame()
+	{
+		vector<QueuedDraw> draws;
+		uintptr_t handle = 1;
+		auto add = [&](uint8_t pipeline, uint8_t topology) {
+			draws.push_back({ { 0, pipeline, topology, 0, handle, handle + 1 }, false });
+			handle += 2;
+		};
+
+		add(SnakeBodyPipeline, TriangleStrip);
+		add(ColorShapePipeline, LineList);
+		add(ColorShapePipeline, LineList);
+		add(ColorShapePipeline, TriangleList);
+		draws.push_back({ { 0, 0, 0, 0, 0, 0 }, true });
+		add(ColorShapePipeline, LineList);
+		return draws;
+	}
+
+	// Many components over a few pipelines and textures, in no particular order, sharing
+	// some buffers, spread over two layers.
+	vector<QueuedDraw> ManyComponents(uint32_t count)
+	{
+		Random random(12345);
+		vector<QueuedDraw> draws;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const uint8_t pipeline = static_cast<uint8_t>(random.Next() % 4);
+			const uint8_t topology = random.Next() % 2 == 0 ? TriangleList : LineList;
+			const uint16_t texture = static_cast<uint16_t>(pipeline == 3 ? 1 + random.Next() % 8 : 0);
+			const uintptr_t geometry = 1 + random.Next() % 64;
+			const uintptr_t constants = 1000 + random.Next() % 4;
+			draws.push_back({ { static_cast<uint8_t>(i * 2 / count), pipeline, topology, texture, geometry, constants }, false });
+		}
+		return draws;
+	}
+}
+
+int main()
+{
+	bool valid = Measure("game frame", GameFrame(), 1000000);
+	valid = Measure("1000 mixed components", ManyComponents(1000), 20000) && valid;
+	valid = Measure("10000 mixed components", ManyComponents(10000), 2000) && valid;
+	printf("Render queue %s\n", valid ? "draws everything once, in key order, with the state it was submitted with" : "DREW SOMETHING WRONG");
+
+	return valid ? 0 : 1;
+}
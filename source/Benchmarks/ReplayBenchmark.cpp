@@ -0,0 +1,192 @@
+#include "Benchmark.h"
+#include "Board.h"
+#include "Game.h"
+#include "Random.h"
+#include "Replay.h"
+#include "ReplayPlayer.h"
+#include "Tour.h"
+#include <memory>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+using namespace Simulation;
+using namespace Benchmarks;
+
+namespace
+{
+	bool SameState(const Game& lhs, const Game& rhs)
+	{
+		const Snake& left = lhs.GetSnake();
+		const Snake& right = rhs.GetSnake();
+		if (lhs.StepCount() != rhs.StepCount() || left.Position() != right.Position() || left.Alive() != right.Alive() ||
+			left.CurrentDirection() != right.CurrentDirection() || left.GetTailSize() != right.GetTailSize() ||
+			lhs.GetPowerups().GetCherryPosition() != rhs.GetPowerups().GetCherryPosition() ||
+			lhs.GetPowerups().GetCoinPosition() != rhs.GetPowerups().GetCoinPosition())
+		{
+			return false;
+		}
+
+		for (uint32_t i = 0; i < left.GetTailSize(); i++)
+		{
+			if (left.GetTailAt(i) != right.GetTailAt(i))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Plays the image back headless and checks it ends where the recorded game did.
+	bool Verify(const vector<uint8_t>& image, const Game& recorded, const char* name)
+	{
+		ReplayReader reader(image.data(), image.size());
+		ReplayPlayer player(reader);
+		player.RunToEnd();
+		const bool matches = reader.IsValid() && SameState(player.GetGame(), recorded);
+		printf("%-24s %8llu ticks, %6zu bytes, playback %s\n", name, static_cast<unsigned long long>(recorded.StepCount()), image.size(), matches ? "matches" : "DIVERGED");
+		return matches;
+	}
+
+	// A player following the tour, steering only when the tour turns: roughly an hour of
+	// play at ten ticks a second.
+	bool RecordTour(vector<uint8_t>& image)
+	{
+		const vector<Direction> autopilot = BuildAutopilot(Board::Width, Board::Height);
+		const uint64_t ticks = 36000;
+
+		Game game(42);
+		ReplayRecorder recorder(game.Seed());
+		game.SetRecorder(&recorder);
+		for (uint64_t tick = 0; tick < ticks && game.GetSnake().Alive(); tick++)
+		{
+			const Direction direction = autopilot[Board::CellIndex(game.GetSnake().Position())];
+			if (direction != game.GetSnake().CurrentDirection())
+			{
+				game.Move(direction);
+			}
+			game.Step();
+		}
+
+		image = recorder.Image(game.StepCount());
+		return Verify(image, game, "Tour, one hour");
+	}
+
+	// A game driven by Game::Update() at 60 frames per second, sped up with the grow cheat
+	// until it ticks nearly every frame, so intervals a float speed would get wrong come up.
+	// Watching the replay at normal speed must tick on exactly the frames the live game did.
+	bool RecordPaced()
+	{
+		const vector<Direction> autopilot = BuildAutopilot(Board::Width, Board::Height);
+		const double frameSeconds = 1.0 / 60.0;
+
+		Game game(7);
+		ReplayRecorder recorder(game.Seed());
+		game.SetRecorder(&recorder);
+		vector<uint64_t> stepCounts;
+		while (game.GetSnake().Alive() && stepCounts.size() < 20000)
+		{
+			const Direction direction = autopilot[Board::CellIndex(game.GetSnake().Position())];
+			if (direction != game.GetSnake().CurrentDirection())
+			{
+				game.Move(direction);
+			}
+			const uint64_t stepCount = game.StepCount();
+			game.Update(frameSeconds);
+			stepCounts.push_back(game.StepCount());
+
+			// Right after a tick, which is when playback applies it.
+			if (game.StepCount() != stepCount && game.StepCount() % 50 == 0 && game.StepInterval() > 20000000)
+			{
+				game.IncreaseTail();
+			}
+		}
+
+		const vector<uint8_t> image = recorder.Image(game.StepCount());
+		ReplayReader reader(image.data(), image.size());
+		unique_ptr<ReplayPlayer> player = make_unique<ReplayPlayer>(reader);
+		uint64_t sameFrames = 0;
+		for (uint64_t stepCount : stepCounts)
+		{
+			player->Update(frameSeconds);
+			sameFrames += player->GetGame().StepCount() == stepCount ? 1 : 0;
+		}
+
+		const bool matches = sameFrames == stepCounts.size() && SameState(player->GetGame(), game);
+		printf("%-24s %8llu ticks over %zu frames, %s\n", "Paced at 60 Hz", static_cast<unsigned long long>(game.StepCount()), stepCounts.size(),
+			matches ? "every frame ticks as it did live" : "PLAYBACK DRIFTED FROM LIVE PLAY");
+		return matches;
+	}
+
+	// Button mashing: several inputs in some ticks, long idle stretches in others, the
+	// occasional grow cheat. Exercises every code in the stream.
+	bool RecordRandom(uint32_t seed)
+	{
+		Random random(seed);
+		Game game(seed);
+		ReplayRecorder recorder(game.Seed());
+		game.SetRecorder(&recorder);
+		while (game.GetSnake().Alive() && game.StepCount() < 100000)
+		{
+			const uint32_t value = random.Next();
+			const uint32_t inputs = value % 8 < 5 ? 0 : value % 3;
+			for (uint32_t i = 0; i < inputs; i++)
+			{
+				const uint32_t choice = random.Next() % 12;
+				if (choice < 4)
+				{
+					game.Move(static_cast<Direction>(1 + choice));
+				}
+				else if (choice == 4)
+				{
+					game.IncreaseTail();
+				}
+				else if (choice == 5)
+				{
+					game.Move(Direction::Stop);
+				}
+			}
+
+			const uint32_t idle = (value >> 8) % 64 == 0 ? (value >> 16) % 300 : 1;
+			for (uint32_t i = 0; i < idle && game.GetSnake().Alive(); i++)
+			{
+				game.Step();
+			}
+		}
+
+		// Round trip through a stream, as the game does when saving.
+		stringstream file;
+		recorder.Write(file, game.StepCount());
+		vector<uint8_t> image;
+		ReplayReader::Read(file, image);
+
+		char name[32];
+		snprintf(name, sizeof(name), "Random input, seed %u", seed);
+		return Verify(image, game, name);
+	}
+}
+
+int main()
+{
+	bool passed = true;
+	vector<uint8_t> image;
+	passed &= RecordTour(image);
+	passed &= RecordPaced();
+	for (uint32_t seed = 1; seed <= 5; seed++)
+	{
+		passed &= RecordRandom(seed);
+	}
+
+	// Headless playback at full speed.
+	ReplayReader reader(image.data(), image.size());
+	uint64_t ticks = 0;
+	const uint64_t runs = 50;
+	const double nanoseconds = MeasureNanoseconds(runs, [&](uint64_t) {
+		ReplayPlayer player(reader);
+		ticks += player.RunToEnd();
+	});
+	printf("Playback: %.2f ms per one-hour replay, %.2f million ticks/s\n", nanoseconds / 1e6, ticks / (nanoseconds * runs / 1e3));
+
+	return passed ? 0 : 1;
+}
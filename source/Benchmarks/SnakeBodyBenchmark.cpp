@@ -0,0 +1,68 @@
+#include "Benchmark.h"
+#include "SnakeBody.h"
+#include <memory>
+#include <vector>
+
+using namespace std;
+using namespace Simulation;
+using namespace Benchmarks;
+
+namespace
+{
+	struct Segment
+	{
+		float x;
+		float y;
+	};
+
+	// Steps a body that has already reached the requested length.
+	template <uint32_t Length>
+	double RingBufferTick(uint64_t ticks)
+	{
+		unique_ptr<SnakeBody<Segment, Length>> body = make_unique<SnakeBody<Segment, Length>>();
+		body->Grow(Length);
+		for (uint32_t i = 0; i < Length; i++)
+		{
+			body->Advance(Segment{ static_cast<float>(i), 0.0f });
+		}
+
+		double nanoseconds = MeasureNanoseconds(ticks, [&](uint64_t tick) {
+			body->Advance(Segment{ static_cast<float>(tick), 1.0f });
+		});
+		Consume(body->Back());
+
+		return nanoseconds;
+	}
+
+	// The previous std::vector tail, which copied every segment one slot back per move.
+	double VectorShiftTick(uint32_t length, uint64_t ticks)
+	{
+		vector<Segment> tail(length, Segment{ 0.0f, 0.0f });
+
+		double nanoseconds = MeasureNanoseconds(ticks, [&](uint64_t tick) {
+			Segment lastCoord = tail[0];
+			tail[0] = Segment{ static_cast<float>(tick), 1.0f };
+			for (uint32_t i = 1; i < tail.size(); i++)
+			{
+				Segment last2Coord = tail[i];
+				tail[i] = lastCoord;
+				lastCoord = last2Coord;
+			}
+		});
+		Consume(tail.back());
+
+		return nanoseconds;
+	}
+}
+
+int main()
+{
+	const uint64_t ticks = 10000000;
+
+	printf("%12s %18s %18s\n", "length", "ring ns/tick", "vector ns/tick");
+	printf("%12u %18.2f %18.2f\n", 10, RingBufferTick<10>(ticks), VectorShiftTick(10, ticks / 10));
+	printf("%12u %18.2f %18.2f\n", 1000, RingBufferTick<1000>(ticks), VectorShiftTick(1000, ticks / 1000));
+	printf("%12u %18.2f %18.2f\n", 1000000, RingBufferTick<1000000>(ticks), VectorShiftTick(1000000, 10));
+
+	return 0;
+}
@@ -0,0 +1,74 @@
+#include "Benchmark.h"
+#include "Board.h"
+#include "Game.h"
+#include "Tour.h"
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace std;
+using namespace Simulation;
+using namespace Benchmarks;
+
+namespace
+{
+	// Follows the tour until the snake stops growing, leaving most of the board covered.
+	void FillBoard(Game& game)
+	{
+		const vector<Direction> autopilot = BuildAutopilot(Board::Width, Board::Height);
+		while (game.GetSnake().GetTailSize() < Snake::MaxLength && game.GetSnake().Alive())
+		{
+			game.Move(autopilot[Board::CellIndex(game.GetSnake().Position())]);
+			game.Step();
+		}
+	}
+
+	// A game restored from a snapshot must continue exactly as the original does.
+	bool VerifyRestore(const Game& source)
+	{
+		const vector<Direction> autopilot = BuildAutopilot(Board::Width, Board::Height);
+		Game original(source);
+		GameState snapshot(0);
+		original.Snapshot(snapshot);
+
+		Game restored(12345);
+		restored.Restore(snapshot);
+		for (uint32_t i = 0; i < 5000; i++)
+		{
+			original.Move(autopilot[Board::CellIndex(original.GetSnake().Position())]);
+			original.Step();
+			restored.Move(autopilot[Board::CellIndex(restored.GetSnake().Position())]);
+			restored.Step();
+		}
+
+		return memcmp(&original.State(), &restored.State(), sizeof(GameState)) == 0;
+	}
+
+	void Run(const char* name, Game& game, uint64_t iterations)
+	{
+		unique_ptr<GameState> snapshot = make_unique<GameState>(0);
+		const double nanoseconds = MeasureNanoseconds(iterations, [&](uint64_t) {
+			game.Snapshot(*snapshot);
+			game.Restore(*snapshot);
+		});
+		Consume(game.StepCount());
+
+		printf("%-12s tail %4u, %.2f ns per snapshot + restore, %.2f million pairs/s, restore %s\n", name, game.GetSnake().GetTailSize(), nanoseconds, 1000.0 / nanoseconds,
+			VerifyRestore(game) ? "matches" : "DIVERGED");
+	}
+}
+
+int main()
+{
+	const uint64_t iterations = 5000000;
+	printf("GameState: %zu bytes\n", sizeof(GameState));
+
+	unique_ptr<Game> empty = make_unique<Game>(7);
+	Run("Empty board", *empty, iterations);
+
+	unique_ptr<Game> full = make_unique<Game>(7);
+	FillBoard(*full);
+	Run("Full board", *full, iterations);
+
+	return 0;
+}
@@ -0,0 +1,36 @@
+#include "Benchmark.h"
+#include "Board.h"
+#include "Game.h"
+#include "Tour.h"
+#include <vector>
+
+using namespace std;
+using namespace Simulation;
+using namespace Benchmarks;
+
+int main()
+{
+	const vector<Direction> autopilot = BuildAutopilot(Board::Width, Board::Height);
+	const uint64_t steps = 20000000;
+	uint64_t games = 1;
+	uint64_t longestTail = 0;
+
+	Game game;
+	double nanoseconds = MeasureNanoseconds(steps, [&](uint64_t) {
+		if (!game.GetSnake().Alive())
+		{
+			game = Game();
+			++games;
+		}
+
+		const Cell& head = game.GetSnake().Position();
+		game.Move(autopilot[Board::CellIndex(head)]);
+		game.Step();
+		longestTail = max<uint64_t>(longestTail, game.GetSnake().GetTailSize());
+	});
+
+	printf("%llu steps over %llu games, longest tail %llu\n", static_cast<unsigned long long>(steps), static_cast<unsigned long long>(games), static_cast<unsigned long long>(longestTail));
+	printf("%.2f ns/step, %.2f million steps/s\n", nanoseconds, 1000.0 / nanoseconds);
+
+	return 0;
+}
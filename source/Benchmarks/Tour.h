@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Snake.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Benchmarks
+{
+	struct TourCell
+	{
+		std::int32_t x;
+		std::int32_t y;
+	};
+
+	// A Hamiltonian cycle over a board with an even height: along the bottom row, serpentine
+	// back through the remaining columns, then down the first column. A snake following it
+	// never collides with itself, even when it covers every cell.
+	inline std::vector<TourCell> BuildTour(std::int32_t width, std::int32_t height)
+	{
+		std::vector<TourCell> tour;
+		for (std::int32_t x = 0; x < width; x++)
+		{
+			tour.push_back(TourCell{ x, 0 });
+		}
+		for (std::int32_t y = 1; y < height; y++)
+		{
+			for (std::int32_t i = 1; i < width; i++)
+			{
+				tour.push_back(TourCell{ (y % 2 == 1) ? width - i : i, y });
+			}
+		}
+		for (std::int32_t y = height - 1; y > 0; y--)
+		{
+			tour.push_back(TourCell{ 0, y });
+		}
+		return tour;
+	}
+
+	// Direction to take from each cell, indexed y * width + x, to stay on the tour.
+	inline std::vector<Simulation::Direction> BuildAutopilot(std::int32_t width, std::int32_t height)
+	{
+		using Simulation::Direction;
+
+		const std::vector<TourCell> tour = BuildTour(width, height);
+		std::vector<Direction> autopilot(tour.size());
+		for (std::size_t i = 0; i < tour.size(); i++)
+		{
+			const TourCell& from = tour[i];
+			const TourCell& to = tour[(i + 1) % tour.size()];
+			Direction direction = to.x > from.x ? Direction::Right : to.x < from.x ? Direction::Left : to.y > from.y ? Direction::Up : Direction::Down;
+			autopilot[from.y * width + from.x] = direction;
+		}
+		return autopilot;
+	}
+}
@@ -109,6 +109,10 @@ namespace DirectXGame
 				{
 					mDeviceResources->Present();
 				}
+				else
+				{
+					mDeviceResources->WaitForVerticalBlank();
+				}
 			}
 			else
 			{
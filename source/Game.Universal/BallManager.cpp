@@ -1,22 +1,25 @@
 #include "pch.h"
 #include "BallManager.h"
+#include "D3D11RenderBackend.h"
 #include "Ball.h"
+#include "JobSystem.h"
 
 using namespace std;
 using namespace DirectX;
 using namespace DX;
+using namespace Simulation;
 
 namespace DirectXGame
 {
 	const uint32_t BallManager::CircleResolution = 32;
-	const uint32_t BallManager::LineCircleVertexCount = BallManager::CircleResolution + 2;
-	const uint32_t BallManager::SolidCircleVertexCount = (BallManager::CircleResolution + 1) * 2;
+	const uint32_t BallManager::UpdateGrainSize = 256;
 
 	BallManager::BallManager(const shared_ptr<DX::DeviceResources>& deviceResources, const shared_ptr<Camera>& camera) :
-		DrawableGameComponent(deviceResources, camera),
-		mLoadingComplete(false)
+		DrawableGameComponent(deviceResources, camera)
 	{
-		CreateDeviceDependentResources();
+		InitializeLineVertices();
+		InitializeTriangleVertices();
+		InitializeBalls();
 	}
 
 	std::shared_ptr<Field> BallManager::ActiveField() const
@@ -29,223 +32,96 @@ namespace DirectXGame
 		mActiveField = field;
 	}
 
-	void BallManager::CreateDeviceDependentResources()
+	// Balls only move themselves, so large sets are split across the job system.
+	void BallManager::Update(const StepTimer& timer)
 	{
-		auto loadVSTask = ReadDataAsync(L"ShapeRendererVS.cso");
-		auto loadPSTask = ReadDataAsync(L"ShapeRendererPS.cso");
-
-		// After the vertex shader file is loaded, create the shader and input layout.
-		auto createVSTask = loadVSTask.then([this](const std::vector<byte>& fileData) {
-			ThrowIfFailed(
-				mDeviceResources->GetD3DDevice()->CreateVertexShader(
-					&fileData[0],
-					fileData.size(),
-					nullptr,
-					mVertexShader.ReleaseAndGetAddressOf()
-				)
-			);
-
-			// Create an input layout
-			ThrowIfFailed(
-				mDeviceResources->GetD3DDevice()->CreateInputLayout(
-					VertexPosition::InputElements,
-					VertexPosition::InputElementCount,
-					&fileData[0],
-					fileData.size(),
-					mInputLayout.ReleaseAndGetAddressOf()
-				)
-			);
-
-			CD3D11_BUFFER_DESC constantBufferDesc(sizeof(XMFLOAT4X4), D3D11_BIND_CONSTANT_BUFFER);
-			ThrowIfFailed(
-				mDeviceResources->GetD3DDevice()->CreateBuffer(
-					&constantBufferDesc,
-					nullptr,
-					mVSCBufferPerObject.ReleaseAndGetAddressOf()
-				)
-			);
-		});
-
-		// After the pixel shader file is loaded, create the shader and constant buffer.
-		auto createPSTask = loadPSTask.then([this](const std::vector<byte>& fileData) {
-			ThrowIfFailed(
-				mDeviceResources->GetD3DDevice()->CreatePixelShader(
-					&fileData[0],
-					fileData.size(),
-					nullptr,
-					mPixelShader.ReleaseAndGetAddressOf()
-				)
-			);
-
-			CD3D11_BUFFER_DESC constantBufferDesc(sizeof(XMFLOAT4), D3D11_BIND_CONSTANT_BUFFER);
-			ThrowIfFailed(
-				mDeviceResources->GetD3DDevice()->CreateBuffer(
-					&constantBufferDesc,
-					nullptr,
-					mPSCBufferPerObject.ReleaseAndGetAddressOf()
-				)
-			);
-		});
-
-		auto createVerticesAndBallsTask = (createPSTask && createVSTask).then([this]() {
-			InitializeLineVertices();
-			InitializeTriangleVertices();
-			InitializeBalls();
-		});
-
-		// Once the cube is loaded, the object is ready to be rendered.
-		createVerticesAndBallsTask.then([this]() {
-			mLoadingComplete = true;
+		JobSystem::GetInstance()->ParallelFor(0, static_cast<uint32_t>(mBalls.size()), UpdateGrainSize, [&](uint32_t first, uint32_t last)
+		{
+			for (uint32_t i = first; i < last; i++)
+			{
+				mBalls[i]->Update(timer);
+			}
 		});
 	}
 
-	void BallManager::ReleaseDeviceDependentResources()
+	// Balls bounce off the active field.
+	bool BallManager::DeclareUpdateAccess(Simulation::TaskGraph::Access& access) const
 	{
-		mLoadingComplete = false;
-		mVertexShader.Reset();
-		mPixelShader.Reset();
-		mInputLayout.Reset();
-		mLineVertexBuffer.Reset();
-		mTriangleVertexBuffer.Reset();
-		mVSCBufferPerObject.Reset();
-		mPSCBufferPerObject.Reset();
+		access.Reads.push_back(mActiveField.get());
+		return true;
 	}
 
-	void BallManager::Update(const StepTimer& timer)
+	bool BallManager::RecordsInParallel() const
 	{
-		for (const auto& ball : mBalls)
-		{
-			ball->Update(timer);
-		}
+		return true;
 	}
 
-	void BallManager::Render(const StepTimer & timer)
+	void BallManager::Record(const StepTimer& timer, RenderBackend& backend)
 	{
 		UNREFERENCED_PARAMETER(timer);
-		
-		// Loading is asynchronous. Only draw geometry after it's loaded.
-		if (!mLoadingComplete)
-		{
-			return;
-		}
-
-		ID3D11DeviceContext* direct3DDeviceContext = mDeviceResources->GetD3DDeviceContext();		
-		direct3DDeviceContext->IASetInputLayout(mInputLayout.Get());
-
-		direct3DDeviceContext->VSSetShader(mVertexShader.Get(), nullptr, 0);
-		direct3DDeviceContext->PSSetShader(mPixelShader.Get(), nullptr, 0);
-
-		direct3DDeviceContext->VSSetConstantBuffers(0, 1, mVSCBufferPerObject.GetAddressOf());
-		direct3DDeviceContext->PSSetConstantBuffers(0, 1, mPSCBufferPerObject.GetAddressOf());
 
+		mLineVertices.clear();
+		mTriangleVertices.clear();
 		for (const auto& ball : mBalls)
 		{
 			if (ball->IsSolid())
 			{
-				DrawSolidBall(*ball);
+				AppendBall(*ball, mTriangleShape, mTriangleVertices);
 			}
 			else
 			{
-				DrawBall(*ball);
+				AppendBall(*ball, mLineShape, mLineVertices);
 			}
 		}
-	}
-
-	void BallManager::DrawBall(const Ball& ball)
-	{
-		ID3D11DeviceContext* direct3DDeviceContext = mDeviceResources->GetD3DDeviceContext();
-		direct3DDeviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINESTRIP);
-
-		static const UINT stride = sizeof(VertexPosition);
-		static const UINT offset = 0;
-		direct3DDeviceContext->IASetVertexBuffers(0, 1, mLineVertexBuffer.GetAddressOf(), &stride, &offset);
 
-		const XMMATRIX wvp = XMMatrixTranspose(XMMatrixScaling(ball.Radius(), ball.Radius(), ball.Radius()) * ball.Transform().WorldMatrix() * mCamera->ViewProjectionMatrix());
-		direct3DDeviceContext->UpdateSubresource(mVSCBufferPerObject.Get(), 0, nullptr, reinterpret_cast<const float*>(wvp.r), 0, 0);
+		backend.SetViewProjection(D3D11RenderBackend::ToMatrix4(mCamera->ViewProjectionMatrix()));
 
-		direct3DDeviceContext->UpdateSubresource(mPSCBufferPerObject.Get(), 0, nullptr, &ball.Color(), 0, 0);
-
-		direct3DDeviceContext->Draw(LineCircleVertexCount, 0);
+		// The backend splits draws bigger than its buffers on whole lines and triangles.
+		backend.Draw(Topology::LineList, mLineVertices.data(), static_cast<uint32_t>(mLineVertices.size()));
+		backend.Draw(Topology::TriangleList, mTriangleVertices.data(), static_cast<uint32_t>(mTriangleVertices.size()));
 	}
 
-	void BallManager::DrawSolidBall(const Ball & ball)
+	void BallManager::AppendBall(const Ball& ball, const vector<XMFLOAT4>& shape, vector<ColorVertex>& vertices)
 	{
-		ID3D11DeviceContext* direct3DDeviceContext = mDeviceResources->GetD3DDeviceContext();
-		direct3DDeviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
-
-		static const UINT stride = sizeof(VertexPosition);
-		static const UINT offset = 0;
-		direct3DDeviceContext->IASetVertexBuffers(0, 1, mTriangleVertexBuffer.GetAddressOf(), &stride, &offset);
-
-		const XMMATRIX wvp = XMMatrixTranspose(XMMatrixScaling(ball.Radius(), ball.Radius(), ball.Radius()) * ball.Transform().WorldMatrix() * mCamera->ViewProjectionMatrix());
-		direct3DDeviceContext->UpdateSubresource(mVSCBufferPerObject.Get(), 0, nullptr, reinterpret_cast<const float*>(wvp.r), 0, 0);
-
-		direct3DDeviceContext->UpdateSubresource(mPSCBufferPerObject.Get(), 0, nullptr, &ball.Color(), 0, 0);
-
-		direct3DDeviceContext->Draw(SolidCircleVertexCount, 0);
+		const XMMATRIX world = XMMatrixScaling(ball.Radius(), ball.Radius(), ball.Radius()) * ball.Transform().WorldMatrix();
+		const XMFLOAT4& color = ball.Color();
+		for (const XMFLOAT4& position : shape)
+		{
+			ColorVertex vertex = { {}, { color.x, color.y, color.z, color.w } };
+			XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(vertex.Position), XMVector4Transform(XMLoadFloat4(&position), world));
+			vertices.push_back(vertex);
+		}
 	}
 
+	// The unit circle as line list segments, plus the axis line for visualizing rotation.
 	void BallManager::InitializeLineVertices()
 	{
 		const float increment = XM_2PI / CircleResolution;
 
-		VertexPosition vertices[LineCircleVertexCount];
-
-		for (int i = 0; i < CircleResolution; i++)
+		mLineShape.clear();
+		for (uint32_t i = 0; i < CircleResolution; i++)
 		{
-			VertexPosition& vertex = vertices[i];
-
-			vertex.Position.x = cosf(i * increment);
-			vertex.Position.y = sinf(i * increment);
-			vertex.Position.z = 0.0f;
-			vertex.Position.w = 1.0f;
+			mLineShape.emplace_back(cosf(i * increment), sinf(i * increment), 0.0f, 1.0f);
+			mLineShape.emplace_back(cosf((i + 1) * increment), sinf((i + 1) * increment), 0.0f, 1.0f);
 		}
 
-		// Closing line to complete the circle
-		vertices[CircleResolution] = VertexPosition(vertices[0]);
-
-		// Axis line for visualizing rotation
-		vertices[CircleResolution + 1] = VertexPosition(XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f));
-
-		D3D11_BUFFER_DESC vertexBufferDesc = { 0 };
-		vertexBufferDesc.ByteWidth = sizeof(VertexPosition) * LineCircleVertexCount;
-		vertexBufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
-		vertexBufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-
-		D3D11_SUBRESOURCE_DATA vertexSubResourceData = { 0 };
-		vertexSubResourceData.pSysMem = vertices;
-		ThrowIfFailed(mDeviceResources->GetD3DDevice()->CreateBuffer(&vertexBufferDesc, &vertexSubResourceData, mLineVertexBuffer.ReleaseAndGetAddressOf()));
+		mLineShape.emplace_back(1.0f, 0.0f, 0.0f, 1.0f);
+		mLineShape.emplace_back(0.0f, 0.0f, 0.0f, 1.0f);
 	}
 
+	// The unit disc as a triangle list, one wedge per step around the circle.
 	void BallManager::InitializeTriangleVertices()
 	{
 		const float increment = XM_2PI / CircleResolution;
 		const XMFLOAT4 center(0.0f, 0.0f, 0.0f, 1.0f);
 
-		vector<VertexPosition> vertices;
-		vertices.reserve(SolidCircleVertexCount);
-		for (int i = 0; i <= CircleResolution; i++)
+		mTriangleShape.clear();
+		for (uint32_t i = 0; i < CircleResolution; i++)
 		{
-			VertexPosition vertex;
-			vertex.Position.x = cosf(i * increment);
-			vertex.Position.y = sinf(i * increment);
-			vertex.Position.z = 0.0f;
-			vertex.Position.w = 1.0f;
-
-			vertices.push_back(vertex);			
-			vertices.push_back(center);
+			mTriangleShape.emplace_back(cosf(i * increment), sinf(i * increment), 0.0f, 1.0f);
+			mTriangleShape.push_back(center);
+			mTriangleShape.emplace_back(cosf((i + 1) * increment), sinf((i + 1) * increment), 0.0f, 1.0f);
 		}
-
-		assert(vertices.size() == SolidCircleVertexCount);
-				
-		D3D11_BUFFER_DESC vertexBufferDesc = { 0 };
-		vertexBufferDesc.ByteWidth = sizeof(VertexPosition) * static_cast<uint32_t>(vertices.size());
-		vertexBufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
-		vertexBufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-
-		D3D11_SUBRESOURCE_DATA vertexSubResourceData = { 0 };
-		vertexSubResourceData.pSysMem = &vertices[0];
-		ThrowIfFailed(mDeviceResources->GetD3DDevice()->CreateBuffer(&vertexBufferDesc, &vertexSubResourceData, mTriangleVertexBuffer.ReleaseAndGetAddressOf()));
 	}
 
 	void BallManager::InitializeBalls()
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "DrawableGameComponent.h"
+#include "RenderBackend.h"
 #include <DirectXMath.h>
 #include <vector>
 
@@ -9,6 +10,9 @@ namespace DirectXGame
 	class Ball;
 	class Field;
 
+	// Draws every ball as colored vertices through the render backend: the outlines in one
+	// line list and the solid balls in one triangle list, however many balls and colors.
+	// Transforming the balls is all CPU work, so it is recorded off the main thread.
 	class BallManager final : public DX::DrawableGameComponent
 	{
 	public:
@@ -17,30 +21,25 @@ namespace DirectXGame
 		std::shared_ptr<Field> ActiveField() const;
 		void SetActiveField(const std::shared_ptr<Field>& field);
 
-		virtual void CreateDeviceDependentResources() override;
-		virtual void ReleaseDeviceDependentResources() override;
 		virtual void Update(const DX::StepTimer& timer) override;
-		virtual void Render(const DX::StepTimer& timer) override;
+		virtual bool DeclareUpdateAccess(Simulation::TaskGraph::Access& access) const override;
+		virtual bool RecordsInParallel() const override;
+		virtual void Record(const DX::StepTimer& timer, Simulation::RenderBackend& backend) override;
 
 	private:
 		void InitializeLineVertices();
 		void InitializeTriangleVertices();
 		void InitializeBalls();
-		void DrawBall(const Ball& ball);
-		void DrawSolidBall(const Ball& ball);
+
+		static void AppendBall(const Ball& ball, const std::vector<DirectX::XMFLOAT4>& shape, std::vector<Simulation::ColorVertex>& vertices);
 
 		static const std::uint32_t CircleResolution;
-		static const std::uint32_t LineCircleVertexCount;
-		static const std::uint32_t SolidCircleVertexCount;
-
-		Microsoft::WRL::ComPtr<ID3D11VertexShader> mVertexShader;
-		Microsoft::WRL::ComPtr<ID3D11PixelShader> mPixelShader;
-		Microsoft::WRL::ComPtr<ID3D11InputLayout> mInputLayout;
-		Microsoft::WRL::ComPtr<ID3D11Buffer> mLineVertexBuffer;
-		Microsoft::WRL::ComPtr<ID3D11Buffer> mTriangleVertexBuffer;
-		Microsoft::WRL::ComPtr<ID3D11Buffer> mVSCBufferPerObject;
-		Microsoft::WRL::ComPtr<ID3D11Buffer> mPSCBufferPerObject;
-		bool mLoadingComplete;
+		static const std::uint32_t UpdateGrainSize;
+
+		std::vector<DirectX::XMFLOAT4> mLineShape;
+		std::vector<DirectX::XMFLOAT4> mTriangleShape;
+		std::vector<Simulation::ColorVertex> mLineVertices;
+		std::vector<Simulation::ColorVertex> mTriangleVertices;
 		std::vector<std::shared_ptr<Ball>> mBalls;
 		std::shared_ptr<Field> mActiveField;
 	};
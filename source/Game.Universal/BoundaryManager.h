@@ -1,4 +1,6 @@
 #pragma once
+#include "Board.h"
+#include "StaticGeometry.h"
 
 namespace DirectXGame
 {
@@ -9,26 +11,13 @@ namespace DirectXGame
 		virtual void CreateDeviceDependentResources() override;
 		virtual void ReleaseDeviceDependentResources() override;
 		virtual void Render(const DX::StepTimer& timer) override;
+		virtual bool VisualStateChanged() const override;
 	private:
 		// Constants
-		const uint32_t BodySize = 25;
-
-		// Private methdos
-		void RenderTop();
-		void RenderBottom();
-		void RenderLeft();
-		void RenderRight();
+		const uint32_t BodySize = Simulation::Board::CellSize;
+		static const DirectX::XMFLOAT4 WallColor;
 
 		// Private fields
-		Microsoft::WRL::ComPtr<ID3D11VertexShader> mVertexShader;
-		Microsoft::WRL::ComPtr<ID3D11PixelShader> mPixelShader;
-		Microsoft::WRL::ComPtr<ID3D11InputLayout> mInputLayout;
-		Microsoft::WRL::ComPtr<ID3D11Buffer> mVertexBuffer;
-		Microsoft::WRL::ComPtr<ID3D11Buffer> mIndexBuffer;
-		Microsoft::WRL::ComPtr<ID3D11Buffer> mVSCBufferPerObject;
-		Microsoft::WRL::ComPtr<ID3D11Buffer> mPSCBufferPerObject;
-		std::uint32_t mIndexCount;
-		bool mLoadingComplete;
+		DX::StaticGeometry mWalls;
 	};
 }
-
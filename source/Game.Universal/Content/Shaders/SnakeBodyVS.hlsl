@@ -0,0 +1,30 @@
+cbuffer CBufferPerObject
+{
+	float4x4 WorldViewProjection;
+	float Blend;
+}
+
+struct VS_INPUT
+{
+	float4 ObjectPosition: POSITION;
+	float4 Color : COLOR;
+	float2 InstanceFrom : INSTANCEFROM;
+	float2 InstanceTo : INSTANCETO;
+};
+
+struct VS_OUTPUT
+{
+	float4 Position: SV_Position;
+	float4 Color : COLOR;
+};
+
+VS_OUTPUT main(VS_INPUT IN)
+{
+	VS_OUTPUT OUT = (VS_OUTPUT)0;
+
+	float2 offset = lerp(IN.InstanceFrom, IN.InstanceTo, Blend);
+	OUT.Position = mul(IN.ObjectPosition + float4(offset, 0, 0), WorldViewProjection);
+	OUT.Color = IN.Color;
+
+	return OUT;
+}
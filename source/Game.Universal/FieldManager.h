@@ -4,11 +4,6 @@
 #include <DirectXMath.h>
 #include <vector>
 
-namespace DX
-{
-	struct VertexPosition;
-}
-
 namespace DirectXGame
 {
 	class Field;
@@ -22,7 +17,6 @@ namespace DirectXGame
 		void SetActiveField(const std::shared_ptr<Field>& field);
 
 		virtual void CreateDeviceDependentResources() override;
-		virtual void ReleaseDeviceDependentResources() override;
 		virtual void Render(const DX::StepTimer& timer) override;
 
 	private:
@@ -31,15 +25,6 @@ namespace DirectXGame
 		static const std::uint32_t CircleResolution;
 		static const std::uint32_t CircleVertexCount;
 
-		Microsoft::WRL::ComPtr<ID3D11VertexShader> mVertexShader;
-		Microsoft::WRL::ComPtr<ID3D11PixelShader> mPixelShader;
-		Microsoft::WRL::ComPtr<ID3D11InputLayout> mInputLayout;
-		Microsoft::WRL::ComPtr<ID3D11Buffer> mVertexBuffer;
-		Microsoft::WRL::ComPtr<ID3D11Buffer> mIndexBuffer;
-		Microsoft::WRL::ComPtr<ID3D11Buffer> mVSCBufferPerObject;
-		Microsoft::WRL::ComPtr<ID3D11Buffer> mPSCBufferPerObject;
-		bool mLoadingComplete;
-		std::uint32_t mIndexCount;
 		std::shared_ptr<Field> mActiveField;
 	};
 }
\ No newline at end of file
@@ -3,11 +3,27 @@
 #include "SixteenSegmentManager.h"
 #include "PowerupManager.h"
 #include "BoundaryManager.h"
+#include "ShaderCache.h"
+#include "QuadBatch.h"
+#include "D3D11RenderBackend.h"
+#include "D3D11RenderQueue.h"
+#include "StaticGeometry.h"
+#include "Game.h"
+#include "JobSystem.h"
+#include "ParallelRecorder.h"
+#include "Profiler.h"
+#include "RenderStats.h"
+#include "ReplayPlayer.h"
+#include <chrono>
+#include <fstream>
+#include <random>
+#include <typeinfo>
 
 using namespace DX;
 using namespace std;
 using namespace DirectX;
 using namespace Windows::Foundation;
+using namespace Windows::Storage;
 using namespace Windows::System::Threading;
 using namespace Windows::ApplicationModel::Core;
 using namespace Windows::UI::Core;
@@ -17,61 +33,80 @@ namespace DirectXGame
 {
 	// Loads and initializes application assets when the application is loaded.
 	GameMain::GameMain(const shared_ptr<DX::DeviceResources>& deviceResources) :
-		mDeviceResources(deviceResources)
+		mDeviceResources(deviceResources), mLastCpuSeconds(Simulation::FrameSkipper::ThreadCpuSeconds()), mLastMeasurement(chrono::steady_clock::now()),
+		mShaderComparison(ShaderComparison::Idle)
 	{
 		// Register to be notified if the Device is lost or recreated
 		mDeviceResources->RegisterDeviceNotify(this);
+		ShaderCache::Init(mDeviceResources);
+		mRenderBackend = make_shared<D3D11RenderBackend>(mDeviceResources);
+		mRenderQueue = D3D11RenderQueue::Init(mDeviceResources);
+		mCommandRecorder = make_shared<Simulation::ParallelRecorder>();
+		mJobSystem = Simulation::JobSystem::Init();
 
 		auto camera = make_shared<OrthographicCamera>(mDeviceResources);
-		mComponents.push_back(camera);
+		mComponents.Add(camera);
 		camera->SetPosition(0, 0, 1);
 		camera->CreateWindowSizeDependentResources();
 
 		CoreWindow^ window = CoreWindow::GetForCurrentThread();
 		mKeyboard = make_shared<KeyboardComponent>(mDeviceResources);		
 		mKeyboard->Keyboard()->SetWindow(window);
-		mComponents.push_back(mKeyboard);
+		mComponents.Add(mKeyboard);
 
 		mMouse = make_shared<MouseComponent>(mDeviceResources);		
 		mMouse->Mouse()->SetWindow(window);
-		mComponents.push_back(mMouse);
+		mComponents.Add(mMouse);
 
 		mGamePad = make_shared<GamePadComponent>(mDeviceResources);
-		mComponents.push_back(mGamePad);
+		mComponents.Add(mGamePad);
 
 		auto fpsTextRenderer = make_shared<FpsTextRenderer>(mDeviceResources);
-		mComponents.push_back(fpsTextRenderer);
+		mComponents.Add(fpsTextRenderer);
 
 //		auto fieldManager = make_shared<FieldManager>(mDeviceResources, camera);
-//		mComponents.push_back(fieldManager);
+//		mComponents.Add(fieldManager);
 
 //		auto ballManager = make_shared<BallManager>(mDeviceResources, camera);
 //		ballManager->SetActiveField(fieldManager->ActiveField());
-//		mComponents.push_back(ballManager);
+//		mComponents.Add(ballManager);
 		
-		mPlayer = make_shared<Player>(mDeviceResources, camera);
-		mComponents.push_back(mPlayer);
+		const uint32_t seed = random_device()();
+		mGame = make_shared<Simulation::Game>(seed);
+		mRecorder = make_shared<Simulation::ReplayRecorder>(seed);
+		mGame->SetRecorder(mRecorder.get());
+
+		mPlayer = make_shared<Player>(mDeviceResources, camera, mGame);
+		mComponents.Add(mPlayer);
 
 		auto sixteenSegmentManager = SixteenSegmentManager::Init(mDeviceResources, camera);
-		mComponents.push_back(sixteenSegmentManager);
+		mComponents.Add(sixteenSegmentManager);
 
-		auto powerupManager = PowerupManager::Init(mDeviceResources, camera);
-		mComponents.push_back(powerupManager);
+		auto powerupManager = PowerupManager::Init(mDeviceResources, camera, mGame);
+		mComponents.Add(powerupManager);
 
 		auto boundaryManager = make_shared<BoundaryManager>(mDeviceResources, camera);
-		mComponents.push_back(boundaryManager);
+		mComponents.Add(boundaryManager);
+
+		// Draws the quads the components queued this frame.
+		auto quadBatch = QuadBatch::Init(mDeviceResources, camera, mRenderBackend);
+		mComponents.Add(quadBatch);
+
+		auto title = make_shared<StaticGeometry>(mDeviceResources, camera, D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
+		SixteenSegmentManager::AppendString(*title, "Super Snake X", -300, -450);
+		mComponents.Add(title);
 
 //		const int32_t spriteRowCount = 12;
 //		const int32_t spriteColumnCount = 15;
 //		auto spriteDemoManager = make_shared<SpriteDemoManager>(mDeviceResources, camera, spriteRowCount, spriteColumnCount);		
 //		const XMFLOAT2 center((-spriteColumnCount + 1) * SpriteDemoManager::SpriteScale.x, (-spriteRowCount + 1) * SpriteDemoManager::SpriteScale.y);
 //		spriteDemoManager->SetPositon(center);
-//		mComponents.push_back(spriteDemoManager);
+//		mComponents.Add(spriteDemoManager);
 
 		mTimer.SetFixedTimeStep(true);
 		mTimer.SetTargetElapsedSeconds(1.0 / 60);
 
-		IntializeResources();
+		IntializeResources(L"Startup");
 	}
 
 	GameMain::~GameMain()
@@ -82,7 +117,8 @@ namespace DirectXGame
 	// Updates application state when the window size changes (e.g. device orientation change)
 	void GameMain::CreateWindowSizeDependentResources()
 	{
-		for (auto& component : mComponents)
+		mFrameSkipper.Invalidate();
+		for (auto& component : mComponents.All())
 		{
 			component->CreateWindowSizeDependentResources();
 		}
@@ -91,46 +127,83 @@ namespace DirectXGame
 	// Updates the application state once per frame.
 	void GameMain::Update()
 	{
+		SIMULATION_PROFILE_ZONE("GameMain::Update");
+		MeasureCpuTime();
+		ContinueShaderComparison();
+
 		// Update scene objects.
 		mTimer.Tick([&]()
 		{
-			for (auto& component : mComponents)
-			{
-				component->Update(mTimer);
-			}
+			mComponents.Update(mTimer, *mJobSystem);
 
 			if (mKeyboard->WasKeyPressedThisFrame(Keys::Escape) ||
 				mMouse->WasButtonPressedThisFrame(MouseButtons::Middle) ||
 				mGamePad->WasButtonPressedThisFrame(GamePadButtons::Back))
 			{
+				if (mReplayPlayer == nullptr)
+				{
+					SaveReplay();
+				}
 				CoreApplication::Exit();
 			}
 
+			// A replay plays out at the pace it was recorded and the game shows its state;
+			// live input is ignored until the app exits.
+			if (mReplayPlayer != nullptr)
+			{
+				mReplayPlayer->Update(mTimer.GetElapsedSeconds());
+				mGame->Restore(mReplayPlayer->GetGame().State());
+				return;
+			}
+
+			if (mKeyboard->WasKeyPressedThisFrame(Keys::L))
+			{	// Debug to watch the last saved session
+				StartPlayback();
+				return;
+			}
+
 			if (mKeyboard->WasKeyPressedThisFrame(Keys::W) || mKeyboard->WasKeyPressedThisFrame(Keys::Up) ||
 				mGamePad->WasButtonPressedThisFrame(GamePadButtons::DPadUp))
 			{
-				mPlayer->Move(Player::Direction::Up);
+				mGame->Move(Simulation::Direction::Up);
 			}
 			else if (mKeyboard->WasKeyPressedThisFrame(Keys::S) || mKeyboard->WasKeyPressedThisFrame(Keys::Down) ||
 				mGamePad->WasButtonPressedThisFrame(GamePadButtons::DPadDown))
 			{
-				mPlayer->Move(Player::Direction::Down);
+				mGame->Move(Simulation::Direction::Down);
 			}
 			else if (mKeyboard->WasKeyPressedThisFrame(Keys::A) || mKeyboard->WasKeyPressedThisFrame(Keys::Left) ||
 				mGamePad->WasButtonPressedThisFrame(GamePadButtons::DPadLeft))
 			{
-				mPlayer->Move(Player::Direction::Left);
+				mGame->Move(Simulation::Direction::Left);
 			}
 			else if (mKeyboard->WasKeyPressedThisFrame(Keys::D) || mKeyboard->WasKeyPressedThisFrame(Keys::Right) ||
 				mGamePad->WasButtonPressedThisFrame(GamePadButtons::DPadRight))
 			{
-				mPlayer->Move(Player::Direction::Right);
+				mGame->Move(Simulation::Direction::Right);
 			}
 
 			if (mKeyboard->WasKeyPressedThisFrame(Keys::Space))
 			{	// Debug to test increase tail size
-				mPlayer->IncreaseTail();
+				mGame->IncreaseTail();
 			}
+
+			if (mKeyboard->WasKeyPressedThisFrame(Keys::R))
+			{	// Debug to compare CPU use with and without render-on-change
+				SetRenderOnChange(!RenderOnChange());
+			}
+
+			if (mKeyboard->WasKeyPressedThisFrame(Keys::C))
+			{	// Debug to time a device restore with and without the shader cache
+				CompareShaderLoading();
+			}
+
+#if defined(SIMULATION_PROFILING)
+			if (mKeyboard->WasKeyPressedThisFrame(Keys::P))
+			{	// Debug to capture a profile; the second press writes it out
+				ToggleProfiling();
+			}
+#endif
 		});
 	}
 
@@ -144,6 +217,26 @@ namespace DirectXGame
 			return false;
 		}
 
+		SIMULATION_PROFILE_ZONE("GameMain::Render");
+		bool changed = false;
+		if (mFrameSkipper.Enabled())
+		{
+			for (DrawableGameComponent* component : mComponents.RenderList())
+			{
+				if (component->VisualStateChanged())
+				{
+					changed = true;
+					break;
+				}
+			}
+		}
+		if (!mFrameSkipper.ShouldRender(changed))
+		{
+			return false;
+		}
+
+		Simulation::RenderStats::GetInstance().BeginFrame();
+
 		auto context = mDeviceResources->GetD3DDeviceContext();
 
 		// Reset the viewport to target the whole screen.
@@ -158,41 +251,213 @@ namespace DirectXGame
 		context->ClearRenderTargetView(mDeviceResources->GetBackBufferRenderTargetView(), DirectX::Colors::Black);
 		context->ClearDepthStencilView(mDeviceResources->GetDepthStencilView(), D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
 
-		for (auto& component : mComponents)
+		// Components that record through the render backend do so on worker threads while
+		// the others render here. Each replays its commands at its turn in the queue, so the
+		// frame comes out the same whichever thread recorded it.
+		const vector<DrawableGameComponent*>& renderList = mComponents.RenderList();
+		for (DrawableGameComponent* component : renderList)
+		{
+			if (component->RecordsInParallel())
+			{
+				const uint32_t slot = mCommandRecorder->Add([this, component](Simulation::RenderBackend& backend) {
+					SIMULATION_PROFILE_ZONE(typeid(*component).name());
+					component->Record(mTimer, backend);
+				});
+				mRenderQueue->SubmitOpaque(0, [this, slot]() {
+					mCommandRecorder->Replay(slot, *mRenderBackend);
+				});
+			}
+		}
+		mCommandRecorder->Start();
+
+		for (DrawableGameComponent* component : renderList)
 		{
-			auto drawableComponent = dynamic_pointer_cast<DrawableGameComponent>(component);
-			if (drawableComponent != nullptr && drawableComponent->Visible())
+			if (!component->RecordsInParallel())
 			{
-				drawableComponent->Render(mTimer);
+				SIMULATION_PROFILE_ZONE(typeid(*component).name());
+				component->Render(mTimer);
 			}
 		}
-		SixteenSegmentManager::GetInstance()->DisplayString(mTimer, "Super Snake X", -300, -450);
+		mCommandRecorder->Wait();
+
+		// The components only queued their draws; this sorts and issues them.
+		{
+			SIMULATION_PROFILE_ZONE("RenderQueue::Execute");
+			mRenderQueue->Execute();
+		}
+		mCommandRecorder->Clear();
 
 		return true;
 	}
 
+	bool GameMain::RenderOnChange() const
+	{
+		return mFrameSkipper.Enabled();
+	}
+
+	void GameMain::SetRenderOnChange(bool enabled)
+	{
+		mFrameSkipper.SetEnabled(enabled);
+	}
+
 	// Notifies renderers that device resources need to be released.
 	void GameMain::OnDeviceLost()
 	{
-		for (auto& component : mComponents)
+		for (auto& component : mComponents.All())
 		{
 			component->ReleaseDeviceDependentResources();
 		}
+		mRenderBackend->ReleaseDeviceDependentResources();
+		mRenderQueue->ReleaseDeviceDependentResources();
+		ShaderCache::GetInstance()->ReleaseDeviceDependentResources();
+		ShaderCache::GetInstance()->ResetStatistics();
 	}
 
 	// Notifies renderers that device resources may now be recreated.
 	void GameMain::OnDeviceRestored()
 	{
-		IntializeResources();
+		IntializeResources(L"Device restore");
 	}
 
-	void GameMain::IntializeResources()
+	task<wstring> GameMain::IntializeResources(const wchar_t* phase)
 	{
-		for (auto& component : mComponents)
+		SIMULATION_PROFILE_ZONE("GameMain::CreateDeviceDependentResources");
+		const auto start = chrono::steady_clock::now();
+		auto shaderCache = ShaderCache::GetInstance();
+
+		mRenderBackend->CreateDeviceDependentResources();
+		for (auto& component : mComponents.All())
 		{
+			SIMULATION_PROFILE_ZONE(typeid(*component).name());
 			component->CreateDeviceDependentResources();
 		}
 
 		CreateWindowSizeDependentResources();
+
+		// Logs how long the shared shaders took to become ready and how much work the cache
+		// saved, and hands the line back.
+		const wstring label(phase);
+		return shaderCache->WhenLoaded().then([shaderCache, start, label]() {
+			const double milliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+			const ShaderCache::Statistics statistics = shaderCache->GetStatistics();
+			const wstring message = label + L": shaders ready in " + to_wstring(milliseconds) + L" ms; " +
+				to_wstring(statistics.FileReads) + L" file reads, " +
+				to_wstring(statistics.ShadersCreated) + L" shaders, " +
+				to_wstring(statistics.InputLayoutsCreated) + L" input layouts, " +
+				to_wstring(statistics.ConstantBuffersCreated) + L" constant buffers created, " +
+				to_wstring(statistics.CacheHits) + L" cache hits\n";
+			OutputDebugStringW(message.c_str());
+			return message;
+		});
+	}
+
+	// Reloads every device resource as a device restore would, first with the shader cache
+	// off, the way each component loaded its own shaders before there was one, and then on.
+	// ContinueShaderComparison() moves on once each pass has loaded.
+	void GameMain::CompareShaderLoading()
+	{
+		if (mShaderComparison != ShaderComparison::Idle)
+		{
+			return;
+		}
+
+		OnDeviceLost();
+		ShaderCache::GetInstance()->SetEnabled(false);
+		mShaderComparisonLoad = IntializeResources(L"Device restore without cache");
+		mShaderComparison = ShaderComparison::Uncached;
+	}
+
+	// Starts the cached pass once the uncached one has loaded, and logs the two side by side
+	// once that has too.
+	void GameMain::ContinueShaderComparison()
+	{
+		if (mShaderComparison == ShaderComparison::Idle || !mShaderComparisonLoad.is_done())
+		{
+			return;
+		}
+
+		if (mShaderComparison == ShaderComparison::Uncached)
+		{
+			mUncachedShaderLoad = mShaderComparisonLoad.get();
+			OnDeviceLost();
+			ShaderCache::GetInstance()->SetEnabled(true);
+			mShaderComparisonLoad = IntializeResources(L"Device restore with cache");
+			mShaderComparison = ShaderComparison::Cached;
+			return;
+		}
+
+		const wstring message = L"Shader cache, before and after:\n  " + mUncachedShaderLoad + L"  " + mShaderComparisonLoad.get();
+		OutputDebugStringW(message.c_str());
+		mShaderComparison = ShaderComparison::Idle;
+	}
+
+	// The last session's inputs go to the app's local folder; ReplayPlayer plays them back.
+	void GameMain::SaveReplay() const
+	{
+		const wstring path = wstring(ApplicationData::Current->LocalFolder->Path->Data()) + L"\\Last.replay";
+		ofstream file(path, ios::binary);
+		mRecorder->Write(file, mGame->StepCount());
+	}
+
+	// Replaces the live game with a playback of Last.replay. The player component stops
+	// advancing the game, and the recording stops so the saved session isn't overwritten.
+	void GameMain::StartPlayback()
+	{
+		const wstring path = wstring(ApplicationData::Current->LocalFolder->Path->Data()) + L"\\Last.replay";
+		ifstream file(path, ios::binary);
+		if (!Simulation::ReplayReader::Read(file, mReplayImage))
+		{
+			return;
+		}
+
+		// The reader points into mReplayImage, which is left alone from here on.
+		const Simulation::ReplayReader replay(mReplayImage.data(), mReplayImage.size());
+		if (!replay.IsValid())
+		{
+			return;
+		}
+
+		mReplayPlayer = make_shared<Simulation::ReplayPlayer>(replay);
+		mPlayer->SetEnabled(false);
+		mGame->SetRecorder(nullptr);
+		mGame->Restore(mReplayPlayer->GetGame().State());
+	}
+
+	// Starts recording profile zones, or stops and writes the recording to Trace.json in the
+	// app's local folder, to open in chrome://tracing.
+	void GameMain::ToggleProfiling()
+	{
+		Simulation::Profiler& profiler = Simulation::Profiler::GetInstance();
+		if (!profiler.Enabled())
+		{
+			profiler.Clear();
+			profiler.SetEnabled(true);
+			return;
+		}
+
+		profiler.SetEnabled(false);
+		const wstring path = wstring(ApplicationData::Current->LocalFolder->Path->Data()) + L"\\Trace.json";
+		ofstream file(path, ios::binary);
+		profiler.WriteChromeTrace(file);
+	}
+
+	// Charges the loop's CPU time since the last call to the current second, and logs each
+	// second while rendering on change.
+	void GameMain::MeasureCpuTime()
+	{
+		const double cpuSeconds = Simulation::FrameSkipper::ThreadCpuSeconds();
+		const auto now = chrono::steady_clock::now();
+		const bool secondElapsed = mFrameSkipper.AddTime(cpuSeconds - mLastCpuSeconds, chrono::duration<double>(now - mLastMeasurement).count());
+		mLastCpuSeconds = cpuSeconds;
+		mLastMeasurement = now;
+
+		if (secondElapsed && mFrameSkipper.Enabled())
+		{
+			const Simulation::FrameSkipper::Counters& counters = mFrameSkipper.GetCounters();
+			const wstring message = L"Render on change: " + to_wstring(counters.RenderedFrames) + L" frames rendered, " +
+				to_wstring(counters.SkippedFrames) + L" skipped, " +
+				to_wstring(1000.0 * mFrameSkipper.CpuSecondsPerSecond()) + L" ms CPU per second\n";
+			OutputDebugStringW(message.c_str());
+		}
 	}
 }
\ No newline at end of file
@@ -1,21 +1,39 @@
 ﻿#pragma once
 
 #include "StepTimer.h"
+#include "ComponentRegistry.h"
 #include "DeviceResources.h"
+#include "FrameSkipper.h"
+#include <chrono>
+#include <string>
 #include <vector>
 #include <memory>
+#include <ppltasks.h>
 
 namespace DX
 {
+	class D3D11RenderBackend;
+	class D3D11RenderQueue;
 	class GameComponent;
 	class MouseComponent;
 	class KeyboardComponent;
 	class GamePadComponent;
 }
 
+namespace Simulation
+{
+	class Game;
+	class JobSystem;
+	class ParallelRecorder;
+	class ReplayPlayer;
+	class ReplayRecorder;
+}
+
 // Renders Direct2D and 3D content on the screen.
 namespace DirectXGame
 {
+	class Player;
+
 	class GameMain : public DX::IDeviceNotify
 	{
 	public:
@@ -25,18 +43,48 @@ namespace DirectXGame
 		void Update();
 		bool Render();
 
+		// When on, Render() skips frames in which no component's visual state changed; the
+		// last frame presented stays on screen.
+		bool RenderOnChange() const;
+		void SetRenderOnChange(bool enabled);
+
 		virtual void OnDeviceLost();
 		virtual void OnDeviceRestored();
 
 	private:
-		void IntializeResources();
+		enum class ShaderComparison
+		{
+			Idle, Uncached, Cached
+		};
+
+		Concurrency::task<std::wstring> IntializeResources(const wchar_t* phase);
+		void CompareShaderLoading();
+		void ContinueShaderComparison();
+		void SaveReplay() const;
+		void StartPlayback();
+		void ToggleProfiling();
+		void MeasureCpuTime();
 
 		std::shared_ptr<DX::DeviceResources> mDeviceResources;
-		std::vector<std::shared_ptr<DX::GameComponent>> mComponents;
+		std::shared_ptr<DX::D3D11RenderBackend> mRenderBackend;
+		std::shared_ptr<DX::D3D11RenderQueue> mRenderQueue;
+		std::shared_ptr<Simulation::ParallelRecorder> mCommandRecorder;
+		std::shared_ptr<Simulation::JobSystem> mJobSystem;
+		DX::ComponentRegistry mComponents;
 		DX::StepTimer mTimer;
+		Simulation::FrameSkipper mFrameSkipper;
+		double mLastCpuSeconds;
+		std::chrono::steady_clock::time_point mLastMeasurement;
 		std::shared_ptr<DX::KeyboardComponent> mKeyboard;
 		std::shared_ptr<DX::MouseComponent> mMouse;
 		std::shared_ptr<DX::GamePadComponent> mGamePad;
+		std::shared_ptr<Simulation::Game> mGame;
+		std::shared_ptr<Simulation::ReplayRecorder> mRecorder;
 		std::shared_ptr<Player> mPlayer;
+		std::vector<std::uint8_t> mReplayImage;
+		std::shared_ptr<Simulation::ReplayPlayer> mReplayPlayer;
+		ShaderComparison mShaderComparison;
+		Concurrency::task<std::wstring> mShaderComparisonLoad;
+		std::wstring mUncachedShaderLoad;
 	};
 }
\ No newline at end of file
@@ -1,92 +1,84 @@
 #include "pch.h"
 #include "Player.h"
+#include "ShaderCache.h"
 #include "SixteenSegmentManager.h"
-#include "PowerupManager.h"
+#include "Game.h"
+#include "RenderStats.h"
+#include <cstring>
 
 
 using namespace std;
 using namespace DirectX;
 using namespace SimpleMath;
 using namespace DX;
+using namespace Microsoft::WRL;
 
 namespace DirectXGame
 {
-	Player::Player(const shared_ptr<DX::DeviceResources>& deviceResources, const shared_ptr<Camera>& camera) :
+	const XMFLOAT4 Player::BodyColor(0.0f, 1.0f, 1.0f, 1.0f);
+
+	Player::Player(const shared_ptr<DX::DeviceResources>& deviceResources, const shared_ptr<Camera>& camera, const shared_ptr<Simulation::Game>& game) :
 		DrawableGameComponent(deviceResources, camera),
-		mPosition(0, 0), mTail(0), mVelocity(0, 0),
-		mIndexCount(0), mLoadingComplete(false), mTimeSinceUpdate(0.0f),
-		mDirection(Direction::Stop), mAlive(true), mGameSpeed(0.25f), mDirectionLocked(false)
+		mGeometryBinding(), mConstantBinding(), mGame(game), mIndexCount(0), mDrawnStepCount(UINT64_MAX), mDrawnBlend(1.0f), mUploadedConstants(), mConstantsUploaded(false), mLoadingComplete(false)
 	{
-		mTail.clear();
 	}
 
 	void Player::CreateDeviceDependentResources()
 	{
-		auto loadVSTask = ReadDataAsync(L"ShapeRendererVS.cso");
-		auto loadPSTask = ReadDataAsync(L"ShapeRendererPS.cso");
-
-		// After the vertex shader file is loaded, create the shader and input layout.
-		auto createVSTask = loadVSTask.then([this](const vector<byte>& fileData) {
-			ThrowIfFailed(
-				mDeviceResources->GetD3DDevice()->CreateVertexShader(
-					&fileData[0],
-					fileData.size(),
-					nullptr,
-					mVertexShader.ReleaseAndGetAddressOf()
-				)
-			);
-
-			// Create an input layout
-			ThrowIfFailed(
-				mDeviceResources->GetD3DDevice()->CreateInputLayout(
-					VertexPosition::InputElements,
-					VertexPosition::InputElementCount,
-					&fileData[0],
-					fileData.size(),
-					mInputLayout.ReleaseAndGetAddressOf()
-				)
-			);
-
-			CD3D11_BUFFER_DESC constantBufferDesc(sizeof(XMFLOAT4X4), D3D11_BIND_CONSTANT_BUFFER);
-			ThrowIfFailed(
-				mDeviceResources->GetD3DDevice()->CreateBuffer(
-					&constantBufferDesc,
-					nullptr,
-					mVSCBufferPerObject.ReleaseAndGetAddressOf()
-				)
-			);
+		auto shaderCache = ShaderCache::GetInstance();
+		auto createVSTask = shaderCache->LoadVertexShaderAsync(L"SnakeBodyVS.cso").then([this](const ComPtr<ID3D11VertexShader>& vertexShader) {
+			mVertexShader = vertexShader;
+		});
+
+		auto createInputLayoutTask = shaderCache->LoadInputLayoutAsync(L"SnakeBodyVS.cso", VertexPositionColorInstanceMotion::InputElements, VertexPositionColorInstanceMotion::InputElementCount).then([this](const ComPtr<ID3D11InputLayout>& inputLayout) {
+			mInputLayout = inputLayout;
 		});
 
-		// After the pixel shader file is loaded, create the shader and constant buffer.
-		auto createPSTask = loadPSTask.then([this](const vector<byte>& fileData) {
-			ThrowIfFailed(
-				mDeviceResources->GetD3DDevice()->CreatePixelShader(
-					&fileData[0],
-					fileData.size(),
-					nullptr,
-					mPixelShader.ReleaseAndGetAddressOf()
-				)
-			);
-
-			CD3D11_BUFFER_DESC constantBufferDesc(sizeof(XMFLOAT4), D3D11_BIND_CONSTANT_BUFFER);
-			ThrowIfFailed(
-				mDeviceResources->GetD3DDevice()->CreateBuffer(
-					&constantBufferDesc,
-					nullptr,
-					mPSCBufferPerObject.ReleaseAndGetAddressOf()
-				)
-			);
+		auto createPSTask = shaderCache->LoadPixelShaderAsync(L"ColorShapeRendererPS.cso").then([this](const ComPtr<ID3D11PixelShader>& pixelShader) {
+			mPixelShader = pixelShader;
 		});
 
-		(createPSTask && createVSTask).then([this]() {
-			// Create a vertex buffer for rendering a box
+		// Not the cache's shared matrix buffer: the draw is queued, and others may rewrite
+		// that one before the queue runs.
+		CD3D11_BUFFER_DESC constantBufferDesc(sizeof(Constants), D3D11_BIND_CONSTANT_BUFFER);
+		ThrowIfFailed(mDeviceResources->GetD3DDevice()->CreateBuffer(&constantBufferDesc, nullptr, mVSCBufferPerObject.ReleaseAndGetAddressOf()));
+		mConstantsUploaded = false;
+
+		(createPSTask && createVSTask && createInputLayoutTask).then([this]() {
+			// Create a vertex buffer for one body square at the origin; each instance offsets it to its cell
+			const float size = static_cast<float>(BodySize);
+			VertexPositionColorInstanceMotion vertices[] =
+			{
+				// Upper-Left
+				VertexPositionColorInstanceMotion(XMFLOAT4(1.0f, size - 1.0f, 0.0f, 1.0f), BodyColor),
+
+				// Upper-Right
+				VertexPositionColorInstanceMotion(XMFLOAT4(size - 1.0f, size - 1.0f, 0.0f, 1.0f), BodyColor),
+
+				// Lower-Left
+				VertexPositionColorInstanceMotion(XMFLOAT4(1.0f, 1.0f, 0.0f, 1.0f), BodyColor),
+
+				// Lower-Right
+				VertexPositionColorInstanceMotion(XMFLOAT4(size - 1.0f, 1.0f, 0.0f, 1.0f), BodyColor),
+			};
+
 			D3D11_BUFFER_DESC vertexBufferDesc = { 0 };
-			const uint32_t boxVertexCount = 4;
-			vertexBufferDesc.ByteWidth = sizeof(VertexPosition) * boxVertexCount;
-			vertexBufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+			vertexBufferDesc.ByteWidth = sizeof(vertices);
+			vertexBufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
 			vertexBufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-			vertexBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-			ThrowIfFailed(mDeviceResources->GetD3DDevice()->CreateBuffer(&vertexBufferDesc, nullptr, mVertexBuffer.ReleaseAndGetAddressOf()));
+
+			D3D11_SUBRESOURCE_DATA vertexSubResourceData = { 0 };
+			vertexSubResourceData.pSysMem = vertices;
+			ThrowIfFailed(mDeviceResources->GetD3DDevice()->CreateBuffer(&vertexBufferDesc, &vertexSubResourceData, mVertexBuffer.ReleaseAndGetAddressOf()));
+
+			// Create an instance buffer large enough for the longest snake
+			D3D11_BUFFER_DESC instanceBufferDesc = { 0 };
+			instanceBufferDesc.ByteWidth = sizeof(Simulation::SnakeInstances::Instance) * Simulation::SnakeInstances::MaxCount;
+			instanceBufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+			instanceBufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+			instanceBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+			ThrowIfFailed(mDeviceResources->GetD3DDevice()->CreateBuffer(&instanceBufferDesc, nullptr, mInstanceBuffer.ReleaseAndGetAddressOf()));
+			mInstances.Invalidate();
 
 			// Create an index buffer for the box (line strip)
 			uint32_t indices[] =
@@ -104,6 +96,15 @@ namespace DirectXGame
 			D3D11_SUBRESOURCE_DATA indexSubResourceData = { 0 };
 			indexSubResourceData.pSysMem = indices;
 			ThrowIfFailed(mDeviceResources->GetD3DDevice()->CreateBuffer(&indexBufferDesc, &indexSubResourceData, mIndexBuffer.ReleaseAndGetAddressOf()));
+
+			mGeometryBinding.VertexBuffers[0] = mVertexBuffer.Get();
+			mGeometryBinding.VertexBuffers[1] = mInstanceBuffer.Get();
+			mGeometryBinding.Strides[0] = sizeof(VertexPositionColorInstanceMotion);
+			mGeometryBinding.Strides[1] = sizeof(Simulation::SnakeInstances::Instance);
+			mGeometryBinding.VertexBufferCount = 2;
+			mGeometryBinding.IndexBuffer = mIndexBuffer.Get();
+			mGeometryBinding.IndexFormat = DXGI_FORMAT_R32_UINT;
+			mConstantBinding.VertexShader = mVSCBufferPerObject.Get();
 			mLoadingComplete = true;
 		});
 	}
@@ -115,24 +116,31 @@ namespace DirectXGame
 		mPixelShader.Reset();
 		mInputLayout.Reset();
 		mVertexBuffer.Reset();
-		mVertexBuffer.Reset();
+		mIndexBuffer.Reset();
+		mInstanceBuffer.Reset();
 		mVSCBufferPerObject.Reset();
-		mPSCBufferPerObject.Reset();
+	}
+
+	// The game advances here rather than in Render(), so it keeps time on frames that are
+	// not drawn and ticks as often as its speed asks, however many ticks fall in a frame.
+	void Player::Update(const DX::StepTimer& timer)
+	{
+		mGame->Update(timer.GetElapsedSeconds());
+	}
+
+	bool Player::DeclareUpdateAccess(Simulation::TaskGraph::Access& access) const
+	{
+		access.Writes.push_back(mGame.get());
+		return true;
 	}
 
 	void Player::Render(const DX::StepTimer & timer)
 	{
-		mTimeSinceUpdate += timer.GetElapsedSeconds();
+		mDrawnStepCount = mGame->StepCount();
+		mDrawnBlend = Blend();
 
-		if (mTimeSinceUpdate >= mGameSpeed && mAlive)
-		{
-			mPosition += mVelocity;
-			mTimeSinceUpdate = 0.0f;
-			UpdateTail();
-			mDirectionLocked = false;
-			HandleCollisions();
-		}	
-		else if (!mAlive)
+		const Simulation::Snake& snake = mGame->GetSnake();
+		if (!snake.Alive())
 		{
 			SixteenSegmentManager::GetInstance()->DisplayString(timer, "Game Over", -225, 50);
 			SixteenSegmentManager::GetInstance()->DisplayString(timer, "Press Start to Continue", -550, -100);
@@ -145,198 +153,67 @@ namespace DirectXGame
 		}
 
 		ID3D11DeviceContext* direct3DDeviceContext = mDeviceResources->GetD3DDeviceContext();
-		direct3DDeviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
-		direct3DDeviceContext->IASetInputLayout(mInputLayout.Get());
-
-		static const UINT stride = sizeof(VertexPosition);
-		static const UINT offset = 0;
-		direct3DDeviceContext->IASetVertexBuffers(0, 1, mVertexBuffer.GetAddressOf(), &stride, &offset);
-		direct3DDeviceContext->IASetIndexBuffer(mIndexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
-
-		direct3DDeviceContext->VSSetShader(mVertexShader.Get(), nullptr, 0);
-		direct3DDeviceContext->PSSetShader(mPixelShader.Get(), nullptr, 0);
+		Simulation::RenderStats& stats = Simulation::RenderStats::GetInstance();
 
-		const XMMATRIX wvp = XMMatrixTranspose(mCamera->ViewProjectionMatrix());
-		direct3DDeviceContext->UpdateSubresource(mVSCBufferPerObject.Get(), 0, nullptr, reinterpret_cast<const float*>(wvp.r), 0, 0);
-		direct3DDeviceContext->VSSetConstantBuffers(0, 1, mVSCBufferPerObject.GetAddressOf());
-		direct3DDeviceContext->PSSetConstantBuffers(0, 1, mPSCBufferPerObject.GetAddressOf());
-
-		RenderSquare(mPosition);
-		for (auto position : mTail)
+		// Segment positions change only on simulation ticks. Between them the vertex shader
+		// glides each segment along by the blend, so a frame costs a constant buffer update.
+		if (mInstances.Update(*mGame))
 		{
-			RenderSquare(position);
+			D3D11_MAPPED_SUBRESOURCE mappedSubResource;
+			ThrowIfFailed(direct3DDeviceContext->Map(mInstanceBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubResource));
+			memcpy(mappedSubResource.pData, mInstances.Data(), mInstances.ByteCount());
+			direct3DDeviceContext->Unmap(mInstanceBuffer.Get(), 0);
+			stats.RecordUpload(mInstances.ByteCount());
 		}
-	}
 
-	void Player::Move(Direction direction)
-	{
-		switch (direction)
+		Constants constants = {};
+		constants.ViewProjection = ViewProjection();
+		constants.Blend = mDrawnBlend;
+		if (!mConstantsUploaded || memcmp(&constants, &mUploadedConstants, sizeof(constants)) != 0)
 		{
-		case Up:
-			if (!mDirectionLocked && mDirection == Direction::Left || mDirection == Direction::Right || mDirection == Direction::Stop &&
-				(mTail.size() == 0 || !(mTail[0].x == mPosition.x && mTail[0].y == mPosition.y + BodySize)))
-			{
-				mVelocity = Vector2f(0.0f, static_cast<float>(BodySize));
-				mDirection = Direction::Up;
-			}
-			break;
-		case Down:
-			if (!mDirectionLocked && mDirection == Direction::Left || mDirection == Direction::Right || mDirection == Direction::Stop &&
-				(mTail.size() == 0 || !(mTail[0].x == mPosition.x && mTail[0].y == mPosition.y - BodySize)))
-			{
-				mVelocity = Vector2f(0.0f, -static_cast<float>(BodySize));
-				mDirection = Direction::Down;
-			}
-			break;
-		case Left:
-			if (!mDirectionLocked && mDirection == Direction::Up || mDirection == Direction::Down || mDirection == Direction::Stop &&
-				(mTail.size() == 0 || !(mTail[0].x == mPosition.x - BodySize && mTail[0].y == mPosition.y)))
-			{
-				mVelocity = Vector2f(-static_cast<float>(BodySize), 0);
-				mDirection = Direction::Left;
-			}
-			break;
-		case Right:
-			if (!mDirectionLocked && mDirection == Direction::Up || mDirection == Direction::Down || mDirection == Direction::Stop &&
-				(mTail.size() == 0 || !(mTail[0].x == mPosition.x + BodySize && mTail[0].y == mPosition.y)))
-			{
-				mVelocity = Vector2f(static_cast<float>(BodySize), 0);
-				mDirection = Direction::Right;
-			}
-			break;
-		default:
-			break;
+			direct3DDeviceContext->UpdateSubresource(mVSCBufferPerObject.Get(), 0, nullptr, &constants, 0, 0);
+			stats.RecordConstantBufferUpload(sizeof(constants));
+			mUploadedConstants = constants;
+			mConstantsUploaded = true;
 		}
-		mDirectionLocked = true;
-	}
-
-	void Player::UpdateTail()
-	{ 
-		if (mTail.size() <= 0) return;
-
-		Vector2f lastCoord = mTail[0];
-		Vector2f last2Coord;
-		mTail[0] = mPosition;
 
-		for (uint32_t i = 1; i < mTail.size(); i++)
-		{
-			last2Coord = mTail[i];
-			mTail[i] = lastCoord;
-			lastCoord = last2Coord;
-		}
+		D3D11RenderQueue::DrawItem item = {};
+		item.VertexShader = mVertexShader.Get();
+		item.PixelShader = mPixelShader.Get();
+		item.InputLayout = mInputLayout.Get();
+		item.Topology = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP;
+		item.Geometry = &mGeometryBinding;
+		item.Constants = &mConstantBinding;
+		item.IndexCount = mIndexCount;
+		item.InstanceCount = mInstances.Count();
+		D3D11RenderQueue::GetInstance()->Submit(item);
 	}
 
-	void Player::IncreaseTail()
+	bool Player::VisualStateChanged() const
 	{
-		for (uint32_t i = 0; i < 10; i++)
+		if (mGame->StepCount() != mDrawnStepCount || Blend() != mDrawnBlend)
 		{
-			mTail.push_back(Vector2f(-5000, -5000));
+			return true;
+		}
+		if (!mLoadingComplete)
+		{
+			return false;
 		}
-		mGameSpeed -= 0.005f;
-	}
-
-	uint32_t Player::GetTailSize()
-	{
-		return static_cast<uint32_t>(mTail.size());
-	}
-
-	Vector2f Player::GetTailAt(uint32_t index)
-	{
-		return mTail[index];
-	}
 
-	bool Player::Alive()
-	{
-		return mAlive;
+		const XMFLOAT4X4 viewProjection = ViewProjection();
+		return !mConstantsUploaded || memcmp(&viewProjection, &mUploadedConstants.ViewProjection, sizeof(viewProjection)) != 0;
 	}
 
-	void Player::Kill()
-	{
-		mAlive = !mAlive;
-	}
-	void Player::Respawn()
+	XMFLOAT4X4 Player::ViewProjection() const
 	{
-		mPosition = Vector2f(0, 0);
-		mDirection = Direction::Stop;
+		XMFLOAT4X4 viewProjection;
+		XMStoreFloat4x4(&viewProjection, XMMatrixTranspose(mCamera->ViewProjectionMatrix()));
+		return viewProjection;
 	}
 
-	void Player::RenderSquare(Vector2f position)
+	float Player::Blend() const
 	{
-		ID3D11DeviceContext* direct3DDeviceContext = mDeviceResources->GetD3DDeviceContext();
-
-		VertexPosition vertices[] =
-		{
-			// Upper-Left
-			VertexPosition(XMFLOAT4(position.x + 1, position.y + BodySize - 1, 0.0f, 1.0f)),
-
-			// Upper-Right
-			VertexPosition(XMFLOAT4(position.x + BodySize - 1, position.y + BodySize - 1, 0.0f, 1.0f)),
-
-			// Lower-Left
-			VertexPosition(XMFLOAT4(position.x + 1, position.y + 1, 0.0f, 1.0f)),
-
-			// Lower-Right
-			VertexPosition(XMFLOAT4(position.x + BodySize - 1, position.y + 1, 0.0f, 1.0f)),
-		};
-
-		XMFLOAT4 color(0.0f, 1.0f, 1.0f, 1.0f); // temp color to test rendering
-
-		uint32_t vertexCount = ARRAYSIZE(vertices);
-		D3D11_MAPPED_SUBRESOURCE mappedSubResource;
-		direct3DDeviceContext->Map(mVertexBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, NULL, &mappedSubResource);
-		memcpy(mappedSubResource.pData, vertices, sizeof(VertexPosition) * vertexCount);
-		direct3DDeviceContext->Unmap(mVertexBuffer.Get(), 0);
-		direct3DDeviceContext->UpdateSubresource(mPSCBufferPerObject.Get(), 0, nullptr, &color, 0, 0);
-		direct3DDeviceContext->DrawIndexed(mIndexCount, 0, 0);
+		const Simulation::Snake& snake = mGame->GetSnake();
+		return snake.Alive() && snake.CurrentDirection() != Simulation::Direction::Stop ? mGame->TickProgress() : 1.0f;
 	}
-
-	void Player::HandleCollisions()
-	{
-		auto powerupManager = PowerupManager::GetInstance();
-
-		// Handle cherry collisions
-		if (powerupManager->GetCherryPosition() == mPosition)
-		{
-			powerupManager->RespawnCherry();
-			IncreaseTail();
-		}
-
-		// Handle coin collisions
-		if (powerupManager->GetCoinPosition() == mPosition)
-		{
-			powerupManager->RespawnCoin();
-			IncreaseTail();
-		}
-
-		// Handle boundary collisions
-		if (mPosition.x < (-27.0f * BodySize))
-		{
-			mAlive = false;
-		}
-		if (mPosition.x >= (27.0f * BodySize))
-		{
-			mAlive = false;
-		}
-		if (mPosition.y < (-13.0f * BodySize))
-		{
-			mAlive = false;
-		}
-		if (mPosition.y >= (13.0f * BodySize))
-		{
-			mAlive = false;
-		}
-
-		// Handle body collisions
-		if (mTail.size() > 0)
-		{
-			for (uint32_t i = 1; i < mTail.size(); i++)
-			{
-				if (mPosition == mTail[i])
-				{	// Player is kill
-					mAlive = false;
-				}
-			}
-		}
-	}
-
-}
+}
\ No newline at end of file
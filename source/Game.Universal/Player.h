@@ -1,42 +1,46 @@
 #pragma once
-#include <Vector>
-#include "StructDefinitions.h"
+#include "Board.h"
+#include "SnakeInstances.h"
+#include "D3D11RenderQueue.h"
+
+namespace Simulation
+{
+	class Game;
+}
 
 namespace DirectXGame
 {
 	class Player final : public DX::DrawableGameComponent
 	{
 	public:
-
-		enum Direction
-		{
-			Stop, Up, Down, Left, Right
-		};
-
-		Player(const std::shared_ptr<DX::DeviceResources>& deviceResources, const std::shared_ptr<DX::Camera>& camera);
+		Player(const std::shared_ptr<DX::DeviceResources>& deviceResources, const std::shared_ptr<DX::Camera>& camera, const std::shared_ptr<Simulation::Game>& game);
 
 		virtual void CreateDeviceDependentResources() override;
 		virtual void ReleaseDeviceDependentResources() override;
+		virtual void Update(const DX::StepTimer& timer) override;
+		virtual bool DeclareUpdateAccess(Simulation::TaskGraph::Access& access) const override;
 		virtual void Render(const DX::StepTimer& timer) override;
 
-		void Move(Direction direction);
-		void UpdateTail();
-		void IncreaseTail();
-		uint32_t GetTailSize();
-		Vector2f GetTailAt(uint32_t index);
-		void HandleCollisions();
-		bool Alive();
-		void Kill();
-		void Respawn();
+		// The snake changes on a simulation tick and, while it moves, between ticks as it is
+		// drawn gliding from one to the next; the game-over text only changes on a tick.
+		virtual bool VisualStateChanged() const override;
 
 	private:
+		// Matches SnakeBodyVS's CBufferPerObject, padded to a multiple of 16 bytes.
+		struct Constants final
+		{
+			DirectX::XMFLOAT4X4 ViewProjection;
+			float Blend;
+			float Padding[3];
+		};
 
-		// Constants
-		const uint32_t MaxLength = 1296;
-		const uint32_t BodySize = 25;
+		DirectX::XMFLOAT4X4 ViewProjection() const;
+		float Blend() const;
 
-		// Private methods
-		void RenderSquare(Vector2f position);
+
+		// Constants
+		static const DirectX::XMFLOAT4 BodyColor;
+		const uint32_t BodySize = Simulation::Board::CellSize;
 
 		// Private fields
 		Microsoft::WRL::ComPtr<ID3D11VertexShader> mVertexShader;
@@ -44,20 +48,20 @@ namespace DirectXGame
 		Microsoft::WRL::ComPtr<ID3D11InputLayout> mInputLayout;
 		Microsoft::WRL::ComPtr<ID3D11Buffer> mVertexBuffer;
 		Microsoft::WRL::ComPtr<ID3D11Buffer> mIndexBuffer;
+		Microsoft::WRL::ComPtr<ID3D11Buffer> mInstanceBuffer;
 		Microsoft::WRL::ComPtr<ID3D11Buffer> mVSCBufferPerObject;
-		Microsoft::WRL::ComPtr<ID3D11Buffer> mPSCBufferPerObject;
+		DX::D3D11RenderQueue::GeometryBinding mGeometryBinding;
+		DX::D3D11RenderQueue::ConstantBinding mConstantBinding;
 
-		Vector2f mPosition;
-		std::vector<Vector2f> mTail;
-		Vector2f mVelocity;
+		std::shared_ptr<Simulation::Game> mGame;
+		Simulation::SnakeInstances mInstances;
 		std::uint32_t mIndexCount;
+		std::uint64_t mDrawnStepCount;
+		float mDrawnBlend;
+		Constants mUploadedConstants;
+		bool mConstantsUploaded;
 		bool mLoadingComplete;
-		double mTimeSinceUpdate;
-		Direction mDirection;
-		bool mAlive;
-		float mGameSpeed;
-		bool mDirectionLocked;
 	};
 
 
-}
+}
\ No newline at end of file
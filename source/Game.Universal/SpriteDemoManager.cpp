@@ -1,5 +1,7 @@
 #include "pch.h"
 #include "SpriteDemoManager.h"
+#include "ShaderCache.h"
+#include "RenderStats.h"
 
 using namespace std;
 using namespace DX;
@@ -35,79 +37,47 @@ namespace DirectXGame
 
 	void SpriteDemoManager::CreateDeviceDependentResources()
 	{
-		auto loadVSTask = ReadDataAsync(L"SpriteRendererVS.cso");
-		auto loadPSTask = ReadDataAsync(L"SpriteRendererPS.cso");
-
-		// After the vertex shader file is loaded, create the shader and input layout.
-		auto createVSTask = loadVSTask.then([this](const std::vector<byte>& fileData) {
-			ThrowIfFailed(
-				mDeviceResources->GetD3DDevice()->CreateVertexShader(
-					&fileData[0],
-					fileData.size(),
-					nullptr,
-					mVertexShader.ReleaseAndGetAddressOf()
-				)
-			);
-
-			// Create an input layout
-			ThrowIfFailed(
-				mDeviceResources->GetD3DDevice()->CreateInputLayout(
-					VertexPositionTexture::InputElements,
-					VertexPositionTexture::InputElementCount,
-					&fileData[0],
-					fileData.size(),
-					mInputLayout.ReleaseAndGetAddressOf()
-				)
-			);
-
-			CD3D11_BUFFER_DESC constantBufferDesc(sizeof(VSCBufferPerObject), D3D11_BIND_CONSTANT_BUFFER);
-			ThrowIfFailed(
-				mDeviceResources->GetD3DDevice()->CreateBuffer(
-					&constantBufferDesc,
-					nullptr,
-					mVSCBufferPerObject.ReleaseAndGetAddressOf()
-				)
-			);
+		auto shaderCache = ShaderCache::GetInstance();
+		auto createVSTask = shaderCache->LoadVertexShaderAsync(L"SpriteRendererVS.cso").then([this](const ComPtr<ID3D11VertexShader>& vertexShader) {
+			mVertexShader = vertexShader;
 		});
 
-		// After the pixel shader file is loaded, create the shader and texture sampler state.
-		auto createPSTask = loadPSTask.then([this](const std::vector<byte>& fileData) {
-			ThrowIfFailed(
-				mDeviceResources->GetD3DDevice()->CreatePixelShader(
-					&fileData[0],
-					fileData.size(),
-					nullptr,
-					mPixelShader.ReleaseAndGetAddressOf()
-				)
-			);
-
-			D3D11_SAMPLER_DESC samplerStateDesc;
-			ZeroMemory(&samplerStateDesc, sizeof(samplerStateDesc));
-			samplerStateDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
-			samplerStateDesc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
-			samplerStateDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
-			samplerStateDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
-			samplerStateDesc.MinLOD = -FLT_MAX;
-			samplerStateDesc.MaxLOD = FLT_MAX;
-			samplerStateDesc.MipLODBias = 0.0f;
-			samplerStateDesc.MaxAnisotropy = 1;
-			samplerStateDesc.ComparisonFunc = D3D11_COMPARISON_NEVER;
-			ThrowIfFailed(mDeviceResources->GetD3DDevice()->CreateSamplerState(&samplerStateDesc, mTextureSampler.ReleaseAndGetAddressOf()));
-
-			D3D11_BLEND_DESC blendStateDesc = { 0 };
-			blendStateDesc.RenderTarget[0].BlendEnable = true;
-			blendStateDesc.RenderTarget[0].SrcBlend = D3D11_BLEND_SRC_ALPHA;
-			blendStateDesc.RenderTarget[0].DestBlend = D3D11_BLEND_INV_SRC_ALPHA;
-			blendStateDesc.RenderTarget[0].BlendOp = D3D11_BLEND_OP_ADD;
-			blendStateDesc.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_ZERO;
-			blendStateDesc.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_ZERO;
-			blendStateDesc.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_ADD;
-			blendStateDesc.RenderTarget[0].RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
-
-			ThrowIfFailed(mDeviceResources->GetD3DDevice()->CreateBlendState(&blendStateDesc, mAlphaBlending.ReleaseAndGetAddressOf()));
+		auto createInputLayoutTask = shaderCache->LoadInputLayoutAsync(L"SpriteRendererVS.cso", VertexPositionTexture::InputElements, VertexPositionTexture::InputElementCount).then([this](const ComPtr<ID3D11InputLayout>& inputLayout) {
+			mInputLayout = inputLayout;
 		});
 
-		auto loadSpriteSheetAndCreateSpritesTask = (createPSTask && createVSTask).then([this]() {
+		auto createPSTask = shaderCache->LoadPixelShaderAsync(L"SpriteRendererPS.cso").then([this](const ComPtr<ID3D11PixelShader>& pixelShader) {
+			mPixelShader = pixelShader;
+		});
+
+		mVSCBufferPerObject = shaderCache->GetConstantBuffer(sizeof(VSCBufferPerObject));
+
+		D3D11_SAMPLER_DESC samplerStateDesc;
+		ZeroMemory(&samplerStateDesc, sizeof(samplerStateDesc));
+		samplerStateDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+		samplerStateDesc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
+		samplerStateDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
+		samplerStateDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
+		samplerStateDesc.MinLOD = -FLT_MAX;
+		samplerStateDesc.MaxLOD = FLT_MAX;
+		samplerStateDesc.MipLODBias = 0.0f;
+		samplerStateDesc.MaxAnisotropy = 1;
+		samplerStateDesc.ComparisonFunc = D3D11_COMPARISON_NEVER;
+		ThrowIfFailed(mDeviceResources->GetD3DDevice()->CreateSamplerState(&samplerStateDesc, mTextureSampler.ReleaseAndGetAddressOf()));
+
+		D3D11_BLEND_DESC blendStateDesc = { 0 };
+		blendStateDesc.RenderTarget[0].BlendEnable = true;
+		blendStateDesc.RenderTarget[0].SrcBlend = D3D11_BLEND_SRC_ALPHA;
+		blendStateDesc.RenderTarget[0].DestBlend = D3D11_BLEND_INV_SRC_ALPHA;
+		blendStateDesc.RenderTarget[0].BlendOp = D3D11_BLEND_OP_ADD;
+		blendStateDesc.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_ZERO;
+		blendStateDesc.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_ZERO;
+		blendStateDesc.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_ADD;
+		blendStateDesc.RenderTarget[0].RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
+
+		ThrowIfFailed(mDeviceResources->GetD3DDevice()->CreateBlendState(&blendStateDesc, mAlphaBlending.ReleaseAndGetAddressOf()));
+
+		auto loadSpriteSheetAndCreateSpritesTask = (createPSTask && createVSTask && createInputLayoutTask).then([this]() {
 			ThrowIfFailed(CreateWICTextureFromFile(mDeviceResources->GetD3DDevice(), L"Content\\Textures\\snoods_default.png", nullptr, mSpriteSheet.ReleaseAndGetAddressOf()));			
 			InitializeVertices();
 			InitializeSprites();
@@ -154,6 +124,13 @@ namespace DirectXGame
 		}
 	}
 
+	// The sprites and the random generator are the manager's own.
+	bool SpriteDemoManager::DeclareUpdateAccess(Simulation::TaskGraph::Access& access) const
+	{
+		UNREFERENCED_PARAMETER(access);
+		return true;
+	}
+
 	void SpriteDemoManager::Render(const StepTimer & timer)
 	{
 		UNREFERENCED_PARAMETER(timer);
@@ -197,6 +174,10 @@ namespace DirectXGame
 		direct3DDeviceContext->UpdateSubresource(mVSCBufferPerObject.Get(), 0, nullptr, &mVSCBufferPerObjectData, 0, 0);
 
 		direct3DDeviceContext->DrawIndexed(mIndexCount, 0, 0);
+
+		Simulation::RenderStats& stats = Simulation::RenderStats::GetInstance();
+		stats.RecordConstantBufferUpload(sizeof(mVSCBufferPerObjectData));
+		stats.RecordDraw();
 	}
 
 	void SpriteDemoManager::InitializeVertices()
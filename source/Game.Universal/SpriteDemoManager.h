@@ -20,6 +20,7 @@ namespace DirectXGame
 		virtual void CreateDeviceDependentResources() override;
 		virtual void ReleaseDeviceDependentResources() override;
 		virtual void Update(const DX::StepTimer& timer) override;
+		virtual bool DeclareUpdateAccess(Simulation::TaskGraph::Access& access) const override;
 		virtual void Render(const DX::StepTimer& timer) override;
 
 		static const DirectX::XMFLOAT2 SpriteScale;
@@ -122,6 +122,13 @@ namespace DX
 		UpdateViewMatrix();
 	}
 
+	// Update() only touches the camera's own matrices.
+	bool Camera::DeclareUpdateAccess(Simulation::TaskGraph::Access& access) const
+	{
+		UNREFERENCED_PARAMETER(access);
+		return true;
+	}
+
 	void Camera::UpdateViewMatrix()
 	{
 		XMVECTOR eyePosition = XMLoadFloat3(&mPosition);
@@ -39,6 +39,7 @@ namespace DX
 		virtual void CreateDeviceDependentResources() override;
 		virtual void Reset();
 		virtual void Update(const StepTimer& timer) override;
+		virtual bool DeclareUpdateAccess(Simulation::TaskGraph::Access& access) const override;
 		virtual void UpdateViewMatrix();
 		virtual void UpdateProjectionMatrix() = 0;
 		virtual void ApplyRotation(DirectX::CXMMATRIX transform);
@@ -0,0 +1,101 @@
+#include "pch.h"
+#include "ComponentRegistry.h"
+#include "DrawableGameComponent.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cassert>
+#include <typeinfo>
+
+using namespace std;
+
+namespace DX
+{
+	ComponentRegistry::~ComponentRegistry()
+	{
+		for (auto& component : mComponents)
+		{
+			component->SetRegistry(nullptr);
+		}
+	}
+
+	void ComponentRegistry::Add(const shared_ptr<GameComponent>& component)
+	{
+		assert(component->Registry() == nullptr);
+		mComponents.push_back(component);
+		component->SetRegistry(this);
+		mUpdateList.Add(component.get(), component->Enabled());
+
+		// The only cast a component ever gets.
+		auto drawableComponent = dynamic_cast<DrawableGameComponent*>(component.get());
+		if (drawableComponent != nullptr)
+		{
+			mRenderList.Add(drawableComponent, drawableComponent->Visible());
+		}
+	}
+
+	void ComponentRegistry::Remove(const shared_ptr<GameComponent>& component)
+	{
+		auto found = find(mComponents.begin(), mComponents.end(), component);
+		if (found == mComponents.end())
+		{
+			return;
+		}
+
+		mUpdateList.Remove(component.get());
+		mRenderList.Remove(dynamic_cast<const DrawableGameComponent*>(component.get()));
+		component->SetRegistry(nullptr);
+		mComponents.erase(found);
+	}
+
+	const vector<shared_ptr<GameComponent>>& ComponentRegistry::All() const
+	{
+		return mComponents;
+	}
+
+	const vector<GameComponent*>& ComponentRegistry::UpdateList()
+	{
+		return mUpdateList.Active();
+	}
+
+	const vector<DrawableGameComponent*>& ComponentRegistry::RenderList()
+	{
+		return mRenderList.Active();
+	}
+
+	// Each component's update is a profile zone named for its type, on whichever thread ran it.
+	void ComponentRegistry::Update(const StepTimer& timer, Simulation::JobSystem& jobs)
+	{
+		for (GameComponent* component : mUpdateList.Active())
+		{
+			Simulation::TaskGraph::Access access;
+			if (component->DeclareUpdateAccess(access))
+			{
+				access.Writes.push_back(component);
+				mUpdateGraph.Add([component, &timer]() {
+					SIMULATION_PROFILE_ZONE(typeid(*component).name());
+					component->Update(timer);
+				}, access);
+			}
+			else
+			{
+				mUpdateGraph.AddExclusive([component, &timer]() {
+					SIMULATION_PROFILE_ZONE(typeid(*component).name());
+					component->Update(timer);
+				});
+			}
+		}
+
+		mUpdateGraph.Run(jobs);
+		mUpdateGraph.Clear();
+	}
+
+	void ComponentRegistry::EnabledChanged(const GameComponent& component)
+	{
+		mUpdateList.SetActive(&component, component.Enabled());
+	}
+
+	void ComponentRegistry::VisibleChanged(const DrawableGameComponent& component)
+	{
+		mRenderList.SetActive(&component, component.Visible());
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "ComponentList.h"
+#include "TaskGraph.h"
+#include <memory>
+#include <vector>
+
+namespace DX
+{
+	class GameComponent;
+	class DrawableGameComponent;
+	class StepTimer;
+
+	// Owns the game's components and sorts them out once, when they are added: every
+	// component goes on the update list and drawable ones on the render list too. The lists
+	// hand out only the enabled and the visible components, in the order they were added,
+	// and components tell the registry when they are enabled, disabled, shown or hidden, so
+	// nothing is cast or skipped frame after frame.
+	class ComponentRegistry final
+	{
+	public:
+		ComponentRegistry() = default;
+		ComponentRegistry(const ComponentRegistry&) = delete;
+		ComponentRegistry& operator=(const ComponentRegistry&) = delete;
+		ComponentRegistry(ComponentRegistry&&) = delete;
+		ComponentRegistry& operator=(ComponentRegistry&&) = delete;
+		~ComponentRegistry();
+
+		void Add(const std::shared_ptr<GameComponent>& component);
+		void Remove(const std::shared_ptr<GameComponent>& component);
+
+		// Every component, enabled or not, for device and window events.
+		const std::vector<std::shared_ptr<GameComponent>>& All() const;
+
+		const std::vector<GameComponent*>& UpdateList();
+		const std::vector<DrawableGameComponent*>& RenderList();
+
+		// Updates the update list in order, except that components declaring what they touch
+		// run on the job system alongside any others they don't conflict with.
+		void Update(const StepTimer& timer, Simulation::JobSystem& jobs);
+
+		// Called by the components' SetEnabled() and SetVisible().
+		void EnabledChanged(const GameComponent& component);
+		void VisibleChanged(const DrawableGameComponent& component);
+
+	private:
+		std::vector<std::shared_ptr<GameComponent>> mComponents;
+		Simulation::ComponentList<GameComponent> mUpdateList;
+		Simulation::ComponentList<DrawableGameComponent> mRenderList;
+		Simulation::TaskGraph mUpdateGraph;
+	};
+}
@@ -0,0 +1,360 @@
+#include "pch.h"
+#include "D3D11RenderBackend.h"
+#include "ShaderCache.h"
+#include "RenderStats.h"
+#include "VertexDeclarations.h"
+#include <cstring>
+
+using namespace std;
+using namespace DirectX;
+using namespace Microsoft::WRL;
+using namespace Simulation;
+
+namespace DX
+{
+	const uint32_t D3D11RenderBackend::VertexCapacity = 16384;
+	const uint32_t D3D11RenderBackend::IndexCapacity = 24576;
+
+	namespace
+	{
+		static_assert(sizeof(ColorVertex) == sizeof(VertexPositionColor), "ColorVertex must match VertexPositionColor");
+		static_assert(sizeof(TextureVertex) == sizeof(VertexPositionTexture), "TextureVertex must match VertexPositionTexture");
+
+		struct SpriteConstants final
+		{
+			XMFLOAT4X4 WorldViewProjection;
+			XMFLOAT4X4 TextureTransform;
+		};
+
+		D3D11_PRIMITIVE_TOPOLOGY ToD3D11(Topology topology)
+		{
+			switch (topology)
+			{
+			case Topology::TriangleStrip:
+				return D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP;
+			case Topology::LineList:
+				return D3D11_PRIMITIVE_TOPOLOGY_LINELIST;
+			case Topology::LineStrip:
+				return D3D11_PRIMITIVE_TOPOLOGY_LINESTRIP;
+			default:
+				return D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+			}
+		}
+
+		ComPtr<ID3D11Buffer> CreateDynamicBuffer(ID3D11Device* device, uint32_t byteWidth, uint32_t bindFlags)
+		{
+			D3D11_BUFFER_DESC bufferDesc = { 0 };
+			bufferDesc.ByteWidth = byteWidth;
+			bufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+			bufferDesc.BindFlags = bindFlags;
+			bufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+			ComPtr<ID3D11Buffer> buffer;
+			ThrowIfFailed(device->CreateBuffer(&bufferDesc, nullptr, buffer.GetAddressOf()));
+			return buffer;
+		}
+	}
+
+	Matrix4 D3D11RenderBackend::ToMatrix4(FXMMATRIX matrix)
+	{
+		XMFLOAT4X4 stored;
+		XMStoreFloat4x4(&stored, matrix);
+
+		Matrix4 result;
+		memcpy(result.M, stored.m, sizeof(result.M));
+		return result;
+	}
+
+	D3D11RenderBackend::D3D11RenderBackend(const shared_ptr<DX::DeviceResources>& deviceResources) :
+		mDeviceResources(deviceResources), mColorVertexRing(VertexCapacity), mTextureVertexRing(VertexCapacity), mIndexRing(IndexCapacity),
+		mViewProjection(MatrixHelper::Identity), mColorConstantsUploaded(false), mSpriteConstantsUploaded(false), mLoadingComplete(false)
+	{
+	}
+
+	void D3D11RenderBackend::CreateDeviceDependentResources()
+	{
+		auto shaderCache = ShaderCache::GetInstance();
+		auto createColorVSTask = shaderCache->LoadVertexShaderAsync(L"ColorShapeRendererVS.cso").then([this](const ComPtr<ID3D11VertexShader>& vertexShader) {
+			mColorVertexShader = vertexShader;
+		});
+		auto createColorInputLayoutTask = shaderCache->LoadInputLayoutAsync(L"ColorShapeRendererVS.cso", VertexPositionColor::InputElements, VertexPositionColor::InputElementCount).then([this](const ComPtr<ID3D11InputLayout>& inputLayout) {
+			mColorInputLayout = inputLayout;
+		});
+		auto createColorPSTask = shaderCache->LoadPixelShaderAsync(L"ColorShapeRendererPS.cso").then([this](const ComPtr<ID3D11PixelShader>& pixelShader) {
+			mColorPixelShader = pixelShader;
+		});
+
+		auto createSpriteVSTask = shaderCache->LoadVertexShaderAsync(L"SpriteRendererVS.cso").then([this](const ComPtr<ID3D11VertexShader>& vertexShader) {
+			mSpriteVertexShader = vertexShader;
+		});
+		auto createSpriteInputLayoutTask = shaderCache->LoadInputLayoutAsync(L"SpriteRendererVS.cso", VertexPositionTexture::InputElements, VertexPositionTexture::InputElementCount).then([this](const ComPtr<ID3D11InputLayout>& inputLayout) {
+			mSpriteInputLayout = inputLayout;
+		});
+		auto createSpritePSTask = shaderCache->LoadPixelShaderAsync(L"SpriteRendererPS.cso").then([this](const ComPtr<ID3D11PixelShader>& pixelShader) {
+			mSpritePixelShader = pixelShader;
+		});
+
+		ID3D11Device* device = mDeviceResources->GetD3DDevice();
+
+		// Constant buffers of our own, so the matrix only goes up when it changes.
+		D3D11_BUFFER_DESC constantBufferDesc = { 0 };
+		constantBufferDesc.ByteWidth = sizeof(XMFLOAT4X4);
+		constantBufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+		ThrowIfFailed(device->CreateBuffer(&constantBufferDesc, nullptr, mColorConstants.ReleaseAndGetAddressOf()));
+		constantBufferDesc.ByteWidth = sizeof(SpriteConstants);
+		ThrowIfFailed(device->CreateBuffer(&constantBufferDesc, nullptr, mSpriteConstants.ReleaseAndGetAddressOf()));
+		mColorConstantsUploaded = false;
+		mSpriteConstantsUploaded = false;
+
+		mColorVertexBuffer = CreateDynamicBuffer(device, sizeof(ColorVertex) * VertexCapacity, D3D11_BIND_VERTEX_BUFFER);
+		mTextureVertexBuffer = CreateDynamicBuffer(device, sizeof(TextureVertex) * VertexCapacity, D3D11_BIND_VERTEX_BUFFER);
+		mIndexBuffer = CreateDynamicBuffer(device, sizeof(uint16_t) * IndexCapacity, D3D11_BIND_INDEX_BUFFER);
+		mColorVertexRing.Reset();
+		mTextureVertexRing.Reset();
+		mIndexRing.Reset();
+
+		D3D11_SAMPLER_DESC samplerStateDesc;
+		ZeroMemory(&samplerStateDesc, sizeof(samplerStateDesc));
+		samplerStateDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+		samplerStateDesc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
+		samplerStateDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
+		samplerStateDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
+		samplerStateDesc.MinLOD = -FLT_MAX;
+		samplerStateDesc.MaxLOD = FLT_MAX;
+		samplerStateDesc.MaxAnisotropy = 1;
+		samplerStateDesc.ComparisonFunc = D3D11_COMPARISON_NEVER;
+		ThrowIfFailed(device->CreateSamplerState(&samplerStateDesc, mSampler.ReleaseAndGetAddressOf()));
+
+		D3D11_BLEND_DESC blendStateDesc = { 0 };
+		blendStateDesc.RenderTarget[0].BlendEnable = true;
+		blendStateDesc.RenderTarget[0].SrcBlend = D3D11_BLEND_SRC_ALPHA;
+		blendStateDesc.RenderTarget[0].DestBlend = D3D11_BLEND_INV_SRC_ALPHA;
+		blendStateDesc.RenderTarget[0].BlendOp = D3D11_BLEND_OP_ADD;
+		blendStateDesc.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_ZERO;
+		blendStateDesc.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_ZERO;
+		blendStateDesc.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_ADD;
+		blendStateDesc.RenderTarget[0].RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
+		ThrowIfFailed(device->CreateBlendState(&blendStateDesc, mAlphaBlending.ReleaseAndGetAddressOf()));
+
+		mTextureViews.resize(mTextures.size());
+		for (size_t i = 0; i < mTextures.size(); i++)
+		{
+			CreateTextureView(mTextures[i], mTextureViews[i]);
+		}
+
+		(createColorVSTask && createColorInputLayoutTask && createColorPSTask && createSpriteVSTask && createSpriteInputLayoutTask && createSpritePSTask).then([this]() {
+			mLoadingComplete = true;
+		});
+	}
+
+	void D3D11RenderBackend::ReleaseDeviceDependentResources()
+	{
+		mLoadingComplete = false;
+		mColorVertexShader.Reset();
+		mColorPixelShader.Reset();
+		mColorInputLayout.Reset();
+		mSpriteVertexShader.Reset();
+		mSpritePixelShader.Reset();
+		mSpriteInputLayout.Reset();
+		mColorVertexBuffer.Reset();
+		mTextureVertexBuffer.Reset();
+		mIndexBuffer.Reset();
+		mColorConstants.Reset();
+		mSpriteConstants.Reset();
+		mSampler.Reset();
+		mAlphaBlending.Reset();
+		mTextureViews.clear();
+	}
+
+	void D3D11RenderBackend::Clear(float red, float green, float blue, float alpha)
+	{
+		const float color[] = { red, green, blue, alpha };
+		mDeviceResources->GetD3DDeviceContext()->ClearRenderTargetView(mDeviceResources->GetBackBufferRenderTargetView(), color);
+	}
+
+	void D3D11RenderBackend::SetViewProjection(const Matrix4& viewProjection)
+	{
+		if (memcmp(mViewProjection.m, viewProjection.M, sizeof(viewProjection.M)) != 0)
+		{
+			memcpy(mViewProjection.m, viewProjection.M, sizeof(viewProjection.M));
+			mColorConstantsUploaded = false;
+			mSpriteConstantsUploaded = false;
+		}
+	}
+
+	void D3D11RenderBackend::Draw(Topology topology, const ColorVertex* vertices, uint32_t vertexCount)
+	{
+		// Loading is asynchronous. Only draw geometry after it's loaded.
+		if (!mLoadingComplete || vertexCount == 0)
+		{
+			return;
+		}
+
+		BindColorPipeline(topology);
+
+		ID3D11DeviceContext* direct3DDeviceContext = mDeviceResources->GetD3DDeviceContext();
+		ForEachPrimitiveChunk(topology, vertexCount, VertexCapacity, [&](uint32_t first, uint32_t count) {
+			const uint32_t firstVertex = Upload(mColorVertexBuffer.Get(), mColorVertexRing, vertices + first, count);
+			direct3DDeviceContext->Draw(count, firstVertex);
+			RenderStats::GetInstance().RecordDraw();
+		});
+	}
+
+	void D3D11RenderBackend::DrawIndexed(Topology topology, const ColorVertex* vertices, uint32_t vertexCount, const uint16_t* indices, uint32_t indexCount)
+	{
+		if (!mLoadingComplete || vertexCount == 0 || indexCount == 0)
+		{
+			return;
+		}
+
+		// Too many vertices for one upload: draw them unindexed instead, in pieces.
+		if (vertexCount > VertexCapacity)
+		{
+			mExpandedVertices.resize(indexCount);
+			for (uint32_t i = 0; i < indexCount; i++)
+			{
+				mExpandedVertices[i] = vertices[indices[i]];
+			}
+			Draw(topology, mExpandedVertices.data(), indexCount);
+			return;
+		}
+
+		const uint32_t baseVertex = Upload(mColorVertexBuffer.Get(), mColorVertexRing, vertices, vertexCount);
+		BindColorPipeline(topology);
+
+		ID3D11DeviceContext* direct3DDeviceContext = mDeviceResources->GetD3DDeviceContext();
+		direct3DDeviceContext->IASetIndexBuffer(mIndexBuffer.Get(), DXGI_FORMAT_R16_UINT, 0);
+		ForEachPrimitiveChunk(topology, indexCount, IndexCapacity, [&](uint32_t first, uint32_t count) {
+			const uint32_t firstIndex = Upload(mIndexBuffer.Get(), mIndexRing, indices + first, count);
+			direct3DDeviceContext->DrawIndexed(count, firstIndex, baseVertex);
+			RenderStats::GetInstance().RecordDraw();
+		});
+	}
+
+	RenderBackend::TextureId D3D11RenderBackend::CreateTexture(uint32_t width, uint32_t height, const uint32_t* texels)
+	{
+		if (width == 0 || height == 0 || texels == nullptr)
+		{
+			return NoTexture;
+		}
+
+		mTextures.push_back({ width, height, vector<uint32_t>(texels, texels + static_cast<size_t>(width) * height) });
+		mTextureViews.resize(mTextures.size());
+		if (mDeviceResources->GetD3DDevice() != nullptr)
+		{
+			CreateTextureView(mTextures.back(), mTextureViews.back());
+		}
+
+		return static_cast<TextureId>(mTextures.size());
+	}
+
+	void D3D11RenderBackend::DrawTextured(TextureId texture, Topology topology, const TextureVertex* vertices, uint32_t vertexCount)
+	{
+		if (!mLoadingComplete || vertexCount == 0 || texture == NoTexture || texture > mTextureViews.size())
+		{
+			return;
+		}
+
+		ID3D11DeviceContext* direct3DDeviceContext = mDeviceResources->GetD3DDeviceContext();
+		RenderStats& stats = RenderStats::GetInstance();
+
+		if (!mSpriteConstantsUploaded)
+		{
+			SpriteConstants constants;
+			XMStoreFloat4x4(&constants.WorldViewProjection, XMMatrixTranspose(XMLoadFloat4x4(&mViewProjection)));
+			constants.TextureTransform = MatrixHelper::Identity;
+			direct3DDeviceContext->UpdateSubresource(mSpriteConstants.Get(), 0, nullptr, &constants, 0, 0);
+			stats.RecordConstantBufferUpload(sizeof(constants));
+			mSpriteConstantsUploaded = true;
+		}
+
+		direct3DDeviceContext->IASetPrimitiveTopology(ToD3D11(topology));
+		direct3DDeviceContext->IASetInputLayout(mSpriteInputLayout.Get());
+
+		static const UINT stride = sizeof(TextureVertex);
+		static const UINT offset = 0;
+		direct3DDeviceContext->IASetVertexBuffers(0, 1, mTextureVertexBuffer.GetAddressOf(), &stride, &offset);
+
+		direct3DDeviceContext->VSSetShader(mSpriteVertexShader.Get(), nullptr, 0);
+		direct3DDeviceContext->PSSetShader(mSpritePixelShader.Get(), nullptr, 0);
+		direct3DDeviceContext->VSSetConstantBuffers(0, 1, mSpriteConstants.GetAddressOf());
+		direct3DDeviceContext->PSSetShaderResources(0, 1, mTextureViews[texture - 1].GetAddressOf());
+		direct3DDeviceContext->PSSetSamplers(0, 1, mSampler.GetAddressOf());
+		direct3DDeviceContext->OMSetBlendState(mAlphaBlending.Get(), 0, 0xFFFFFFFF);
+
+		ForEachPrimitiveChunk(topology, vertexCount, VertexCapacity, [&](uint32_t first, uint32_t count) {
+			const uint32_t firstVertex = Upload(mTextureVertexBuffer.Get(), mTextureVertexRing, vertices + first, count);
+			direct3DDeviceContext->Draw(count, firstVertex);
+			stats.RecordDraw();
+		});
+
+		// Nothing else expects blending.
+		direct3DDeviceContext->OMSetBlendState(nullptr, 0, 0xFFFFFFFF);
+	}
+
+	void D3D11RenderBackend::Submit()
+	{
+	}
+
+	template <typename TVertex>
+	uint32_t D3D11RenderBackend::Upload(ID3D11Buffer* buffer, RingAllocator& ring, const TVertex* data, uint32_t count)
+	{
+		ID3D11DeviceContext* direct3DDeviceContext = mDeviceResources->GetD3DDeviceContext();
+		const RingAllocator::Range range = ring.Allocate(count);
+
+		D3D11_MAPPED_SUBRESOURCE mappedSubResource;
+		ThrowIfFailed(direct3DDeviceContext->Map(buffer, 0, range.Discard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE, 0, &mappedSubResource));
+		memcpy(static_cast<TVertex*>(mappedSubResource.pData) + range.Offset, data, sizeof(TVertex) * range.Count);
+		direct3DDeviceContext->Unmap(buffer, 0);
+		RenderStats::GetInstance().RecordUpload(sizeof(TVertex) * range.Count);
+
+		return range.Offset;
+	}
+
+	void D3D11RenderBackend::CreateTextureView(const TextureData& texture, ComPtr<ID3D11ShaderResourceView>& view)
+	{
+		D3D11_TEXTURE2D_DESC textureDesc = { 0 };
+		textureDesc.Width = texture.Width;
+		textureDesc.Height = texture.Height;
+		textureDesc.MipLevels = 1;
+		textureDesc.ArraySize = 1;
+		textureDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+		textureDesc.SampleDesc.Count = 1;
+		textureDesc.Usage = D3D11_USAGE_IMMUTABLE;
+		textureDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+		D3D11_SUBRESOURCE_DATA textureSubResourceData = { 0 };
+		textureSubResourceData.pSysMem = texture.Texels.data();
+		textureSubResourceData.SysMemPitch = texture.Width * sizeof(uint32_t);
+
+		ID3D11Device* device = mDeviceResources->GetD3DDevice();
+		ComPtr<ID3D11Texture2D> texture2D;
+		ThrowIfFailed(device->CreateTexture2D(&textureDesc, &textureSubResourceData, texture2D.GetAddressOf()));
+		ThrowIfFailed(device->CreateShaderResourceView(texture2D.Get(), nullptr, view.ReleaseAndGetAddressOf()));
+	}
+
+	void D3D11RenderBackend::BindColorPipeline(Topology topology)
+	{
+		ID3D11DeviceContext* direct3DDeviceContext = mDeviceResources->GetD3DDeviceContext();
+
+		if (!mColorConstantsUploaded)
+		{
+			XMFLOAT4X4 viewProjection;
+			XMStoreFloat4x4(&viewProjection, XMMatrixTranspose(XMLoadFloat4x4(&mViewProjection)));
+			direct3DDeviceContext->UpdateSubresource(mColorConstants.Get(), 0, nullptr, &viewProjection, 0, 0);
+			RenderStats::GetInstance().RecordConstantBufferUpload(sizeof(viewProjection));
+			mColorConstantsUploaded = true;
+		}
+
+		direct3DDeviceContext->IASetPrimitiveTopology(ToD3D11(topology));
+		direct3DDeviceContext->IASetInputLayout(mColorInputLayout.Get());
+
+		static const UINT stride = sizeof(ColorVertex);
+		static const UINT offset = 0;
+		direct3DDeviceContext->IASetVertexBuffers(0, 1, mColorVertexBuffer.GetAddressOf(), &stride, &offset);
+
+		direct3DDeviceContext->VSSetShader(mColorVertexShader.Get(), nullptr, 0);
+		direct3DDeviceContext->PSSetShader(mColorPixelShader.Get(), nullptr, 0);
+		direct3DDeviceContext->VSSetConstantBuffers(0, 1, mColorConstants.GetAddressOf());
+	}
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "RenderBackend.h"
+#include "RingAllocator.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace DX
+{
+	class DeviceResources;
+
+	// Simulation::RenderBackend on the Direct3D 11 immediate context. Geometry streams
+	// through dynamic vertex and index buffers handed out by RingAllocator, so a draw maps
+	// without stalling; colored geometry uses the ColorShapeRenderer shaders and textured
+	// geometry the SpriteRenderer ones with alpha blending. The view-projection matrix is
+	// uploaded only when it changes. Texels are kept on the CPU so a device restore can
+	// recreate the textures under the same ids.
+	class D3D11RenderBackend final : public Simulation::RenderBackend
+	{
+	public:
+		// Per draw call; bigger draws are split into several on primitive boundaries.
+		static const std::uint32_t VertexCapacity;
+		static const std::uint32_t IndexCapacity;
+
+		static Simulation::Matrix4 ToMatrix4(DirectX::FXMMATRIX matrix);
+
+		D3D11RenderBackend(const std::shared_ptr<DX::DeviceResources>& deviceResources);
+		D3D11RenderBackend(const D3D11RenderBackend&) = delete;
+		D3D11RenderBackend& operator=(const D3D11RenderBackend&) = delete;
+		D3D11RenderBackend(D3D11RenderBackend&&) = delete;
+		D3D11RenderBackend& operator=(D3D11RenderBackend&&) = delete;
+		~D3D11RenderBackend() = default;
+
+		void CreateDeviceDependentResources();
+		void ReleaseDeviceDependentResources();
+
+		virtual void Clear(float red, float green, float blue, float alpha) override;
+		virtual void SetViewProjection(const Simulation::Matrix4& viewProjection) override;
+
+		virtual void Draw(Simulation::Topology topology, const Simulation::ColorVertex* vertices, std::uint32_t vertexCount) override;
+		virtual void DrawIndexed(Simulation::Topology topology, const Simulation::ColorVertex* vertices, std::uint32_t vertexCount, const std::uint16_t* indices, std::uint32_t indexCount) override;
+
+		virtual TextureId CreateTexture(std::uint32_t width, std::uint32_t height, const std::uint32_t* texels) override;
+		virtual void DrawTextured(TextureId texture, Simulation::Topology topology, const Simulation::TextureVertex* vertices, std::uint32_t vertexCount) override;
+
+		// Draws go straight to the immediate context, so there is nothing left to send.
+		virtual void Submit() override;
+
+	private:
+		struct TextureData final
+		{
+			std::uint32_t Width;
+			std::uint32_t Height;
+			std::vector<std::uint32_t> Texels;
+		};
+
+		template <typename TVertex>
+		std::uint32_t Upload(ID3D11Buffer* buffer, Simulation::RingAllocator& ring, const TVertex* data, std::uint32_t count);
+		void CreateTextureView(const TextureData& texture, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& view);
+		void BindColorPipeline(Simulation::Topology topology);
+
+		std::shared_ptr<DX::DeviceResources> mDeviceResources;
+		Microsoft::WRL::ComPtr<ID3D11VertexShader> mColorVertexShader;
+		Microsoft::WRL::ComPtr<ID3D11PixelShader> mColorPixelShader;
+		Microsoft::WRL::ComPtr<ID3D11InputLayout> mColorInputLayout;
+		Microsoft::WRL::ComPtr<ID3D11VertexShader> mSpriteVertexShader;
+		Microsoft::WRL::ComPtr<ID3D11PixelShader> mSpritePixelShader;
+		Microsoft::WRL::ComPtr<ID3D11InputLayout> mSpriteInputLayout;
+		Microsoft::WRL::ComPtr<ID3D11Buffer> mColorVertexBuffer;
+		Microsoft::WRL::ComPtr<ID3D11Buffer> mTextureVertexBuffer;
+		Microsoft::WRL::ComPtr<ID3D11Buffer> mIndexBuffer;
+		Microsoft::WRL::ComPtr<ID3D11Buffer> mColorConstants;
+		Microsoft::WRL::ComPtr<ID3D11Buffer> mSpriteConstants;
+		Microsoft::WRL::ComPtr<ID3D11SamplerState> mSampler;
+		Microsoft::WRL::ComPtr<ID3D11BlendState> mAlphaBlending;
+		std::vector<Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>> mTextureViews;
+		std::vector<TextureData> mTextures;
+		std::vector<Simulation::ColorVertex> mExpandedVertices;
+		Simulation::RingAllocator mColorVertexRing;
+		Simulation::RingAllocator mTextureVertexRing;
+		Simulation::RingAllocator mIndexRing;
+		DirectX::XMFLOAT4X4 mViewProjection;
+		bool mColorConstantsUploaded;
+		bool mSpriteConstantsUploaded;
+		bool mLoadingComplete;
+	};
+}
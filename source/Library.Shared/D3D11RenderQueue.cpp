@@ -0,0 +1,153 @@
+#include "pch.h"
+#include "D3D11RenderQueue.h"
+#include "RenderStats.h"
+#include <cassert>
+
+using namespace std;
+using namespace Simulation;
+
+namespace DX
+{
+	shared_ptr<D3D11RenderQueue> D3D11RenderQueue::sInstance = nullptr;
+
+	shared_ptr<D3D11RenderQueue> D3D11RenderQueue::Init(const shared_ptr<DX::DeviceResources>& deviceResources)
+	{
+		if (sInstance == nullptr)
+		{
+			sInstance = make_shared<D3D11RenderQueue>(deviceResources);
+		}
+		return sInstance;
+	}
+
+	shared_ptr<D3D11RenderQueue> D3D11RenderQueue::GetInstance()
+	{
+		return sInstance;
+	}
+
+	D3D11RenderQueue::D3D11RenderQueue(const shared_ptr<DX::DeviceResources>& deviceResources) :
+		mDeviceResources(deviceResources), mTextures(1, nullptr)
+	{
+	}
+
+	void D3D11RenderQueue::Submit(const DrawItem& item)
+	{
+		RenderQueue::DrawState state;
+		state.Layer = item.Layer;
+		state.Pipeline = PipelineId(item);
+		state.Topology = static_cast<uint8_t>(item.Topology);
+		state.Texture = TextureId(item.Texture);
+		state.Geometry = reinterpret_cast<uintptr_t>(item.Geometry);
+		state.Constants = reinterpret_cast<uintptr_t>(item.Constants);
+
+		mQueue.Submit(state, static_cast<uint32_t>(mDraws.size()));
+		mDraws.push_back(item);
+	}
+
+	void D3D11RenderQueue::SubmitOpaque(uint8_t layer, const function<void()>& draw)
+	{
+		mQueue.SubmitOpaque(layer, OpaqueCommand | static_cast<uint32_t>(mOpaqueDraws.size()));
+		mOpaqueDraws.push_back(draw);
+	}
+
+	void D3D11RenderQueue::Execute()
+	{
+		const RenderQueue::Statistics statistics = mQueue.Execute(*this);
+		RenderStats::GetInstance().RecordStateChanges(statistics.StateChanges, statistics.ElidedStateChanges);
+
+		mDraws.clear();
+		mOpaqueDraws.clear();
+	}
+
+	void D3D11RenderQueue::ReleaseDeviceDependentResources()
+	{
+		mQueue.Clear();
+		mDraws.clear();
+		mOpaqueDraws.clear();
+		mPipelines.clear();
+		mTextures.resize(1);
+	}
+
+	// There are only a handful of pipelines and textures, so a linear search beats hashing.
+	uint8_t D3D11RenderQueue::PipelineId(const DrawItem& item)
+	{
+		for (size_t i = 0; i < mPipelines.size(); i++)
+		{
+			const Pipeline& pipeline = mPipelines[i];
+			if (pipeline.VertexShader == item.VertexShader && pipeline.PixelShader == item.PixelShader && pipeline.InputLayout == item.InputLayout)
+			{
+				return static_cast<uint8_t>(i);
+			}
+		}
+
+		// 0xFF sorts opaque draws last.
+		assert(mPipelines.size() < 0xFF);
+		mPipelines.push_back({ item.VertexShader, item.PixelShader, item.InputLayout });
+		return static_cast<uint8_t>(mPipelines.size() - 1);
+	}
+
+	uint16_t D3D11RenderQueue::TextureId(ID3D11ShaderResourceView* texture)
+	{
+		for (size_t i = 0; i < mTextures.size(); i++)
+		{
+			if (mTextures[i] == texture)
+			{
+				return static_cast<uint16_t>(i);
+			}
+		}
+
+		assert(mTextures.size() < 0xFFFF);
+		mTextures.push_back(texture);
+		return static_cast<uint16_t>(mTextures.size() - 1);
+	}
+
+	void D3D11RenderQueue::BindPipeline(uint8_t pipeline)
+	{
+		ID3D11DeviceContext* direct3DDeviceContext = mDeviceResources->GetD3DDeviceContext();
+		const Pipeline& bound = mPipelines[pipeline];
+		direct3DDeviceContext->IASetInputLayout(bound.InputLayout);
+		direct3DDeviceContext->VSSetShader(bound.VertexShader, nullptr, 0);
+		direct3DDeviceContext->PSSetShader(bound.PixelShader, nullptr, 0);
+	}
+
+	void D3D11RenderQueue::BindTopology(uint8_t topology)
+	{
+		mDeviceResources->GetD3DDeviceContext()->IASetPrimitiveTopology(static_cast<D3D11_PRIMITIVE_TOPOLOGY>(topology));
+	}
+
+	void D3D11RenderQueue::BindTexture(uint16_t texture)
+	{
+		ID3D11ShaderResourceView* const view = mTextures[texture];
+		mDeviceResources->GetD3DDeviceContext()->PSSetShaderResources(0, 1, &view);
+	}
+
+	void D3D11RenderQueue::BindGeometry(uintptr_t geometry)
+	{
+		ID3D11DeviceContext* direct3DDeviceContext = mDeviceResources->GetD3DDeviceContext();
+		const GeometryBinding& bound = *reinterpret_cast<const GeometryBinding*>(geometry);
+
+		static const UINT offsets[] = { 0, 0 };
+		direct3DDeviceContext->IASetVertexBuffers(0, bound.VertexBufferCount, bound.VertexBuffers, bound.Strides, offsets);
+		direct3DDeviceContext->IASetIndexBuffer(bound.IndexBuffer, bound.IndexFormat, 0);
+	}
+
+	void D3D11RenderQueue::BindConstants(uintptr_t constants)
+	{
+		ID3D11DeviceContext* direct3DDeviceContext = mDeviceResources->GetD3DDeviceContext();
+		const ConstantBinding& bound = *reinterpret_cast<const ConstantBinding*>(constants);
+		direct3DDeviceContext->VSSetConstantBuffers(0, 1, &bound.VertexShader);
+		direct3DDeviceContext->PSSetConstantBuffers(0, 1, &bound.PixelShader);
+	}
+
+	void D3D11RenderQueue::Draw(uint32_t command)
+	{
+		if ((command & OpaqueCommand) != 0)
+		{
+			mOpaqueDraws[command & ~OpaqueCommand]();
+			return;
+		}
+
+		const DrawItem& item = mDraws[command];
+		mDeviceResources->GetD3DDeviceContext()->DrawIndexedInstanced(item.IndexCount, item.InstanceCount, item.StartIndex, item.BaseVertex, 0);
+		RenderStats::GetInstance().RecordDraw(item.InstanceCount);
+	}
+}
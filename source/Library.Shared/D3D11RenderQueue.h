@@ -0,0 +1,108 @@
+#pragma once
+
+#include "RenderQueue.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace DX
+{
+	class DeviceResources;
+
+	// Simulation::RenderQueue on the Direct3D 11 immediate context. Components Submit() their
+	// draws from Render() instead of binding state themselves, and GameMain calls Execute()
+	// once every component has had its turn; consecutive draws that share shaders, topology,
+	// buffers or constants then bind them only once. Everything a draw refers to is read at
+	// Execute(), so the buffers must stay alive and unchanged until then.
+	class D3D11RenderQueue final : private Simulation::RenderQueue::Executor
+	{
+	public:
+		// Vertex buffers (a second one for instance data) and the index buffer of a draw.
+		// Owned by the submitter; draws that point at the same one share the binding.
+		struct GeometryBinding final
+		{
+			ID3D11Buffer* VertexBuffers[2];
+			UINT Strides[2];
+			UINT VertexBufferCount;
+			ID3D11Buffer* IndexBuffer;
+			DXGI_FORMAT IndexFormat;
+		};
+
+		// Constant buffer slot 0 of each stage; either may be null.
+		struct ConstantBinding final
+		{
+			ID3D11Buffer* VertexShader;
+			ID3D11Buffer* PixelShader;
+		};
+
+		// Lower layers draw first. Within a layer draws are reordered, so they must not
+		// depend on drawing over one another.
+		struct DrawItem final
+		{
+			std::uint8_t Layer;
+			ID3D11VertexShader* VertexShader;
+			ID3D11PixelShader* PixelShader;
+			ID3D11InputLayout* InputLayout;
+			D3D11_PRIMITIVE_TOPOLOGY Topology;
+			ID3D11ShaderResourceView* Texture;
+			const GeometryBinding* Geometry;
+			const ConstantBinding* Constants;
+			std::uint32_t IndexCount;
+			std::uint32_t InstanceCount;
+			std::uint32_t StartIndex;
+			std::int32_t BaseVertex;
+		};
+
+		static std::shared_ptr<D3D11RenderQueue> Init(const std::shared_ptr<DX::DeviceResources>& deviceResources);
+		static std::shared_ptr<D3D11RenderQueue> GetInstance();
+
+		D3D11RenderQueue(const std::shared_ptr<DX::DeviceResources>& deviceResources);
+		D3D11RenderQueue(const D3D11RenderQueue&) = delete;
+		D3D11RenderQueue& operator=(const D3D11RenderQueue&) = delete;
+		D3D11RenderQueue(D3D11RenderQueue&&) = delete;
+		D3D11RenderQueue& operator=(D3D11RenderQueue&&) = delete;
+		~D3D11RenderQueue() = default;
+
+		void Submit(const DrawItem& item);
+
+		// For code that binds its own state, such as QuadBatch drawing through the render
+		// backend. It runs after the layer's other draws.
+		void SubmitOpaque(std::uint8_t layer, const std::function<void()>& draw);
+
+		// Draws everything submitted this frame and records the state changes in RenderStats.
+		void Execute();
+
+		// Forgets the shaders and textures it has seen; they are about to be released.
+		void ReleaseDeviceDependentResources();
+
+	private:
+		struct Pipeline final
+		{
+			ID3D11VertexShader* VertexShader;
+			ID3D11PixelShader* PixelShader;
+			ID3D11InputLayout* InputLayout;
+		};
+
+		static const std::uint32_t OpaqueCommand = 0x80000000;
+
+		std::uint8_t PipelineId(const DrawItem& item);
+		std::uint16_t TextureId(ID3D11ShaderResourceView* texture);
+
+		virtual void BindPipeline(std::uint8_t pipeline) override;
+		virtual void BindTopology(std::uint8_t topology) override;
+		virtual void BindTexture(std::uint16_t texture) override;
+		virtual void BindGeometry(std::uintptr_t geometry) override;
+		virtual void BindConstants(std::uintptr_t constants) override;
+		virtual void Draw(std::uint32_t command) override;
+
+		static std::shared_ptr<D3D11RenderQueue> sInstance;
+
+		std::shared_ptr<DX::DeviceResources> mDeviceResources;
+		Simulation::RenderQueue mQueue;
+		std::vector<DrawItem> mDraws;
+		std::vector<std::function<void()>> mOpaqueDraws;
+		std::vector<Pipeline> mPipelines;
+		std::vector<ID3D11ShaderResourceView*> mTextures;
+	};
+}
@@ -1,6 +1,7 @@
 ﻿#include "pch.h"
 #include "DeviceResources.h"
 #include "DirectXHelper.h"
+#include "Profiler.h"
 
 using namespace D2D1;
 using namespace DirectX;
@@ -622,6 +623,8 @@ namespace DX
 	// Present the contents of the swap chain to the screen.
 	void DeviceResources::Present()
 	{
+		SIMULATION_PROFILE_ZONE("DeviceResources::Present");
+
 		// The first argument instructs DXGI to block until VSync, putting the application
 		// to sleep until the next VSync. This ensures we don't waste any cycles rendering
 		// frames that will never be displayed to the screen.
@@ -648,6 +651,17 @@ namespace DX
 		}
 	}
 
+	// Blocks until VSync without presenting, for a frame with nothing new to show. The
+	// screen keeps the last frame presented.
+	void DeviceResources::WaitForVerticalBlank()
+	{
+		ComPtr<IDXGIOutput> output;
+		if (SUCCEEDED(m_swapChain->GetContainingOutput(&output)))
+		{
+			output->WaitForVBlank();
+		}
+	}
+
 	// This method determines the rotation between the display device's native orientation and the
 	// current display orientation.
 	DXGI_MODE_ROTATION DeviceResources::ComputeDisplayRotation()
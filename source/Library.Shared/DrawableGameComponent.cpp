@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "DrawableGameComponent.h"
+#include "ComponentRegistry.h"
 
 using namespace std;
 
@@ -25,6 +26,10 @@ namespace DX
 	void DrawableGameComponent::SetVisible(bool visible)
 	{
 		mVisible = visible;
+		if (mRegistry != nullptr)
+		{
+			mRegistry->VisibleChanged(*this);
+		}
 	}
 
 	shared_ptr<Camera> DrawableGameComponent::GetCamera()
@@ -41,4 +46,20 @@ namespace DX
 	{
 		UNREFERENCED_PARAMETER(timer);
 	}
+
+	bool DrawableGameComponent::VisualStateChanged() const
+	{
+		return true;
+	}
+
+	bool DrawableGameComponent::RecordsInParallel() const
+	{
+		return false;
+	}
+
+	void DrawableGameComponent::Record(const StepTimer& timer, Simulation::RenderBackend& backend)
+	{
+		UNREFERENCED_PARAMETER(timer);
+		UNREFERENCED_PARAMETER(backend);
+	}
 }
\ No newline at end of file
@@ -3,6 +3,11 @@
 #include "GameComponent.h"
 #include <memory>
 
+namespace Simulation
+{
+    class RenderBackend;
+}
+
 namespace DX
 {
     class Camera;
@@ -26,6 +31,17 @@ namespace DX
 
         virtual void Render(const DX::StepTimer& timer);
 
+        // Whether the next Render() would draw something different from the last one. Only
+        // asked when GameMain renders on change; components that cannot tell say true.
+        virtual bool VisualStateChanged() const;
+
+        // A component that draws only through a render backend can say so here. GameMain then
+        // calls Record() on a worker thread, into a command buffer it replays at the
+        // component's turn in the render queue, instead of calling Render(). Record() must
+        // not touch anything another component might.
+        virtual bool RecordsInParallel() const;
+        virtual void Record(const DX::StepTimer& timer, Simulation::RenderBackend& backend);
+
     protected:
         bool mVisible;
 		std::shared_ptr<Camera> mCamera;
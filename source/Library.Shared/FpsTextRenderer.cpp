@@ -9,7 +9,8 @@ namespace DX
 	// Initializes D2D resources used for text rendering.
 	FpsTextRenderer::FpsTextRenderer(const std::shared_ptr<DX::DeviceResources>& deviceResources) :
 		DrawableGameComponent(deviceResources),
-		m_text(L"")
+		m_text(L""),
+		m_drawnText(L"")
 	{
 		ZeroMemory(&m_textMetrics, sizeof(DWRITE_TEXT_METRICS));
 
@@ -110,6 +111,13 @@ namespace DX
 		}
 
 		context->RestoreDrawingState(m_stateBlock.Get());
+		m_drawnText = m_text;
+	}
+
+	// The text changes at most once a second.
+	bool FpsTextRenderer::VisualStateChanged() const
+	{
+		return m_text != m_drawnText;
 	}
 
 	void FpsTextRenderer::CreateDeviceDependentResources()
@@ -16,9 +16,11 @@ namespace DX
 		virtual void ReleaseDeviceDependentResources() override;
 		virtual void Update(const DX::StepTimer& timer) override;
 		virtual void Render(const DX::StepTimer& timer) override;
+		virtual bool VisualStateChanged() const override;
 
 	private:
 		std::wstring                                    m_text;
+		std::wstring                                    m_drawnText;
 		DWRITE_TEXT_METRICS	                            m_textMetrics;
 		Microsoft::WRL::ComPtr<ID2D1SolidColorBrush>    m_whiteBrush;
 		Microsoft::WRL::ComPtr<ID2D1DrawingStateBlock1> m_stateBlock;
@@ -1,13 +1,14 @@
 #include "pch.h"
 #include "GameComponent.h"
 #include "StepTimer.h"
+#include "ComponentRegistry.h"
 
 using namespace std;
 
 namespace DX
 {
 	GameComponent::GameComponent(const shared_ptr<DX::DeviceResources>& deviceResources) :
-		mDeviceResources(deviceResources), mEnabled(true)
+		mDeviceResources(deviceResources), mRegistry(nullptr), mEnabled(true)
 	{
 	}
 
@@ -24,6 +25,20 @@ namespace DX
 	void GameComponent::SetEnabled(bool enabled)
 	{
 		mEnabled = enabled;
+		if (mRegistry != nullptr)
+		{
+			mRegistry->EnabledChanged(*this);
+		}
+	}
+
+	ComponentRegistry* GameComponent::Registry() const
+	{
+		return mRegistry;
+	}
+
+	void GameComponent::SetRegistry(ComponentRegistry* registry)
+	{
+		mRegistry = registry;
 	}
 
 	void GameComponent::CreateDeviceDependentResources()
@@ -42,4 +57,10 @@ namespace DX
 	{
 		UNREFERENCED_PARAMETER(timer);
 	}
+
+	bool GameComponent::DeclareUpdateAccess(Simulation::TaskGraph::Access& access) const
+	{
+		UNREFERENCED_PARAMETER(access);
+		return false;
+	}
 }
\ No newline at end of file
@@ -1,11 +1,13 @@
 #pragma once
 
 #include "DeviceResources.h"
+#include "TaskGraph.h"
 #include <memory>
 
 namespace DX
 {
 	class StepTimer;
+	class ComponentRegistry;
 
 	class GameComponent
 	{
@@ -21,14 +23,25 @@ namespace DX
 		bool Enabled() const;
 		void SetEnabled(bool enabled);
 
+		// Set by the registry the component is added to, which hears about SetEnabled().
+		ComponentRegistry* Registry() const;
+		void SetRegistry(ComponentRegistry* registry);
+
 		virtual void CreateDeviceDependentResources();
 		virtual void CreateWindowSizeDependentResources();
 		virtual void ReleaseDeviceDependentResources();
 
 		virtual void Update(const StepTimer& timer);
 
+		// Lists what Update() reads and writes besides the component itself, so that updates
+		// sharing nothing run at the same time on the job system. Components that return
+		// false, as they do by default, are updated on the calling thread with nothing else
+		// running.
+		virtual bool DeclareUpdateAccess(Simulation::TaskGraph::Access& access) const;
+
 	protected:
 		std::shared_ptr<DX::DeviceResources> mDeviceResources;
+		ComponentRegistry* mRegistry;
 		bool mEnabled;
 	};
 }
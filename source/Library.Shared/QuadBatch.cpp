@@ -0,0 +1,110 @@
+#include "pch.h"
+#include "QuadBatch.h"
+#include "D3D11RenderBackend.h"
+#include "D3D11RenderQueue.h"
+
+using namespace std;
+using namespace DirectX;
+using namespace Simulation;
+
+namespace DX
+{
+	const uint32_t QuadBatch::Capacity = 4096;
+
+	namespace
+	{
+		const uint32_t VerticesPerQuad = 4;
+		const uint32_t IndicesPerQuad = 6;
+	}
+
+	shared_ptr<QuadBatch> QuadBatch::sInstance = nullptr;
+
+	shared_ptr<QuadBatch> QuadBatch::Init(const shared_ptr<DX::DeviceResources>& deviceResources, const shared_ptr<Camera>& camera, const shared_ptr<RenderBackend>& backend)
+	{
+		if (sInstance == nullptr)
+		{
+			sInstance = make_shared<QuadBatch>(deviceResources, camera, backend);
+		}
+		return sInstance;
+	}
+
+	shared_ptr<QuadBatch> QuadBatch::GetInstance()
+	{
+		return sInstance;
+	}
+
+	QuadBatch::QuadBatch(const shared_ptr<DX::DeviceResources>& deviceResources, const shared_ptr<Camera>& camera, const shared_ptr<RenderBackend>& backend) :
+		DrawableGameComponent(deviceResources, camera), mBackend(backend), mIndices(Capacity * IndicesPerQuad)
+	{
+		mVertices.reserve(Capacity * VerticesPerQuad);
+
+		// Two triangles per quad, relative to the first quad of each draw.
+		static const uint32_t quadIndices[IndicesPerQuad] = { 0, 1, 2, 2, 1, 3 };
+		for (uint32_t i = 0; i < mIndices.size(); i++)
+		{
+			mIndices[i] = static_cast<uint16_t>((i / IndicesPerQuad) * VerticesPerQuad + quadIndices[i % IndicesPerQuad]);
+		}
+	}
+
+	void QuadBatch::AddQuad(const XMFLOAT2& lowerLeft, const XMFLOAT2& upperRight, const XMFLOAT4& color)
+	{
+		// Same corner order the components used for their triangle strips.
+		const float corners[VerticesPerQuad][2] = { { lowerLeft.x, upperRight.y }, { upperRight.x, upperRight.y }, { lowerLeft.x, lowerLeft.y }, { upperRight.x, lowerLeft.y } };
+		for (const auto& corner : corners)
+		{
+			mVertices.push_back({ { corner[0], corner[1], 0.0f, 1.0f }, { color.x, color.y, color.z, color.w } });
+		}
+	}
+
+	void QuadBatch::AddOutline(const XMFLOAT2& lowerLeft, const XMFLOAT2& upperRight, float thickness, const XMFLOAT4& color)
+	{
+		AddQuad(XMFLOAT2(lowerLeft.x, upperRight.y - thickness), upperRight, color);
+		AddQuad(lowerLeft, XMFLOAT2(upperRight.x, lowerLeft.y + thickness), color);
+		AddQuad(XMFLOAT2(lowerLeft.x, lowerLeft.y + thickness), XMFLOAT2(lowerLeft.x + thickness, upperRight.y - thickness), color);
+		AddQuad(XMFLOAT2(upperRight.x - thickness, lowerLeft.y + thickness), XMFLOAT2(upperRight.x, upperRight.y - thickness), color);
+	}
+
+	uint32_t QuadBatch::PendingCount() const
+	{
+		return static_cast<uint32_t>(mVertices.size()) / VerticesPerQuad;
+	}
+
+	void QuadBatch::Flush()
+	{
+		const uint32_t quadCount = PendingCount();
+		if (quadCount == 0)
+		{
+			return;
+		}
+
+		mBackend->SetViewProjection(D3D11RenderBackend::ToMatrix4(mCamera->ViewProjectionMatrix()));
+
+		// One draw per flush unless more than Capacity quads piled up.
+		for (uint32_t first = 0; first < quadCount; first += Capacity)
+		{
+			const uint32_t count = min(quadCount - first, Capacity);
+			mBackend->DrawIndexed(Topology::TriangleList, &mVertices[first * VerticesPerQuad], count * VerticesPerQuad, mIndices.data(), count * IndicesPerQuad);
+		}
+
+		mVertices.clear();
+	}
+
+	void QuadBatch::ReleaseDeviceDependentResources()
+	{
+		mVertices.clear();
+	}
+
+	void QuadBatch::Render(const StepTimer& timer)
+	{
+		UNREFERENCED_PARAMETER(timer);
+
+		D3D11RenderQueue::GetInstance()->SubmitOpaque(0, [this]() {
+			Flush();
+		});
+	}
+
+	bool QuadBatch::VisualStateChanged() const
+	{
+		return false;
+	}
+}
\ No newline at end of file
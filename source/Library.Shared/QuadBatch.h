@@ -0,0 +1,52 @@
+#pragma once
+
+#include "DrawableGameComponent.h"
+#include "RenderBackend.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace DX
+{
+	// Collects the solid-colored rectangles of every component and draws them together.
+	// Components call AddQuad() from their Render(); the batch hands what has accumulated
+	// to the render backend as a single indexed draw when it is flushed. Render() queues the
+	// flush as an opaque draw on the render queue, so it runs after the queued draws of its
+	// layer and sees every quad added this frame.
+	class QuadBatch final : public DrawableGameComponent
+	{
+	public:
+		static const std::uint32_t Capacity;
+
+		static std::shared_ptr<QuadBatch> Init(const std::shared_ptr<DX::DeviceResources>& deviceResources, const std::shared_ptr<Camera>& camera, const std::shared_ptr<Simulation::RenderBackend>& backend);
+		static std::shared_ptr<QuadBatch> GetInstance();
+
+		QuadBatch(const std::shared_ptr<DX::DeviceResources>& deviceResources, const std::shared_ptr<Camera>& camera, const std::shared_ptr<Simulation::RenderBackend>& backend);
+		QuadBatch(const QuadBatch&) = delete;
+		QuadBatch& operator=(const QuadBatch&) = delete;
+		QuadBatch(QuadBatch&&) = delete;
+		QuadBatch& operator=(QuadBatch&&) = delete;
+		~QuadBatch() = default;
+
+		void AddQuad(const DirectX::XMFLOAT2& lowerLeft, const DirectX::XMFLOAT2& upperRight, const DirectX::XMFLOAT4& color);
+
+		// The rectangle's border, thickness world units wide, inside its bounds.
+		void AddOutline(const DirectX::XMFLOAT2& lowerLeft, const DirectX::XMFLOAT2& upperRight, float thickness, const DirectX::XMFLOAT4& color);
+
+		std::uint32_t PendingCount() const;
+		void Flush();
+
+		virtual void ReleaseDeviceDependentResources() override;
+		virtual void Render(const DX::StepTimer& timer) override;
+
+		// The quads belong to the components that add them; they report their own changes.
+		virtual bool VisualStateChanged() const override;
+
+	private:
+		static std::shared_ptr<QuadBatch> sInstance;
+
+		std::shared_ptr<Simulation::RenderBackend> mBackend;
+		std::vector<Simulation::ColorVertex> mVertices;
+		std::vector<std::uint16_t> mIndices;
+	};
+}
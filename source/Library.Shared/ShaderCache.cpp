@@ -0,0 +1,208 @@
+#include "pch.h"
+#include "ShaderCache.h"
+#include "DeviceResources.h"
+
+using namespace std;
+using namespace Microsoft::WRL;
+using namespace Concurrency;
+
+namespace DX
+{
+	shared_ptr<ShaderCache> ShaderCache::sInstance = nullptr;
+
+	shared_ptr<ShaderCache> ShaderCache::Init(const shared_ptr<DX::DeviceResources>& deviceResources)
+	{
+		if (sInstance == nullptr)
+		{
+			sInstance = make_shared<ShaderCache>(deviceResources);
+		}
+		return sInstance;
+	}
+
+	shared_ptr<ShaderCache> ShaderCache::GetInstance()
+	{
+		return sInstance;
+	}
+
+	ShaderCache::ShaderCache(const shared_ptr<DX::DeviceResources>& deviceResources) :
+		mDeviceResources(deviceResources), mStatistics(), mEnabled(true)
+	{
+	}
+
+	task<ComPtr<ID3D11VertexShader>> ShaderCache::LoadVertexShaderAsync(const wstring& filename)
+	{
+		lock_guard<mutex> lock(mMutex);
+		auto found = mVertexShaders.find(filename);
+		if (mEnabled && found != mVertexShaders.end())
+		{
+			++mStatistics.CacheHits;
+			return found->second;
+		}
+
+		auto createTask = LoadBytecodeAsync(filename).then([this](const Bytecode& bytecode) {
+			ComPtr<ID3D11VertexShader> vertexShader;
+			ThrowIfFailed(mDeviceResources->GetD3DDevice()->CreateVertexShader(bytecode->data(), bytecode->size(), nullptr, vertexShader.GetAddressOf()));
+
+			lock_guard<mutex> lock(mMutex);
+			++mStatistics.ShadersCreated;
+			return vertexShader;
+		});
+
+		if (mEnabled)
+		{
+			mVertexShaders.emplace(filename, createTask);
+		}
+		TrackPending(createTask);
+		return createTask;
+	}
+
+	task<ComPtr<ID3D11PixelShader>> ShaderCache::LoadPixelShaderAsync(const wstring& filename)
+	{
+		lock_guard<mutex> lock(mMutex);
+		auto found = mPixelShaders.find(filename);
+		if (mEnabled && found != mPixelShaders.end())
+		{
+			++mStatistics.CacheHits;
+			return found->second;
+		}
+
+		auto createTask = LoadBytecodeAsync(filename).then([this](const Bytecode& bytecode) {
+			ComPtr<ID3D11PixelShader> pixelShader;
+			ThrowIfFailed(mDeviceResources->GetD3DDevice()->CreatePixelShader(bytecode->data(), bytecode->size(), nullptr, pixelShader.GetAddressOf()));
+
+			lock_guard<mutex> lock(mMutex);
+			++mStatistics.ShadersCreated;
+			return pixelShader;
+		});
+
+		if (mEnabled)
+		{
+			mPixelShaders.emplace(filename, createTask);
+		}
+		TrackPending(createTask);
+		return createTask;
+	}
+
+	task<ComPtr<ID3D11InputLayout>> ShaderCache::LoadInputLayoutAsync(const wstring& vertexShaderFilename, const D3D11_INPUT_ELEMENT_DESC* inputElements, uint32_t inputElementCount)
+	{
+		lock_guard<mutex> lock(mMutex);
+		const auto key = make_pair(vertexShaderFilename, inputElements);
+		auto found = mInputLayouts.find(key);
+		if (mEnabled && found != mInputLayouts.end())
+		{
+			++mStatistics.CacheHits;
+			return found->second;
+		}
+
+		auto createTask = LoadBytecodeAsync(vertexShaderFilename).then([this, inputElements, inputElementCount](const Bytecode& bytecode) {
+			ComPtr<ID3D11InputLayout> inputLayout;
+			ThrowIfFailed(mDeviceResources->GetD3DDevice()->CreateInputLayout(inputElements, inputElementCount, bytecode->data(), bytecode->size(), inputLayout.GetAddressOf()));
+
+			lock_guard<mutex> lock(mMutex);
+			++mStatistics.InputLayoutsCreated;
+			return inputLayout;
+		});
+
+		if (mEnabled)
+		{
+			mInputLayouts.emplace(key, createTask);
+		}
+		TrackPending(createTask);
+		return createTask;
+	}
+
+	ComPtr<ID3D11Buffer> ShaderCache::GetConstantBuffer(uint32_t byteWidth)
+	{
+		lock_guard<mutex> lock(mMutex);
+		ComPtr<ID3D11Buffer> constantBuffer;
+		if (mEnabled)
+		{
+			constantBuffer = mConstantBuffers[byteWidth];
+			if (constantBuffer != nullptr)
+			{
+				++mStatistics.CacheHits;
+				return constantBuffer;
+			}
+		}
+
+		CD3D11_BUFFER_DESC constantBufferDesc(byteWidth, D3D11_BIND_CONSTANT_BUFFER);
+		ThrowIfFailed(mDeviceResources->GetD3DDevice()->CreateBuffer(&constantBufferDesc, nullptr, constantBuffer.GetAddressOf()));
+		++mStatistics.ConstantBuffersCreated;
+		if (mEnabled)
+		{
+			mConstantBuffers[byteWidth] = constantBuffer;
+		}
+		return constantBuffer;
+	}
+
+	bool ShaderCache::Enabled() const
+	{
+		lock_guard<mutex> lock(mMutex);
+		return mEnabled;
+	}
+
+	void ShaderCache::SetEnabled(bool enabled)
+	{
+		lock_guard<mutex> lock(mMutex);
+		mEnabled = enabled;
+	}
+
+	task<void> ShaderCache::WhenLoaded()
+	{
+		lock_guard<mutex> lock(mMutex);
+		if (mPending.empty())
+		{
+			return task_from_result();
+		}
+
+		return when_all(mPending.begin(), mPending.end());
+	}
+
+	ShaderCache::Statistics ShaderCache::GetStatistics() const
+	{
+		lock_guard<mutex> lock(mMutex);
+		return mStatistics;
+	}
+
+	void ShaderCache::ResetStatistics()
+	{
+		lock_guard<mutex> lock(mMutex);
+		mStatistics = Statistics();
+	}
+
+	void ShaderCache::ReleaseDeviceDependentResources()
+	{
+		lock_guard<mutex> lock(mMutex);
+		mVertexShaders.clear();
+		mPixelShaders.clear();
+		mInputLayouts.clear();
+		mConstantBuffers.clear();
+		mPending.clear();
+	}
+
+	task<ShaderCache::Bytecode> ShaderCache::LoadBytecodeAsync(const wstring& filename)
+	{
+		auto found = mBytecode.find(filename);
+		if (mEnabled && found != mBytecode.end())
+		{
+			return found->second;
+		}
+
+		++mStatistics.FileReads;
+		auto loadTask = ReadDataAsync(filename).then([](const vector<byte>& fileData) {
+			return Bytecode(make_shared<const vector<byte>>(fileData));
+		});
+
+		if (mEnabled)
+		{
+			mBytecode.emplace(filename, loadTask);
+		}
+		return loadTask;
+	}
+
+	template <typename T>
+	void ShaderCache::TrackPending(const task<T>& loadTask)
+	{
+		mPending.push_back(loadTask.then([](const T&) {}));
+	}
+}
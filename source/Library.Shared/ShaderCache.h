@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include <ppltasks.h>
+
+namespace DX
+{
+	class DeviceResources;
+
+	// Compiled shaders, input layouts and constant buffers shared by every component on the
+	// device. Components ask by shader file, and by vertex declaration for input layouts; the
+	// first request reads the file and creates the object, later ones get the same ComPtr.
+	// Bytecode is device-independent and survives ReleaseDeviceDependentResources(), so a
+	// device restore recreates the D3D objects without touching the disk.
+	class ShaderCache final
+	{
+	public:
+		struct Statistics final
+		{
+			std::uint32_t FileReads;
+			std::uint32_t ShadersCreated;
+			std::uint32_t InputLayoutsCreated;
+			std::uint32_t ConstantBuffersCreated;
+			std::uint32_t CacheHits;
+		};
+
+		static std::shared_ptr<ShaderCache> Init(const std::shared_ptr<DX::DeviceResources>& deviceResources);
+		static std::shared_ptr<ShaderCache> GetInstance();
+
+		ShaderCache(const std::shared_ptr<DX::DeviceResources>& deviceResources);
+		ShaderCache(const ShaderCache&) = delete;
+		ShaderCache& operator=(const ShaderCache&) = delete;
+		ShaderCache(ShaderCache&&) = delete;
+		ShaderCache& operator=(ShaderCache&&) = delete;
+		~ShaderCache() = default;
+
+		Concurrency::task<Microsoft::WRL::ComPtr<ID3D11VertexShader>> LoadVertexShaderAsync(const std::wstring& filename);
+		Concurrency::task<Microsoft::WRL::ComPtr<ID3D11PixelShader>> LoadPixelShaderAsync(const std::wstring& filename);
+
+		// Keyed by the vertex shader and the declaration's InputElements array, which the
+		// vertex declarations keep in static storage.
+		Concurrency::task<Microsoft::WRL::ComPtr<ID3D11InputLayout>> LoadInputLayoutAsync(const std::wstring& vertexShaderFilename, const D3D11_INPUT_ELEMENT_DESC* inputElements, std::uint32_t inputElementCount);
+
+		// A default-usage constant buffer shared by every caller asking for the same size.
+		// Callers must rewrite it before each draw that reads it.
+		Microsoft::WRL::ComPtr<ID3D11Buffer> GetConstantBuffer(std::uint32_t byteWidth);
+
+		// On by default. Off, every request reads its file and creates its own object, the way
+		// each component loaded its shaders before there was a cache, so the two can be timed
+		// in the same run; nothing loaded while off is kept.
+		bool Enabled() const;
+		void SetEnabled(bool enabled);
+
+		// Completes once every load requested so far has finished.
+		Concurrency::task<void> WhenLoaded();
+
+		Statistics GetStatistics() const;
+		void ResetStatistics();
+
+		void ReleaseDeviceDependentResources();
+
+	private:
+		typedef std::shared_ptr<const std::vector<byte>> Bytecode;
+
+		// These expect mMutex to be held.
+		Concurrency::task<Bytecode> LoadBytecodeAsync(const std::wstring& filename);
+		template <typename T>
+		void TrackPending(const Concurrency::task<T>& task);
+
+		static std::shared_ptr<ShaderCache> sInstance;
+
+		std::shared_ptr<DX::DeviceResources> mDeviceResources;
+		mutable std::mutex mMutex;
+		std::map<std::wstring, Concurrency::task<Bytecode>> mBytecode;
+		std::map<std::wstring, Concurrency::task<Microsoft::WRL::ComPtr<ID3D11VertexShader>>> mVertexShaders;
+		std::map<std::wstring, Concurrency::task<Microsoft::WRL::ComPtr<ID3D11PixelShader>>> mPixelShaders;
+		std::map<std::pair<std::wstring, const D3D11_INPUT_ELEMENT_DESC*>, Concurrency::task<Microsoft::WRL::ComPtr<ID3D11InputLayout>>> mInputLayouts;
+		std::map<std::uint32_t, Microsoft::WRL::ComPtr<ID3D11Buffer>> mConstantBuffers;
+		std::vector<Concurrency::task<void>> mPending;
+		Statistics mStatistics;
+		bool mEnabled;
+	};
+}
@@ -0,0 +1,187 @@
+#include "pch.h"
+#include "StaticGeometry.h"
+#include "ShaderCache.h"
+#include "RenderStats.h"
+#include <cassert>
+#include <cstring>
+
+using namespace std;
+using namespace DirectX;
+using namespace Microsoft::WRL;
+
+namespace DX
+{
+	const uint32_t StaticGeometry::MaxVertexCount = 65536;
+
+	StaticGeometry::StaticGeometry(const shared_ptr<DX::DeviceResources>& deviceResources, const shared_ptr<Camera>& camera, D3D11_PRIMITIVE_TOPOLOGY topology) :
+		DrawableGameComponent(deviceResources, camera), mGeometryBinding(), mConstantBinding(), mTopology(topology), mUploadedViewProjection(), mViewProjectionUploaded(false), mLoadingComplete(false)
+	{
+	}
+
+	void StaticGeometry::AddQuad(const XMFLOAT2& lowerLeft, const XMFLOAT2& upperRight, const XMFLOAT4& color)
+	{
+		assert(mTopology == D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+		if (mVertices.size() + 4 > MaxVertexCount)
+		{
+			throw exception("StaticGeometry is out of 16-bit indices.");
+		}
+
+		const uint16_t first = static_cast<uint16_t>(mVertices.size());
+		mVertices.emplace_back(XMFLOAT4(lowerLeft.x, upperRight.y, 0.0f, 1.0f), color);
+		mVertices.emplace_back(XMFLOAT4(upperRight.x, upperRight.y, 0.0f, 1.0f), color);
+		mVertices.emplace_back(XMFLOAT4(lowerLeft.x, lowerLeft.y, 0.0f, 1.0f), color);
+		mVertices.emplace_back(XMFLOAT4(upperRight.x, lowerLeft.y, 0.0f, 1.0f), color);
+
+		static const uint16_t quadIndices[] = { 0, 1, 2, 2, 1, 3 };
+		for (uint16_t index : quadIndices)
+		{
+			mIndices.push_back(static_cast<uint16_t>(first + index));
+		}
+	}
+
+	void StaticGeometry::AddLine(const XMFLOAT2& from, const XMFLOAT2& to, const XMFLOAT4& color)
+	{
+		assert(mTopology == D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
+		if (mVertices.size() + 2 > MaxVertexCount)
+		{
+			throw exception("StaticGeometry is out of 16-bit indices.");
+		}
+
+		const uint16_t first = static_cast<uint16_t>(mVertices.size());
+		mVertices.emplace_back(XMFLOAT4(from.x, from.y, 0.0f, 1.0f), color);
+		mVertices.emplace_back(XMFLOAT4(to.x, to.y, 0.0f, 1.0f), color);
+		mIndices.push_back(first);
+		mIndices.push_back(static_cast<uint16_t>(first + 1));
+	}
+
+	uint32_t StaticGeometry::VertexCount() const
+	{
+		return static_cast<uint32_t>(mVertices.size());
+	}
+
+	uint32_t StaticGeometry::IndexCount() const
+	{
+		return static_cast<uint32_t>(mIndices.size());
+	}
+
+	void StaticGeometry::CreateDeviceDependentResources()
+	{
+		if (mIndices.empty())
+		{
+			return;
+		}
+
+		auto shaderCache = ShaderCache::GetInstance();
+		auto createVSTask = shaderCache->LoadVertexShaderAsync(L"ColorShapeRendererVS.cso").then([this](const ComPtr<ID3D11VertexShader>& vertexShader) {
+			mVertexShader = vertexShader;
+		});
+
+		auto createInputLayoutTask = shaderCache->LoadInputLayoutAsync(L"ColorShapeRendererVS.cso", VertexPositionColor::InputElements, VertexPositionColor::InputElementCount).then([this](const ComPtr<ID3D11InputLayout>& inputLayout) {
+			mInputLayout = inputLayout;
+		});
+
+		auto createPSTask = shaderCache->LoadPixelShaderAsync(L"ColorShapeRendererPS.cso").then([this](const ComPtr<ID3D11PixelShader>& pixelShader) {
+			mPixelShader = pixelShader;
+		});
+
+		// Not the cache's shared matrix buffer: other components rewrite that every frame.
+		D3D11_BUFFER_DESC constantBufferDesc = { 0 };
+		constantBufferDesc.ByteWidth = sizeof(XMFLOAT4X4);
+		constantBufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+		ThrowIfFailed(mDeviceResources->GetD3DDevice()->CreateBuffer(&constantBufferDesc, nullptr, mVSCBufferPerObject.ReleaseAndGetAddressOf()));
+		mViewProjectionUploaded = false;
+
+		D3D11_BUFFER_DESC vertexBufferDesc = { 0 };
+		vertexBufferDesc.ByteWidth = static_cast<uint32_t>(sizeof(VertexPositionColor) * mVertices.size());
+		vertexBufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
+		vertexBufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+
+		D3D11_SUBRESOURCE_DATA vertexSubResourceData = { 0 };
+		vertexSubResourceData.pSysMem = mVertices.data();
+		ThrowIfFailed(mDeviceResources->GetD3DDevice()->CreateBuffer(&vertexBufferDesc, &vertexSubResourceData, mVertexBuffer.ReleaseAndGetAddressOf()));
+
+		D3D11_BUFFER_DESC indexBufferDesc = { 0 };
+		indexBufferDesc.ByteWidth = static_cast<uint32_t>(sizeof(uint16_t) * mIndices.size());
+		indexBufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
+		indexBufferDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+
+		D3D11_SUBRESOURCE_DATA indexSubResourceData = { 0 };
+		indexSubResourceData.pSysMem = mIndices.data();
+		ThrowIfFailed(mDeviceResources->GetD3DDevice()->CreateBuffer(&indexBufferDesc, &indexSubResourceData, mIndexBuffer.ReleaseAndGetAddressOf()));
+
+		mGeometryBinding.VertexBuffers[0] = mVertexBuffer.Get();
+		mGeometryBinding.Strides[0] = sizeof(VertexPositionColor);
+		mGeometryBinding.VertexBufferCount = 1;
+		mGeometryBinding.IndexBuffer = mIndexBuffer.Get();
+		mGeometryBinding.IndexFormat = DXGI_FORMAT_R16_UINT;
+		mConstantBinding.VertexShader = mVSCBufferPerObject.Get();
+
+		(createPSTask && createVSTask && createInputLayoutTask).then([this]() {
+			mLoadingComplete = true;
+		});
+	}
+
+	void StaticGeometry::ReleaseDeviceDependentResources()
+	{
+		mLoadingComplete = false;
+		mVertexShader.Reset();
+		mPixelShader.Reset();
+		mInputLayout.Reset();
+		mVertexBuffer.Reset();
+		mIndexBuffer.Reset();
+		mVSCBufferPerObject.Reset();
+	}
+
+	void StaticGeometry::Render(const StepTimer& timer)
+	{
+		UNREFERENCED_PARAMETER(timer);
+
+		// Loading is asynchronous. Only draw geometry after it's loaded.
+		if (!mLoadingComplete)
+		{
+			return;
+		}
+
+		ID3D11DeviceContext* direct3DDeviceContext = mDeviceResources->GetD3DDeviceContext();
+		Simulation::RenderStats& stats = Simulation::RenderStats::GetInstance();
+
+		const XMFLOAT4X4 viewProjection = ViewProjection();
+		if (!mViewProjectionUploaded || memcmp(&viewProjection, &mUploadedViewProjection, sizeof(viewProjection)) != 0)
+		{
+			direct3DDeviceContext->UpdateSubresource(mVSCBufferPerObject.Get(), 0, nullptr, &viewProjection, 0, 0);
+			stats.RecordConstantBufferUpload(sizeof(viewProjection));
+			mUploadedViewProjection = viewProjection;
+			mViewProjectionUploaded = true;
+		}
+
+		D3D11RenderQueue::DrawItem item = {};
+		item.VertexShader = mVertexShader.Get();
+		item.PixelShader = mPixelShader.Get();
+		item.InputLayout = mInputLayout.Get();
+		item.Topology = mTopology;
+		item.Geometry = &mGeometryBinding;
+		item.Constants = &mConstantBinding;
+		item.IndexCount = IndexCount();
+		item.InstanceCount = 1;
+		D3D11RenderQueue::GetInstance()->Submit(item);
+	}
+
+	// Nothing shows until loading completes, and after that only the camera moves it.
+	bool StaticGeometry::VisualStateChanged() const
+	{
+		if (!mLoadingComplete)
+		{
+			return false;
+		}
+
+		const XMFLOAT4X4 viewProjection = ViewProjection();
+		return !mViewProjectionUploaded || memcmp(&viewProjection, &mUploadedViewProjection, sizeof(viewProjection)) != 0;
+	}
+
+	XMFLOAT4X4 StaticGeometry::ViewProjection() const
+	{
+		XMFLOAT4X4 viewProjection;
+		XMStoreFloat4x4(&viewProjection, XMMatrixTranspose(mCamera->ViewProjectionMatrix()));
+		return viewProjection;
+	}
+}
\ No newline at end of file
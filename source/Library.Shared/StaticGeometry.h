@@ -0,0 +1,62 @@
+#pragma once
+
+#include "DrawableGameComponent.h"
+#include "D3D11RenderQueue.h"
+#include "VertexDeclarations.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace DX
+{
+	// Colored scenery that never moves: walls, titles, anything laid out once. The owner
+	// adds its quads or lines up front; CreateDeviceDependentResources() bakes them into
+	// immutable vertex and index buffers and Render() queues them as one indexed draw.
+	// The geometry is kept on the CPU too, so a device restore rebuilds the buffers without
+	// the owner's help. The view-projection matrix lives in a constant buffer of its own
+	// that is rewritten only when the camera moves, so a steady frame uploads nothing.
+	class StaticGeometry final : public DrawableGameComponent
+	{
+	public:
+		// The indices are 16-bit, so they reach this many vertices; AddQuad() and AddLine()
+		// throw rather than wrap past it.
+		static const std::uint32_t MaxVertexCount;
+
+		// D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST takes AddQuad(), LINELIST takes AddLine().
+		StaticGeometry(const std::shared_ptr<DX::DeviceResources>& deviceResources, const std::shared_ptr<Camera>& camera, D3D11_PRIMITIVE_TOPOLOGY topology);
+		StaticGeometry(const StaticGeometry&) = delete;
+		StaticGeometry& operator=(const StaticGeometry&) = delete;
+		StaticGeometry(StaticGeometry&&) = delete;
+		StaticGeometry& operator=(StaticGeometry&&) = delete;
+		~StaticGeometry() = default;
+
+		void AddQuad(const DirectX::XMFLOAT2& lowerLeft, const DirectX::XMFLOAT2& upperRight, const DirectX::XMFLOAT4& color);
+		void AddLine(const DirectX::XMFLOAT2& from, const DirectX::XMFLOAT2& to, const DirectX::XMFLOAT4& color);
+
+		std::uint32_t VertexCount() const;
+		std::uint32_t IndexCount() const;
+
+		virtual void CreateDeviceDependentResources() override;
+		virtual void ReleaseDeviceDependentResources() override;
+		virtual void Render(const DX::StepTimer& timer) override;
+		virtual bool VisualStateChanged() const override;
+
+	private:
+		DirectX::XMFLOAT4X4 ViewProjection() const;
+
+		Microsoft::WRL::ComPtr<ID3D11VertexShader> mVertexShader;
+		Microsoft::WRL::ComPtr<ID3D11PixelShader> mPixelShader;
+		Microsoft::WRL::ComPtr<ID3D11InputLayout> mInputLayout;
+		Microsoft::WRL::ComPtr<ID3D11Buffer> mVertexBuffer;
+		Microsoft::WRL::ComPtr<ID3D11Buffer> mIndexBuffer;
+		Microsoft::WRL::ComPtr<ID3D11Buffer> mVSCBufferPerObject;
+		D3D11RenderQueue::GeometryBinding mGeometryBinding;
+		D3D11RenderQueue::ConstantBinding mConstantBinding;
+		std::vector<VertexPositionColor> mVertices;
+		std::vector<std::uint16_t> mIndices;
+		D3D11_PRIMITIVE_TOPOLOGY mTopology;
+		DirectX::XMFLOAT4X4 mUploadedViewProjection;
+		bool mViewProjectionUploaded;
+		bool mLoadingComplete;
+	};
+}
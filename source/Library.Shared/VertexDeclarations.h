@@ -18,6 +18,20 @@ namespace DX
 		static const D3D11_INPUT_ELEMENT_DESC InputElements[InputElementCount];
 	};
 
+	// A VertexPosition in slot 0, offset by a per-instance float2 in slot 1.
+	struct VertexPositionInstanceOffset
+	{
+		VertexPositionInstanceOffset() = default;
+
+		VertexPositionInstanceOffset(const DirectX::XMFLOAT4& position) :
+			Position(position) { }
+
+		DirectX::XMFLOAT4 Position;
+
+		static const int InputElementCount = 2;
+		static const D3D11_INPUT_ELEMENT_DESC InputElements[InputElementCount];
+	};
+
 	struct VertexPositionColor
 	{
 		VertexPositionColor() = default;
@@ -32,6 +46,21 @@ namespace DX
 		static const D3D11_INPUT_ELEMENT_DESC InputElements[InputElementCount];
 	};
 
+	// A VertexPositionColor in slot 0, offset per instance by a blend between two float2s in slot 1.
+	struct VertexPositionColorInstanceMotion
+	{
+		VertexPositionColorInstanceMotion() = default;
+
+		VertexPositionColorInstanceMotion(const DirectX::XMFLOAT4& position, const DirectX::XMFLOAT4& color) :
+			Position(position), Color(color) { }
+
+		DirectX::XMFLOAT4 Position;
+		DirectX::XMFLOAT4 Color;
+
+		static const int InputElementCount = 4;
+		static const D3D11_INPUT_ELEMENT_DESC InputElements[InputElementCount];
+	};
+
 	struct VertexPositionTexture
 	{
 		VertexPositionTexture() = default;
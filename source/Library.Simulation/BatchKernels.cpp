@@ -0,0 +1,168 @@
+#include "pch.h"
+#include "BatchKernels.h"
+#include "BatchSimulator.h"
+#include "Board.h"
+
+#if defined(SIMULATION_KERNELS_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+using namespace std;
+
+namespace Simulation
+{
+	namespace
+	{
+		// Indexed by Action
+		const int32_t sDeltaX[] = { 0, 0, 0, -1, 1 };
+		const int32_t sDeltaY[] = { 0, 1, -1, 0, 0 };
+		const Action sOpposites[] = { Action::Continue, Action::Down, Action::Up, Action::Right, Action::Left };
+
+#if defined(SIMULATION_KERNELS_X86)
+		bool DetectSse41()
+		{
+#if defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 1);
+			return (info[2] & (1 << 19)) != 0;
+#else
+			return __builtin_cpu_supports("sse4.1") != 0;
+#endif
+		}
+
+		bool DetectAvx2()
+		{
+#if defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 0);
+			if (info[0] < 7)
+			{
+				return false;
+			}
+
+			// The OS must also save the YMM registers across context switches.
+			__cpuid(info, 1);
+			const bool osxsave = (info[2] & (1 << 27)) != 0;
+			const bool avx = (info[2] & (1 << 28)) != 0;
+			if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+			{
+				return false;
+			}
+
+			__cpuidex(info, 7, 0);
+			return (info[1] & (1 << 5)) != 0;
+#else
+			return __builtin_cpu_supports("avx2") != 0;
+#endif
+		}
+#endif
+	}
+
+	const char* KernelSetName(KernelSet kernelSet)
+	{
+		switch (kernelSet)
+		{
+		case KernelSet::Sse41:
+			return "SSE4.1";
+		case KernelSet::Avx2:
+			return "AVX2";
+		case KernelSet::Neon:
+			return "NEON";
+		default:
+			return "Scalar";
+		}
+	}
+
+	bool IsKernelSetSupported(KernelSet kernelSet)
+	{
+		switch (kernelSet)
+		{
+		case KernelSet::Scalar:
+			return true;
+#if defined(SIMULATION_KERNELS_X86)
+		case KernelSet::Sse41:
+		{
+			static const bool supported = DetectSse41();
+			return supported;
+		}
+		case KernelSet::Avx2:
+		{
+			static const bool supported = DetectAvx2();
+			return supported;
+		}
+#elif defined(SIMULATION_KERNELS_NEON)
+		case KernelSet::Neon:
+			return true;
+#endif
+		default:
+			return false;
+		}
+	}
+
+	KernelSet BestKernelSet()
+	{
+		const KernelSet preferred[] = { KernelSet::Avx2, KernelSet::Neon, KernelSet::Sse41 };
+		for (KernelSet kernelSet : preferred)
+		{
+			if (IsKernelSetSupported(kernelSet))
+			{
+				return kernelSet;
+			}
+		}
+
+		return KernelSet::Scalar;
+	}
+
+	StepKernel GetStepKernel(KernelSet kernelSet)
+	{
+		if (!IsKernelSetSupported(kernelSet))
+		{
+			return ScalarStepKernel;
+		}
+
+		switch (kernelSet)
+		{
+#if defined(SIMULATION_KERNELS_X86)
+		case KernelSet::Sse41:
+			return Sse41StepKernel;
+		case KernelSet::Avx2:
+			return Avx2StepKernel;
+#elif defined(SIMULATION_KERNELS_NEON)
+		case KernelSet::Neon:
+			return NeonStepKernel;
+#endif
+		default:
+			return ScalarStepKernel;
+		}
+	}
+
+	void ScalarStepKernel(const StepLanes& lanes, uint32_t begin, uint32_t end)
+	{
+		for (uint32_t game = begin; game < end; game++)
+		{
+			// Reversing onto the body is ignored, as it is for the interactive snake.
+			const Action action = lanes.Actions[game];
+			Action heading = lanes.Headings[game];
+			if (action != Action::Continue && (lanes.Lengths[game] == 1 || action != sOpposites[static_cast<uint32_t>(heading)]))
+			{
+				heading = action;
+			}
+			lanes.Headings[game] = heading;
+
+			const int32_t x = lanes.HeadX[game] + sDeltaX[static_cast<uint32_t>(heading)];
+			const int32_t y = lanes.HeadY[game] + sDeltaY[static_cast<uint32_t>(heading)];
+			const uint16_t cell = static_cast<uint16_t>(y * Board::Width + x);
+			lanes.NextX[game] = static_cast<int16_t>(x);
+			lanes.NextY[game] = static_cast<int16_t>(y);
+			lanes.NextCells[game] = cell;
+
+			uint8_t events = 0;
+			if (heading != Action::Continue)
+			{
+				const bool inside = static_cast<uint32_t>(x) < static_cast<uint32_t>(Board::Width) && static_cast<uint32_t>(y) < static_cast<uint32_t>(Board::Height);
+				events = StepLanes::MovedFlag | (inside ? 0 : StepLanes::WallFlag) | (inside && cell == lanes.Food[game] ? StepLanes::FoodFlag : 0);
+			}
+			lanes.Events[game] = events;
+		}
+	}
+}
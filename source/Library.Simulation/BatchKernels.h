@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SIMULATION_KERNELS_X86
+#elif defined(_M_ARM) || defined(_M_ARM64) || defined(__ARM_NEON)
+#define SIMULATION_KERNELS_NEON
+#endif
+
+namespace Simulation
+{
+	enum class Action : std::uint8_t;
+
+	// Per-game columns read and written by the step kernel. Every pointer addresses the
+	// same game index; the kernel handles the lane-parallel part of a tick (steering, moving
+	// the head, wall and food tests) and leaves the body update to BatchSimulator.
+	struct StepLanes final
+	{
+		static const std::uint8_t MovedFlag = 0x01;
+		static const std::uint8_t WallFlag = 0x02;
+		static const std::uint8_t FoodFlag = 0x04;
+
+		const Action* Actions;
+		Action* Headings;
+		const std::uint16_t* Lengths;
+		const std::int16_t* HeadX;
+		const std::int16_t* HeadY;
+		const std::uint16_t* Food;
+
+		std::int16_t* NextX;
+		std::int16_t* NextY;
+		std::uint16_t* NextCells;
+		std::uint8_t* Events;
+	};
+
+	// Processes games [begin, end).
+	typedef void (*StepKernel)(const StepLanes& lanes, std::uint32_t begin, std::uint32_t end);
+
+	enum class KernelSet
+	{
+		Scalar, Sse41, Avx2, Neon
+	};
+
+	const char* KernelSetName(KernelSet kernelSet);
+	bool IsKernelSetSupported(KernelSet kernelSet);
+	KernelSet BestKernelSet();
+
+	// Falls back to the scalar kernel when the set is not supported on this machine.
+	StepKernel GetStepKernel(KernelSet kernelSet);
+
+	void ScalarStepKernel(const StepLanes& lanes, std::uint32_t begin, std::uint32_t end);
+
+#if defined(SIMULATION_KERNELS_X86)
+	void Sse41StepKernel(const StepLanes& lanes, std::uint32_t begin, std::uint32_t end);
+	void Avx2StepKernel(const StepLanes& lanes, std::uint32_t begin, std::uint32_t end);
+#elif defined(SIMULATION_KERNELS_NEON)
+	void NeonStepKernel(const StepLanes& lanes, std::uint32_t begin, std::uint32_t end);
+#endif
+}
@@ -0,0 +1,82 @@
+#include "pch.h"
+#include "BatchKernels.h"
+#include "BatchSimulator.h"
+#include "Board.h"
+
+#if defined(SIMULATION_KERNELS_X86)
+#include <immintrin.h>
+
+using namespace std;
+
+namespace Simulation
+{
+	namespace
+	{
+		// Narrows 16 words to bytes. packus works within each 128-bit half, so gather the
+		// two useful quadwords back together before storing.
+		inline void StoreBytes(uint8_t* destination, __m256i words)
+		{
+			const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(words, words), _MM_SHUFFLE(3, 1, 2, 0));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination), _mm256_castsi256_si128(packed));
+		}
+	}
+
+	// Sixteen games per iteration, one 16-bit lane each; mirrors ScalarStepKernel.
+	void Avx2StepKernel(const StepLanes& lanes, uint32_t begin, uint32_t end)
+	{
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i ones = _mm256_set1_epi16(-1);
+		const __m256i one = _mm256_set1_epi16(1);
+		const __m256i up = _mm256_set1_epi16(static_cast<int16_t>(Action::Up));
+		const __m256i down = _mm256_set1_epi16(static_cast<int16_t>(Action::Down));
+		const __m256i left = _mm256_set1_epi16(static_cast<int16_t>(Action::Left));
+		const __m256i right = _mm256_set1_epi16(static_cast<int16_t>(Action::Right));
+		const __m256i width = _mm256_set1_epi16(static_cast<int16_t>(Board::Width));
+		const __m256i lastColumn = _mm256_set1_epi16(static_cast<int16_t>(Board::Width - 1));
+		const __m256i lastRow = _mm256_set1_epi16(static_cast<int16_t>(Board::Height - 1));
+		const __m256i movedFlag = _mm256_set1_epi16(StepLanes::MovedFlag);
+		const __m256i wallFlag = _mm256_set1_epi16(StepLanes::WallFlag);
+		const __m256i foodFlag = _mm256_set1_epi16(StepLanes::FoodFlag);
+
+		uint32_t game = begin;
+		for (; game + 16 <= end; game += 16)
+		{
+			const __m256i action = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes.Actions + game)));
+			__m256i heading = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes.Headings + game)));
+			const __m256i length = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes.Lengths + game));
+			const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes.HeadX + game));
+			const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes.HeadY + game));
+			const __m256i food = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes.Food + game));
+
+			// Opposite of Up/Down/Left/Right is ((heading - 1) ^ 1) + 1; Continue maps to a value no action takes.
+			const __m256i opposite = _mm256_add_epi16(_mm256_xor_si256(_mm256_sub_epi16(heading, one), one), one);
+			const __m256i reverse = _mm256_andnot_si256(_mm256_cmpeq_epi16(length, one), _mm256_cmpeq_epi16(action, opposite));
+			const __m256i turn = _mm256_andnot_si256(_mm256_or_si256(_mm256_cmpeq_epi16(action, zero), reverse), ones);
+			heading = _mm256_blendv_epi8(heading, action, turn);
+			StoreBytes(reinterpret_cast<uint8_t*>(lanes.Headings + game), heading);
+
+			// Comparison masks are -1, so subtracting them yields the unit step.
+			const __m256i dx = _mm256_sub_epi16(_mm256_cmpeq_epi16(heading, left), _mm256_cmpeq_epi16(heading, right));
+			const __m256i dy = _mm256_sub_epi16(_mm256_cmpeq_epi16(heading, down), _mm256_cmpeq_epi16(heading, up));
+			const __m256i nextX = _mm256_add_epi16(x, dx);
+			const __m256i nextY = _mm256_add_epi16(y, dy);
+			const __m256i cell = _mm256_add_epi16(_mm256_mullo_epi16(nextY, width), nextX);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes.NextX + game), nextX);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes.NextY + game), nextY);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes.NextCells + game), cell);
+
+			// Negative coordinates are huge when unsigned, so one unsigned min per axis checks both walls.
+			const __m256i inside = _mm256_and_si256(
+				_mm256_cmpeq_epi16(_mm256_min_epu16(nextX, lastColumn), nextX),
+				_mm256_cmpeq_epi16(_mm256_min_epu16(nextY, lastRow), nextY));
+			const __m256i ate = _mm256_and_si256(inside, _mm256_cmpeq_epi16(cell, food));
+			const __m256i moved = _mm256_andnot_si256(_mm256_cmpeq_epi16(heading, zero), ones);
+			const __m256i events = _mm256_and_si256(moved, _mm256_or_si256(movedFlag,
+				_mm256_or_si256(_mm256_andnot_si256(inside, wallFlag), _mm256_and_si256(ate, foodFlag))));
+			StoreBytes(lanes.Events + game, events);
+		}
+
+		ScalarStepKernel(lanes, game, end);
+	}
+}
+#endif
@@ -0,0 +1,67 @@
+#include "pch.h"
+#include "BatchKernels.h"
+#include "BatchSimulator.h"
+#include "Board.h"
+
+#if defined(SIMULATION_KERNELS_NEON)
+#include <arm_neon.h>
+
+using namespace std;
+
+namespace Simulation
+{
+	// Eight games per iteration, one 16-bit lane each; mirrors ScalarStepKernel. Coordinates
+	// are handled as unsigned words, which wrap exactly like the signed values they hold.
+	void NeonStepKernel(const StepLanes& lanes, uint32_t begin, uint32_t end)
+	{
+		const uint16x8_t zero = vdupq_n_u16(0);
+		const uint16x8_t one = vdupq_n_u16(1);
+		const uint16x8_t up = vdupq_n_u16(static_cast<uint16_t>(Action::Up));
+		const uint16x8_t down = vdupq_n_u16(static_cast<uint16_t>(Action::Down));
+		const uint16x8_t left = vdupq_n_u16(static_cast<uint16_t>(Action::Left));
+		const uint16x8_t right = vdupq_n_u16(static_cast<uint16_t>(Action::Right));
+		const uint16x8_t width = vdupq_n_u16(static_cast<uint16_t>(Board::Width));
+		const uint16x8_t lastColumn = vdupq_n_u16(static_cast<uint16_t>(Board::Width - 1));
+		const uint16x8_t lastRow = vdupq_n_u16(static_cast<uint16_t>(Board::Height - 1));
+		const uint16x8_t movedFlag = vdupq_n_u16(StepLanes::MovedFlag);
+		const uint16x8_t wallFlag = vdupq_n_u16(StepLanes::WallFlag);
+		const uint16x8_t foodFlag = vdupq_n_u16(StepLanes::FoodFlag);
+
+		uint32_t game = begin;
+		for (; game + 8 <= end; game += 8)
+		{
+			const uint16x8_t action = vmovl_u8(vld1_u8(reinterpret_cast<const uint8_t*>(lanes.Actions + game)));
+			uint16x8_t heading = vmovl_u8(vld1_u8(reinterpret_cast<const uint8_t*>(lanes.Headings + game)));
+			const uint16x8_t length = vld1q_u16(lanes.Lengths + game);
+			const uint16x8_t x = vreinterpretq_u16_s16(vld1q_s16(lanes.HeadX + game));
+			const uint16x8_t y = vreinterpretq_u16_s16(vld1q_s16(lanes.HeadY + game));
+			const uint16x8_t food = vld1q_u16(lanes.Food + game);
+
+			const uint16x8_t opposite = vaddq_u16(veorq_u16(vsubq_u16(heading, one), one), one);
+			const uint16x8_t reverse = vbicq_u16(vceqq_u16(action, opposite), vceqq_u16(length, one));
+			const uint16x8_t turn = vmvnq_u16(vorrq_u16(vceqq_u16(action, zero), reverse));
+			heading = vbslq_u16(turn, action, heading);
+			vst1_u8(reinterpret_cast<uint8_t*>(lanes.Headings + game), vmovn_u16(heading));
+
+			// Comparison masks are all ones, so subtracting them yields the unit step.
+			const uint16x8_t dx = vsubq_u16(vceqq_u16(heading, left), vceqq_u16(heading, right));
+			const uint16x8_t dy = vsubq_u16(vceqq_u16(heading, down), vceqq_u16(heading, up));
+			const uint16x8_t nextX = vaddq_u16(x, dx);
+			const uint16x8_t nextY = vaddq_u16(y, dy);
+			const uint16x8_t cell = vmlaq_u16(nextX, nextY, width);
+			vst1q_s16(lanes.NextX + game, vreinterpretq_s16_u16(nextX));
+			vst1q_s16(lanes.NextY + game, vreinterpretq_s16_u16(nextY));
+			vst1q_u16(lanes.NextCells + game, cell);
+
+			const uint16x8_t inside = vandq_u16(vcleq_u16(nextX, lastColumn), vcleq_u16(nextY, lastRow));
+			const uint16x8_t ate = vandq_u16(inside, vceqq_u16(cell, food));
+			const uint16x8_t moved = vmvnq_u16(vceqq_u16(heading, zero));
+			const uint16x8_t events = vandq_u16(moved, vorrq_u16(movedFlag,
+				vorrq_u16(vbicq_u16(wallFlag, inside), vandq_u16(ate, foodFlag))));
+			vst1_u8(lanes.Events + game, vmovn_u16(events));
+		}
+
+		ScalarStepKernel(lanes, game, end);
+	}
+}
+#endif
@@ -0,0 +1,81 @@
+#include "pch.h"
+#include "BatchKernels.h"
+#include "BatchSimulator.h"
+#include "Board.h"
+
+#if defined(SIMULATION_KERNELS_X86)
+#include <smmintrin.h>
+
+using namespace std;
+
+namespace Simulation
+{
+	namespace
+	{
+		inline __m128i LoadBytes(const void* source)
+		{
+			return _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(source)));
+		}
+
+		inline void StoreBytes(void* destination, __m128i words)
+		{
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(destination), _mm_packus_epi16(words, words));
+		}
+	}
+
+	// Eight games per iteration, one 16-bit lane each; mirrors ScalarStepKernel.
+	void Sse41StepKernel(const StepLanes& lanes, uint32_t begin, uint32_t end)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i ones = _mm_set1_epi16(-1);
+		const __m128i one = _mm_set1_epi16(1);
+		const __m128i up = _mm_set1_epi16(static_cast<int16_t>(Action::Up));
+		const __m128i down = _mm_set1_epi16(static_cast<int16_t>(Action::Down));
+		const __m128i left = _mm_set1_epi16(static_cast<int16_t>(Action::Left));
+		const __m128i right = _mm_set1_epi16(static_cast<int16_t>(Action::Right));
+		const __m128i width = _mm_set1_epi16(static_cast<int16_t>(Board::Width));
+		const __m128i lastColumn = _mm_set1_epi16(static_cast<int16_t>(Board::Width - 1));
+		const __m128i lastRow = _mm_set1_epi16(static_cast<int16_t>(Board::Height - 1));
+		const __m128i movedFlag = _mm_set1_epi16(StepLanes::MovedFlag);
+		const __m128i wallFlag = _mm_set1_epi16(StepLanes::WallFlag);
+		const __m128i foodFlag = _mm_set1_epi16(StepLanes::FoodFlag);
+
+		uint32_t game = begin;
+		for (; game + 8 <= end; game += 8)
+		{
+			const __m128i action = LoadBytes(lanes.Actions + game);
+			__m128i heading = LoadBytes(lanes.Headings + game);
+			const __m128i length = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes.Lengths + game));
+			const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes.HeadX + game));
+			const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes.HeadY + game));
+			const __m128i food = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes.Food + game));
+
+			const __m128i opposite = _mm_add_epi16(_mm_xor_si128(_mm_sub_epi16(heading, one), one), one);
+			const __m128i reverse = _mm_andnot_si128(_mm_cmpeq_epi16(length, one), _mm_cmpeq_epi16(action, opposite));
+			const __m128i turn = _mm_andnot_si128(_mm_or_si128(_mm_cmpeq_epi16(action, zero), reverse), ones);
+			heading = _mm_blendv_epi8(heading, action, turn);
+			StoreBytes(lanes.Headings + game, heading);
+
+			const __m128i dx = _mm_sub_epi16(_mm_cmpeq_epi16(heading, left), _mm_cmpeq_epi16(heading, right));
+			const __m128i dy = _mm_sub_epi16(_mm_cmpeq_epi16(heading, down), _mm_cmpeq_epi16(heading, up));
+			const __m128i nextX = _mm_add_epi16(x, dx);
+			const __m128i nextY = _mm_add_epi16(y, dy);
+			const __m128i cell = _mm_add_epi16(_mm_mullo_epi16(nextY, width), nextX);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes.NextX + game), nextX);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes.NextY + game), nextY);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes.NextCells + game), cell);
+
+			const __m128i inside = _mm_and_si128(
+				_mm_cmpeq_epi16(_mm_min_epu16(nextX, lastColumn), nextX),
+				_mm_cmpeq_epi16(_mm_min_epu16(nextY, lastRow), nextY));
+			const __m128i ate = _mm_and_si128(inside, _mm_cmpeq_epi16(cell, food));
+			const __m128i moved = _mm_andnot_si128(_mm_cmpeq_epi16(heading, zero), ones);
+			const __m128i events = _mm_and_si128(moved, _mm_or_si128(movedFlag,
+				_mm_or_si128(_mm_andnot_si128(inside, wallFlag), _mm_and_si128(ate, foodFlag))));
+			StoreBytes(lanes.Events + game, events);
+		}
+
+		ScalarStepKernel(lanes, game, end);
+	}
+}
+#endif
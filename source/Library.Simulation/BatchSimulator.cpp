@@ -0,0 +1,248 @@
+#include "pch.h"
+#include "BatchSimulator.h"
+#include "Board.h"
+#include "Random.h"
+#include "Snake.h"
+
+using namespace std;
+
+namespace Simulation
+{
+	const float BatchSimulator::FoodReward = 1.0f;
+	const float BatchSimulator::DeathReward = -1.0f;
+
+	namespace
+	{
+		const uint32_t CellCount = static_cast<uint32_t>(Board::CellCount);
+		const uint32_t FoodSamples = 8;
+
+		// Multiply-shift, as FreeCellSet::Sample: the full 32-bit range onto [0, count).
+		inline uint32_t Scale(uint32_t random, uint32_t count)
+		{
+			return static_cast<uint32_t>((static_cast<uint64_t>(random) * count) >> 32);
+		}
+	}
+
+	BatchSimulator::BatchSimulator(uint32_t gameCount, uint32_t seed) :
+		mGameCount(gameCount), mKernelSet(BestKernelSet()), mStepKernel(GetStepKernel(mKernelSet)),
+		mHeadX(gameCount), mHeadY(gameCount), mHeadings(gameCount), mLengths(gameCount),
+		mPendingGrowth(gameCount), mBodyFronts(gameCount), mFood(gameCount), mAlive(gameCount), mRandom(gameCount),
+		mNextX(gameCount), mNextY(gameCount), mNextCells(gameCount), mEvents(gameCount),
+		mBodies(static_cast<size_t>(gameCount) * CellCount), mOccupancy(static_cast<size_t>(gameCount) * CellCount)
+	{
+		for (uint32_t game = 0; game < mGameCount; game++)
+		{
+			mRandom[game] = Random(seed + game).State();
+		}
+
+		ResetAll();
+	}
+
+	uint32_t BatchSimulator::GameCount() const
+	{
+		return mGameCount;
+	}
+
+	KernelSet BatchSimulator::ActiveKernelSet() const
+	{
+		return mKernelSet;
+	}
+
+	void BatchSimulator::SetKernelSet(KernelSet kernelSet)
+	{
+		mKernelSet = IsKernelSetSupported(kernelSet) ? kernelSet : KernelSet::Scalar;
+		mStepKernel = GetStepKernel(mKernelSet);
+	}
+
+	void BatchSimulator::StepAll(const Action* actions, float* rewards, uint8_t* dones)
+	{
+		for (uint32_t game = 0; game < mGameCount; game++)
+		{
+			if (mAlive[game] == 0)
+			{
+				Reset(game);
+			}
+		}
+
+		StepLanes lanes;
+		lanes.Actions = actions;
+		lanes.Headings = mHeadings.data();
+		lanes.Lengths = mLengths.data();
+		lanes.HeadX = mHeadX.data();
+		lanes.HeadY = mHeadY.data();
+		lanes.Food = mFood.data();
+		lanes.NextX = mNextX.data();
+		lanes.NextY = mNextY.data();
+		lanes.NextCells = mNextCells.data();
+		lanes.Events = mEvents.data();
+		mStepKernel(lanes, 0, mGameCount);
+
+		for (uint32_t game = 0; game < mGameCount; game++)
+		{
+			rewards[game] = 0.0f;
+			dones[game] = 0;
+
+			const uint8_t events = mEvents[game];
+			if ((events & StepLanes::MovedFlag) == 0)
+			{
+				continue;
+			}
+
+			// Handle boundary collisions
+			if ((events & StepLanes::WallFlag) != 0)
+			{
+				mAlive[game] = 0;
+				rewards[game] = DeathReward;
+				dones[game] = 1;
+				continue;
+			}
+
+			AdvanceBody(game, rewards[game], dones[game]);
+		}
+	}
+
+	void BatchSimulator::Reset(uint32_t game)
+	{
+		assert(game < mGameCount);
+
+		const Cell center = Board::Center();
+		const uint16_t centerIndex = static_cast<uint16_t>(Board::CellIndex(center));
+		uint8_t* occupancy = &mOccupancy[static_cast<size_t>(game) * CellCount];
+
+		mHeadX[game] = center.x;
+		mHeadY[game] = center.y;
+		mHeadings[game] = Action::Continue;
+		mLengths[game] = 1;
+		mPendingGrowth[game] = 0;
+		mBodyFronts[game] = 0;
+		mBodies[static_cast<size_t>(game) * CellCount] = centerIndex;
+		memset(occupancy, 0, CellCount);
+		occupancy[centerIndex] = 1;
+		mAlive[game] = 1;
+
+		PlaceFood(game);
+	}
+
+	void BatchSimulator::ResetAll()
+	{
+		for (uint32_t game = 0; game < mGameCount; game++)
+		{
+			Reset(game);
+		}
+	}
+
+	Cell BatchSimulator::Head(uint32_t game) const
+	{
+		return Cell(mHeadX[game], mHeadY[game]);
+	}
+
+	Action BatchSimulator::Heading(uint32_t game) const
+	{
+		return mHeadings[game];
+	}
+
+	uint32_t BatchSimulator::Length(uint32_t game) const
+	{
+		return mLengths[game];
+	}
+
+	Cell BatchSimulator::Food(uint32_t game) const
+	{
+		return Cell(mFood[game] % Board::Width, mFood[game] / Board::Width);
+	}
+
+	bool BatchSimulator::Alive(uint32_t game) const
+	{
+		return mAlive[game] != 0;
+	}
+
+	Cell BatchSimulator::BodyAt(uint32_t game, uint32_t index) const
+	{
+		assert(index < mLengths[game]);
+
+		const uint16_t cell = mBodies[static_cast<size_t>(game) * CellCount + (mBodyFronts[game] + CellCount - index) % CellCount];
+		return Cell(cell % Board::Width, cell / Board::Width);
+	}
+
+	void BatchSimulator::AdvanceBody(uint32_t game, float& reward, uint8_t& done)
+	{
+		const uint16_t cell = mNextCells[game];
+		uint16_t* body = &mBodies[static_cast<size_t>(game) * CellCount];
+		uint8_t* occupancy = &mOccupancy[static_cast<size_t>(game) * CellCount];
+
+		// Grow into the new cell, or vacate the end of the tail before checking the head so
+		// that chasing the tail is legal.
+		uint32_t length = mLengths[game];
+		uint32_t front = mBodyFronts[game];
+		if (mPendingGrowth[game] > 0 && length < CellCount)
+		{
+			--mPendingGrowth[game];
+			++length;
+		}
+		else
+		{
+			occupancy[body[(front + CellCount - (length - 1)) % CellCount]] = 0;
+		}
+
+		// Handle body collisions
+		if (occupancy[cell] != 0)
+		{
+			mAlive[game] = 0;
+			reward = DeathReward;
+			done = 1;
+			return;
+		}
+
+		mHeadX[game] = mNextX[game];
+		mHeadY[game] = mNextY[game];
+		front = front + 1 < CellCount ? front + 1 : 0;
+		body[front] = cell;
+		occupancy[cell] = 1;
+		mBodyFronts[game] = static_cast<uint16_t>(front);
+		mLengths[game] = static_cast<uint16_t>(length);
+
+		// Handle food collisions. A snake filling the whole board has nowhere left to go.
+		if ((mEvents[game] & StepLanes::FoodFlag) != 0)
+		{
+			reward = FoodReward;
+			mPendingGrowth[game] = static_cast<uint16_t>(min<uint32_t>(mPendingGrowth[game] + Snake::GrowthPerPowerup, CellCount));
+			if (!PlaceFood(game))
+			{
+				mAlive[game] = 0;
+				done = 1;
+			}
+		}
+	}
+
+	bool BatchSimulator::PlaceFood(uint32_t game)
+	{
+		const uint32_t freeCount = CellCount - mLengths[game];
+		if (freeCount == 0)
+		{
+			return false;
+		}
+
+		// Sampling almost always lands on a free cell. On crowded boards, fall back to counting
+		// through the free cells to a random one, so every free cell stays equally likely.
+		const uint8_t* occupancy = &mOccupancy[static_cast<size_t>(game) * CellCount];
+		uint32_t& random = mRandom[game];
+		for (uint32_t i = 0; i < FoodSamples; i++)
+		{
+			const uint32_t cell = Scale(Random::Next(random), CellCount);
+			if (occupancy[cell] == 0)
+			{
+				mFood[game] = static_cast<uint16_t>(cell);
+				return true;
+			}
+		}
+
+		uint32_t cell = 0;
+		for (uint32_t skip = Scale(Random::Next(random), freeCount); occupancy[cell] != 0 || skip > 0; cell++)
+		{
+			skip -= occupancy[cell] == 0 ? 1 : 0;
+		}
+
+		mFood[game] = static_cast<uint16_t>(cell);
+		return true;
+	}
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "BatchKernels.h"
+#include "Cell.h"
+#include <cstdint>
+#include <vector>
+
+namespace Simulation
+{
+	// Input for one game for one tick. Continue keeps the current heading.
+	enum class Action : std::uint8_t
+	{
+		Continue, Up, Down, Left, Right
+	};
+
+	// Runs many independent games side by side for training and balance testing. Every
+	// per-game field lives in its own array indexed by game, so StepAll() walks memory
+	// linearly and no game owns any heap allocation of its own.
+	//
+	// The rules match Game: the snake starts stopped in the center, eating food grows it by
+	// Snake::GrowthPerPowerup segments, and leaving the board or running into its own body
+	// ends the game. A single food item is respawned on a uniformly random free cell.
+	//
+	// A finished game keeps its terminal state until the next StepAll(), which restarts it
+	// before applying that tick's action.
+	//
+	// Steering, the head move and the wall and food tests run for all games at once through
+	// a SIMD kernel chosen at construction from the CPU's features; growing and retracting
+	// the body is scattered memory access and stays scalar.
+	class BatchSimulator final
+	{
+	public:
+		static const float FoodReward;
+		static const float DeathReward;
+
+		explicit BatchSimulator(std::uint32_t gameCount, std::uint32_t seed = 1);
+		BatchSimulator(const BatchSimulator&) = default;
+		BatchSimulator& operator=(const BatchSimulator&) = default;
+		BatchSimulator(BatchSimulator&&) = default;
+		BatchSimulator& operator=(BatchSimulator&&) = default;
+		~BatchSimulator() = default;
+
+		std::uint32_t GameCount() const;
+		KernelSet ActiveKernelSet() const;
+		void SetKernelSet(KernelSet kernelSet);
+
+		// actions, rewards and dones each hold GameCount() entries. dones[i] is set to 1 when
+		// game i ended on this tick and 0 otherwise.
+		void StepAll(const Action* actions, float* rewards, std::uint8_t* dones);
+		void Reset(std::uint32_t game);
+		void ResetAll();
+
+		Cell Head(std::uint32_t game) const;
+		Action Heading(std::uint32_t game) const;
+		std::uint32_t Length(std::uint32_t game) const;
+		Cell Food(std::uint32_t game) const;
+		bool Alive(std::uint32_t game) const;
+
+		// Index 0 is the head, Length() - 1 the end of the tail.
+		Cell BodyAt(std::uint32_t game, std::uint32_t index) const;
+
+	private:
+		void AdvanceBody(std::uint32_t game, float& reward, std::uint8_t& done);
+		bool PlaceFood(std::uint32_t game);
+
+		std::uint32_t mGameCount;
+		KernelSet mKernelSet;
+		StepKernel mStepKernel;
+
+		// Per game
+		std::vector<std::int16_t> mHeadX;
+		std::vector<std::int16_t> mHeadY;
+		std::vector<Action> mHeadings;
+		std::vector<std::uint16_t> mLengths;
+		std::vector<std::uint16_t> mPendingGrowth;
+		std::vector<std::uint16_t> mBodyFronts;
+		std::vector<std::uint16_t> mFood;
+		std::vector<std::uint8_t> mAlive;
+		std::vector<std::uint32_t> mRandom;
+
+		// Per game, written by the step kernel each tick
+		std::vector<std::int16_t> mNextX;
+		std::vector<std::int16_t> mNextY;
+		std::vector<std::uint16_t> mNextCells;
+		std::vector<std::uint8_t> mEvents;
+
+		// Per game, Board::CellCount entries each: the body as a ring of cell indices and
+		// a flag per cell marking the cells the body covers.
+		std::vector<std::uint16_t> mBodies;
+		std::vector<std::uint8_t> mOccupancy;
+	};
+}
@@ -0,0 +1,52 @@
+#include "pch.h"
+#include "Board.h"
+
+using namespace std;
+
+namespace Simulation
+{
+	const int32_t Board::Width;
+	const int32_t Board::Height;
+	const int32_t Board::CellSize;
+	const int32_t Board::CellCount;
+
+	float Board::Left()
+	{
+		return static_cast<float>(-(Width / 2) * CellSize);
+	}
+
+	float Board::Right()
+	{
+		return static_cast<float>((Width - Width / 2) * CellSize);
+	}
+
+	float Board::Bottom()
+	{
+		return static_cast<float>(-(Height / 2) * CellSize);
+	}
+
+	float Board::Top()
+	{
+		return static_cast<float>((Height - Height / 2) * CellSize);
+	}
+
+	bool Board::Contains(const Cell& cell)
+	{
+		return static_cast<uint32_t>(cell.x) < static_cast<uint32_t>(Width) && static_cast<uint32_t>(cell.y) < static_cast<uint32_t>(Height);
+	}
+
+	uint32_t Board::CellIndex(const Cell& cell)
+	{
+		return static_cast<uint32_t>(cell.y * Width + cell.x);
+	}
+
+	Cell Board::Center()
+	{
+		return Cell(Width / 2, Height / 2);
+	}
+
+	Vector2f Board::ToWorld(const Cell& cell)
+	{
+		return Vector2f((cell.x - Width / 2) * CellSize, (cell.y - Height / 2) * CellSize);
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Cell.h"
+#include "StructDefinitions.h"
+#include <cstdint>
+
+namespace Simulation
+{
+	// Dimensions of the playing field. The board is Width x Height cells; in world space
+	// each cell is CellSize units wide and the board is centered on the origin.
+	class Board final
+	{
+	public:
+		static const std::int32_t Width = 54;
+		static const std::int32_t Height = 26;
+		static const std::int32_t CellSize = 25;
+		static const std::int32_t CellCount = Width * Height;
+
+		static_assert(Width > 0 && Width <= Cell::MaxExtent && Height > 0 && Height <= Cell::MaxExtent, "The board must fit Cell's 16-bit coordinates.");
+
+		static float Left();
+		static float Right();
+		static float Bottom();
+		static float Top();
+
+		static bool Contains(const Cell& cell);
+		static std::uint32_t CellIndex(const Cell& cell);
+		static Cell Center();
+
+		// Bottom-left corner of the cell in world space.
+		static Vector2f ToWorld(const Cell& cell);
+
+		Board() = delete;
+		Board(const Board&) = delete;
+		Board& operator=(const Board&) = delete;
+		Board(Board&&) = delete;
+		Board& operator=(Board&&) = delete;
+		~Board() = default;
+	};
+}
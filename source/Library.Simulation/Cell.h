@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Simulation
+{
+	// A board cell in integer grid coordinates, (0, 0) being the bottom-left cell. All
+	// gameplay state is kept in cells so comparisons are exact and the simulation is
+	// reproducible bit for bit; conversion to world space only happens when rendering.
+	struct Cell final
+	{
+		// The most cells a board or arena can be across, so that its cells and the ones just
+		// past its edges all fit in the coordinates.
+		static const std::int32_t MaxExtent = INT16_MAX;
+
+		std::int16_t x;
+		std::int16_t y;
+
+		Cell() = default;
+
+		Cell(std::int32_t _x, std::int32_t _y) :
+			x(static_cast<std::int16_t>(_x)), y(static_cast<std::int16_t>(_y))
+		{
+		}
+
+		Cell operator+(const Cell& rhs) const
+		{
+			return Cell(x + rhs.x, y + rhs.y);
+		}
+
+		Cell& operator+=(const Cell& rhs)
+		{
+			x = static_cast<std::int16_t>(x + rhs.x);
+			y = static_cast<std::int16_t>(y + rhs.y);
+			return (*this);
+		}
+
+		bool operator==(const Cell& rhs) const
+		{
+			return Key() == rhs.Key();
+		}
+
+		bool operator!=(const Cell& rhs) const
+		{
+			return Key() != rhs.Key();
+		}
+
+		// Both coordinates packed into one word, for hashing and single-compare equality.
+		std::uint32_t Key() const
+		{
+			return static_cast<std::uint32_t>(static_cast<std::uint16_t>(x)) | (static_cast<std::uint32_t>(static_cast<std::uint16_t>(y)) << 16);
+		}
+	};
+}
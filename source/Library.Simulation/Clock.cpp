@@ -0,0 +1,52 @@
+#include "pch.h"
+#include "Clock.h"
+#include <chrono>
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+using namespace std;
+
+namespace Simulation
+{
+	shared_ptr<Clock> Clock::CreateDefault()
+	{
+#if defined(_WIN32)
+		return make_shared<QpcClock>();
+#else
+		return make_shared<SteadyClock>();
+#endif
+	}
+
+	uint64_t SteadyClock::Now() const
+	{
+		return static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	uint64_t SteadyClock::Frequency() const
+	{
+		return 1000000000;
+	}
+
+#if defined(_WIN32)
+	QpcClock::QpcClock()
+	{
+		LARGE_INTEGER frequency;
+		QueryPerformanceFrequency(&frequency);
+		mFrequency = static_cast<uint64_t>(frequency.QuadPart);
+	}
+
+	uint64_t QpcClock::Now() const
+	{
+		LARGE_INTEGER now;
+		QueryPerformanceCounter(&now);
+		return static_cast<uint64_t>(now.QuadPart);
+	}
+
+	uint64_t QpcClock::Frequency() const
+	{
+		return mFrequency;
+	}
+#endif
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+namespace Simulation
+{
+	// A source of time for GameTimer: a running count of ticks and how many ticks make a
+	// second. Only differences between readings mean anything.
+	class Clock
+	{
+	public:
+		// The performance counter on Windows, std::chrono::steady_clock elsewhere.
+		static std::shared_ptr<Clock> CreateDefault();
+
+		Clock() = default;
+		Clock(const Clock&) = default;
+		Clock& operator=(const Clock&) = default;
+		Clock(Clock&&) = default;
+		Clock& operator=(Clock&&) = default;
+		virtual ~Clock() = default;
+
+		virtual std::uint64_t Now() const = 0;
+		virtual std::uint64_t Frequency() const = 0;
+	};
+
+	// std::chrono::steady_clock, in nanoseconds.
+	class SteadyClock final : public Clock
+	{
+	public:
+		virtual std::uint64_t Now() const override;
+		virtual std::uint64_t Frequency() const override;
+	};
+
+#if defined(_WIN32)
+	// QueryPerformanceCounter, which never fails on any Windows the game runs on.
+	class QpcClock final : public Clock
+	{
+	public:
+		QpcClock();
+
+		virtual std::uint64_t Now() const override;
+		virtual std::uint64_t Frequency() const override;
+
+	private:
+		std::uint64_t mFrequency;
+	};
+#endif
+
+	// Time that only passes when told to, for driving a game faster than real time with
+	// exactly reproducible frames.
+	class VirtualClock final : public Clock
+	{
+	public:
+		explicit VirtualClock(std::uint64_t frequency = 10000000);
+
+		virtual std::uint64_t Now() const override;
+		virtual std::uint64_t Frequency() const override;
+
+		void Advance(std::uint64_t ticks);
+		void AdvanceSeconds(double seconds);
+
+	private:
+		std::uint64_t mNow;
+		std::uint64_t mFrequency;
+	};
+}
+
+#include "Clock.inl"
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cmath>
+
+namespace Simulation
+{
+	inline VirtualClock::VirtualClock(std::uint64_t frequency) :
+		mNow(0), mFrequency(frequency)
+	{
+	}
+
+	inline std::uint64_t VirtualClock::Now() const
+	{
+		return mNow;
+	}
+
+	inline std::uint64_t VirtualClock::Frequency() const
+	{
+		return mFrequency;
+	}
+
+	inline void VirtualClock::Advance(std::uint64_t ticks)
+	{
+		mNow += ticks;
+	}
+
+	inline void VirtualClock::AdvanceSeconds(double seconds)
+	{
+		mNow += static_cast<std::uint64_t>(std::llround(seconds * static_cast<double>(mFrequency)));
+	}
+}
@@ -0,0 +1,109 @@
+#include "pch.h"
+#include "CommandBuffer.h"
+
+using namespace std;
+
+namespace Simulation
+{
+	void CommandBuffer::Execute(RenderBackend& target) const
+	{
+		for (const Command& command : mCommands)
+		{
+			switch (command.Type)
+			{
+			case CommandType::Clear:
+			{
+				const float* color = &mClearColors[command.First];
+				target.Clear(color[0], color[1], color[2], color[3]);
+				break;
+			}
+
+			case CommandType::SetViewProjection:
+				target.SetViewProjection(mMatrices[command.First]);
+				break;
+
+			case CommandType::Draw:
+				target.Draw(command.PrimitiveTopology, &mColorVertices[command.First], command.Count);
+				break;
+
+			case CommandType::DrawIndexed:
+				target.DrawIndexed(command.PrimitiveTopology, &mColorVertices[command.First], command.Count, &mIndices[command.FirstIndex], command.IndexCount);
+				break;
+
+			case CommandType::DrawTextured:
+				target.DrawTextured(command.Texture, command.PrimitiveTopology, &mTextureVertices[command.First], command.Count);
+				break;
+
+			case CommandType::Submit:
+				target.Submit();
+				break;
+			}
+		}
+	}
+
+	void CommandBuffer::Reset()
+	{
+		mCommands.clear();
+		mClearColors.clear();
+		mMatrices.clear();
+		mColorVertices.clear();
+		mTextureVertices.clear();
+		mIndices.clear();
+	}
+
+	void CommandBuffer::Clear(float red, float green, float blue, float alpha)
+	{
+		mCommands.push_back({ CommandType::Clear, Topology::TriangleList, NoTexture, static_cast<uint32_t>(mClearColors.size()), 4, 0, 0 });
+		mClearColors.insert(mClearColors.end(), { red, green, blue, alpha });
+	}
+
+	void CommandBuffer::SetViewProjection(const Matrix4& viewProjection)
+	{
+		mCommands.push_back({ CommandType::SetViewProjection, Topology::TriangleList, NoTexture, static_cast<uint32_t>(mMatrices.size()), 1, 0, 0 });
+		mMatrices.push_back(viewProjection);
+	}
+
+	void CommandBuffer::Draw(Topology topology, const ColorVertex* vertices, uint32_t vertexCount)
+	{
+		if (vertexCount == 0)
+		{
+			return;
+		}
+
+		mCommands.push_back({ CommandType::Draw, topology, NoTexture, static_cast<uint32_t>(mColorVertices.size()), vertexCount, 0, 0 });
+		mColorVertices.insert(mColorVertices.end(), vertices, vertices + vertexCount);
+	}
+
+	void CommandBuffer::DrawIndexed(Topology topology, const ColorVertex* vertices, uint32_t vertexCount, const uint16_t* indices, uint32_t indexCount)
+	{
+		if (vertexCount == 0 || indexCount == 0)
+		{
+			return;
+		}
+
+		mCommands.push_back({ CommandType::DrawIndexed, topology, NoTexture, static_cast<uint32_t>(mColorVertices.size()), vertexCount, static_cast<uint32_t>(mIndices.size()), indexCount });
+		mColorVertices.insert(mColorVertices.end(), vertices, vertices + vertexCount);
+		mIndices.insert(mIndices.end(), indices, indices + indexCount);
+	}
+
+	RenderBackend::TextureId CommandBuffer::CreateTexture(uint32_t, uint32_t, const uint32_t*)
+	{
+		return NoTexture;
+	}
+
+	void CommandBuffer::DrawTextured(TextureId texture, Topology topology, const TextureVertex* vertices, uint32_t vertexCount)
+	{
+		if (vertexCount == 0)
+		{
+			return;
+		}
+
+		mCommands.push_back({ CommandType::DrawTextured, topology, texture, static_cast<uint32_t>(mTextureVertices.size()), vertexCount, 0, 0 });
+		mTextureVertices.insert(mTextureVertices.end(), vertices, vertices + vertexCount);
+	}
+
+	void CommandBuffer::Submit()
+	{
+		mCommands.push_back({ CommandType::Submit, Topology::TriangleList, NoTexture, 0, 0, 0, 0 });
+	}
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "RenderBackend.h"
+#include <cstdint>
+#include <vector>
+
+namespace Simulation
+{
+	// A RenderBackend that only writes down what it is asked to draw, copying the vertices,
+	// so that Execute() can later play it into another backend. Recording touches nothing
+	// but the buffer, which lets several threads record into buffers of their own at once.
+	// Textures cannot be created while recording: CreateTexture() returns NoTexture, and
+	// DrawTextured() takes ids the target backend handed out beforehand.
+	class CommandBuffer final : public RenderBackend
+	{
+	public:
+		CommandBuffer() = default;
+		CommandBuffer(const CommandBuffer&) = default;
+		CommandBuffer& operator=(const CommandBuffer&) = default;
+		CommandBuffer(CommandBuffer&&) = default;
+		CommandBuffer& operator=(CommandBuffer&&) = default;
+		~CommandBuffer() = default;
+
+		std::uint32_t CommandCount() const;
+		bool Empty() const;
+
+		// Plays every command into target, in the order recorded.
+		void Execute(RenderBackend& target) const;
+
+		// Forgets the commands but keeps the memory for the next recording.
+		void Reset();
+
+		virtual void Clear(float red, float green, float blue, float alpha) override;
+		virtual void SetViewProjection(const Matrix4& viewProjection) override;
+
+		virtual void Draw(Topology topology, const ColorVertex* vertices, std::uint32_t vertexCount) override;
+		virtual void DrawIndexed(Topology topology, const ColorVertex* vertices, std::uint32_t vertexCount, const std::uint16_t* indices, std::uint32_t indexCount) override;
+
+		virtual TextureId CreateTexture(std::uint32_t width, std::uint32_t height, const std::uint32_t* texels) override;
+		virtual void DrawTextured(TextureId texture, Topology topology, const TextureVertex* vertices, std::uint32_t vertexCount) override;
+
+		virtual void Submit() override;
+
+	private:
+		enum class CommandType : std::uint8_t
+		{
+			Clear,
+			SetViewProjection,
+			Draw,
+			DrawIndexed,
+			DrawTextured,
+			Submit
+		};
+
+		// First and Count index the array that goes with the type: colors for Clear,
+		// matrices, color or texture vertices; indexed draws add their index range.
+		struct Command final
+		{
+			CommandType Type;
+			Topology PrimitiveTopology;
+			TextureId Texture;
+			std::uint32_t First;
+			std::uint32_t Count;
+			std::uint32_t FirstIndex;
+			std::uint32_t IndexCount;
+		};
+
+		std::vector<Command> mCommands;
+		std::vector<float> mClearColors;
+		std::vector<Matrix4> mMatrices;
+		std::vector<ColorVertex> mColorVertices;
+		std::vector<TextureVertex> mTextureVertices;
+		std::vector<std::uint16_t> mIndices;
+	};
+}
+
+#include "CommandBuffer.inl"
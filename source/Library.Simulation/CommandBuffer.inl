@@ -0,0 +1,14 @@
+#pragma once
+
+namespace Simulation
+{
+	inline std::uint32_t CommandBuffer::CommandCount() const
+	{
+		return static_cast<std::uint32_t>(mCommands.size());
+	}
+
+	inline bool CommandBuffer::Empty() const
+	{
+		return mCommands.empty();
+	}
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Simulation
+{
+	// Remembers components in the order they were added, each either active or not, and
+	// hands out the active ones as a densely packed array in that order: the enabled ones to
+	// update, say, or the visible ones to render. Walking Active() costs one pointer per
+	// active component and nothing for the rest. Add() appends; Remove() and SetActive()
+	// find the component's place in the array by its order key, a binary search, and shift
+	// the rest of the array along by one, rather than packing it all again. The array is
+	// updated in place, so components can't be added, removed or switched while it is
+	// being walked.
+	template <typename T>
+	class ComponentList final
+	{
+	public:
+		ComponentList();
+		ComponentList(const ComponentList&) = default;
+		ComponentList& operator=(const ComponentList&) = default;
+		ComponentList(ComponentList&&) = default;
+		ComponentList& operator=(ComponentList&&) = default;
+		~ComponentList() = default;
+
+		// Registered components, active or not.
+		std::uint32_t Count() const;
+		bool Contains(const T* component) const;
+		bool IsActive(const T* component) const;
+
+		void Add(T* component, bool active);
+		void Remove(const T* component);
+		void SetActive(const T* component, bool active);
+
+		const std::vector<T*>& Active() const;
+
+	private:
+		// Order keys only ever grow, so they sort the active array in the order components
+		// were added however many have come and gone since.
+		struct Entry final
+		{
+			T* Component;
+			std::uint64_t Order;
+			bool Active;
+		};
+
+		void Insert(const Entry& entry);
+		void Erase(std::uint64_t order);
+
+		std::unordered_map<const T*, Entry> mEntries;
+		std::vector<T*> mActive;
+		std::vector<std::uint64_t> mActiveOrders;
+		std::uint64_t mNextOrder;
+	};
+}
+
+#include "ComponentList.inl"
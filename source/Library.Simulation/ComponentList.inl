@@ -0,0 +1,107 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+
+namespace Simulation
+{
+	template <typename T>
+	inline ComponentList<T>::ComponentList() :
+		mNextOrder(0)
+	{
+	}
+
+	template <typename T>
+	inline std::uint32_t ComponentList<T>::Count() const
+	{
+		return static_cast<std::uint32_t>(mEntries.size());
+	}
+
+	template <typename T>
+	inline bool ComponentList<T>::Contains(const T* component) const
+	{
+		return mEntries.find(component) != mEntries.end();
+	}
+
+	template <typename T>
+	inline bool ComponentList<T>::IsActive(const T* component) const
+	{
+		const auto found = mEntries.find(component);
+		return found != mEntries.end() && found->second.Active;
+	}
+
+	template <typename T>
+	inline void ComponentList<T>::Add(T* component, bool active)
+	{
+		assert(component != nullptr && !Contains(component));
+		const std::uint64_t order = mNextOrder++;
+		mEntries.emplace(component, Entry{ component, order, active });
+		if (active)
+		{
+			mActive.push_back(component);
+			mActiveOrders.push_back(order);
+		}
+	}
+
+	template <typename T>
+	inline void ComponentList<T>::Remove(const T* component)
+	{
+		const auto found = mEntries.find(component);
+		if (found == mEntries.end())
+		{
+			return;
+		}
+
+		if (found->second.Active)
+		{
+			Erase(found->second.Order);
+		}
+		mEntries.erase(found);
+	}
+
+	template <typename T>
+	inline void ComponentList<T>::SetActive(const T* component, bool active)
+	{
+		const auto found = mEntries.find(component);
+		if (found == mEntries.end() || found->second.Active == active)
+		{
+			return;
+		}
+
+		Entry& entry = found->second;
+		entry.Active = active;
+		if (active)
+		{
+			Insert(entry);
+		}
+		else
+		{
+			Erase(entry.Order);
+		}
+	}
+
+	template <typename T>
+	inline const std::vector<T*>& ComponentList<T>::Active() const
+	{
+		return mActive;
+	}
+
+	template <typename T>
+	inline void ComponentList<T>::Insert(const Entry& entry)
+	{
+		const auto position = std::lower_bound(mActiveOrders.begin(), mActiveOrders.end(), entry.Order);
+		const std::ptrdiff_t index = position - mActiveOrders.begin();
+		mActiveOrders.insert(position, entry.Order);
+		mActive.insert(mActive.begin() + index, entry.Component);
+	}
+
+	template <typename T>
+	inline void ComponentList<T>::Erase(std::uint64_t order)
+	{
+		const auto position = std::lower_bound(mActiveOrders.begin(), mActiveOrders.end(), order);
+		assert(position != mActiveOrders.end() && *position == order);
+		const std::ptrdiff_t index = position - mActiveOrders.begin();
+		mActiveOrders.erase(position);
+		mActive.erase(mActive.begin() + index);
+	}
+}
@@ -0,0 +1,79 @@
+#include "pch.h"
+#include "FrameSkipper.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <ctime>
+#endif
+
+namespace Simulation
+{
+	double FrameSkipper::ThreadCpuSeconds()
+	{
+#if defined(_WIN32)
+		FILETIME creation, exit, kernel, user;
+		if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user))
+		{
+			return 0.0;
+		}
+
+		// FILETIMEs count 100 ns units.
+		const auto ticks = [](const FILETIME& time) {
+			return (static_cast<std::uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+		};
+		return static_cast<double>(ticks(kernel) + ticks(user)) * 1e-7;
+#else
+		timespec time;
+		if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0)
+		{
+			return 0.0;
+		}
+		return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_nsec) * 1e-9;
+#endif
+	}
+
+	FrameSkipper::FrameSkipper() :
+		mCounters(), mWindowCpuSeconds(0.0), mWindowWallSeconds(0.0), mCpuSecondsPerSecond(0.0), mEnabled(false), mInvalidated(true)
+	{
+	}
+
+	void FrameSkipper::SetEnabled(bool enabled)
+	{
+		if (enabled && !mEnabled)
+		{
+			Invalidate();
+		}
+		mEnabled = enabled;
+	}
+
+	bool FrameSkipper::ShouldRender(bool visualStateChanged)
+	{
+		const bool render = !mEnabled || mInvalidated || visualStateChanged;
+		mInvalidated = false;
+		if (render)
+		{
+			++mCounters.RenderedFrames;
+		}
+		else
+		{
+			++mCounters.SkippedFrames;
+		}
+		return render;
+	}
+
+	bool FrameSkipper::AddTime(double cpuSeconds, double wallSeconds)
+	{
+		mWindowCpuSeconds += cpuSeconds;
+		mWindowWallSeconds += wallSeconds;
+		if (mWindowWallSeconds < 1.0)
+		{
+			return false;
+		}
+
+		mCpuSecondsPerSecond = mWindowCpuSeconds / mWindowWallSeconds;
+		mWindowCpuSeconds = 0.0;
+		mWindowWallSeconds = 0.0;
+		return true;
+	}
+}
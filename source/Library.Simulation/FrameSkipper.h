@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Simulation
+{
+	// Decides which frames are worth drawing when the picture only changes now and then, and
+	// keeps the numbers that show what skipping saved: frames drawn and skipped, and the CPU
+	// time spent per second of wall-clock time. The caller says whether anything visible
+	// changed; while skipping is disabled every frame is drawn but still counted, so the two
+	// modes can be compared.
+	class FrameSkipper final
+	{
+	public:
+		struct Counters final
+		{
+			std::uint64_t RenderedFrames;
+			std::uint64_t SkippedFrames;
+		};
+
+		// CPU time consumed by the calling thread so far.
+		static double ThreadCpuSeconds();
+
+		FrameSkipper();
+		FrameSkipper(const FrameSkipper&) = default;
+		FrameSkipper& operator=(const FrameSkipper&) = default;
+		FrameSkipper(FrameSkipper&&) = default;
+		FrameSkipper& operator=(FrameSkipper&&) = default;
+		~FrameSkipper() = default;
+
+		bool Enabled() const;
+		void SetEnabled(bool enabled);
+
+		// The next frame is drawn whatever the caller says, for when the back buffer no
+		// longer holds the last one: a resize, a lost device, the mode being switched on.
+		void Invalidate();
+
+		// Returns whether this frame must be drawn and counts it either way.
+		bool ShouldRender(bool visualStateChanged);
+
+		// Adds a slice of the loop's time. Once a second of wall-clock time has been added,
+		// the slice's CPU time per second becomes CpuSecondsPerSecond() and true is returned.
+		bool AddTime(double cpuSeconds, double wallSeconds);
+
+		const Counters& GetCounters() const;
+		double CpuSecondsPerSecond() const;
+
+	private:
+		Counters mCounters;
+		double mWindowCpuSeconds;
+		double mWindowWallSeconds;
+		double mCpuSecondsPerSecond;
+		bool mEnabled;
+		bool mInvalidated;
+	};
+}
+
+#include "FrameSkipper.inl"
@@ -0,0 +1,24 @@
+#pragma once
+
+namespace Simulation
+{
+	inline bool FrameSkipper::Enabled() const
+	{
+		return mEnabled;
+	}
+
+	inline void FrameSkipper::Invalidate()
+	{
+		mInvalidated = true;
+	}
+
+	inline const FrameSkipper::Counters& FrameSkipper::GetCounters() const
+	{
+		return mCounters;
+	}
+
+	inline double FrameSkipper::CpuSecondsPerSecond() const
+	{
+		return mCpuSecondsPerSecond;
+	}
+}
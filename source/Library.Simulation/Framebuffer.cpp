@@ -0,0 +1,67 @@
+#include "pch.h"
+#include "Framebuffer.h"
+#include <algorithm>
+#include <ostream>
+#include <string>
+
+using namespace std;
+
+namespace Simulation
+{
+	namespace
+	{
+		uint32_t ToByte(float channel)
+		{
+			const float clamped = channel < 0.0f ? 0.0f : (channel > 1.0f ? 1.0f : channel);
+			return static_cast<uint32_t>(clamped * 255.0f + 0.5f);
+		}
+	}
+
+	Framebuffer::Framebuffer(uint32_t width, uint32_t height) :
+		mWidth(width), mHeight(height), mPixels(static_cast<size_t>(width) * height)
+	{
+	}
+
+	uint32_t Framebuffer::Pack(float red, float green, float blue, float alpha)
+	{
+		return ToByte(red) | (ToByte(green) << 8) | (ToByte(blue) << 16) | (ToByte(alpha) << 24);
+	}
+
+	void Framebuffer::Fill(uint32_t pixel)
+	{
+		fill(mPixels.begin(), mPixels.end(), pixel);
+	}
+
+	uint64_t Framebuffer::Hash() const
+	{
+		uint64_t hash = 14695981039346656037ull;
+		for (uint32_t pixel : mPixels)
+		{
+			for (uint32_t shift = 0; shift < 32; shift += 8)
+			{
+				hash = (hash ^ ((pixel >> shift) & 0xFF)) * 1099511628211ull;
+			}
+		}
+
+		return hash;
+	}
+
+	void Framebuffer::WritePpm(ostream& stream) const
+	{
+		const string header = "P6\n" + to_string(mWidth) + " " + to_string(mHeight) + "\n255\n";
+		stream.write(header.data(), header.size());
+
+		vector<char> row(mWidth * 3);
+		for (uint32_t y = 0; y < mHeight; y++)
+		{
+			const uint32_t* pixels = Row(y);
+			for (uint32_t x = 0; x < mWidth; x++)
+			{
+				row[x * 3] = static_cast<char>(pixels[x] & 0xFF);
+				row[x * 3 + 1] = static_cast<char>((pixels[x] >> 8) & 0xFF);
+				row[x * 3 + 2] = static_cast<char>((pixels[x] >> 16) & 0xFF);
+			}
+			stream.write(row.data(), row.size());
+		}
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+namespace Simulation
+{
+	// An 8-bit RGBA image in memory, rows top to bottom, red in each pixel's lowest byte.
+	class Framebuffer final
+	{
+	public:
+		Framebuffer(std::uint32_t width, std::uint32_t height);
+		Framebuffer(const Framebuffer&) = default;
+		Framebuffer& operator=(const Framebuffer&) = default;
+		Framebuffer(Framebuffer&&) = default;
+		Framebuffer& operator=(Framebuffer&&) = default;
+		~Framebuffer() = default;
+
+		// Each channel is clamped to [0, 1] and rounded to the nearest step.
+		static std::uint32_t Pack(float red, float green, float blue, float alpha);
+
+		std::uint32_t Width() const;
+		std::uint32_t Height() const;
+
+		std::uint32_t* Row(std::uint32_t y);
+		const std::uint32_t* Row(std::uint32_t y) const;
+		std::uint32_t Pixel(std::uint32_t x, std::uint32_t y) const;
+
+		void Fill(std::uint32_t pixel);
+
+		// FNV-1a over every pixel; equal images hash equal on every platform.
+		std::uint64_t Hash() const;
+
+		// Binary PPM (P6). Alpha is dropped.
+		void WritePpm(std::ostream& stream) const;
+
+	private:
+		std::uint32_t mWidth;
+		std::uint32_t mHeight;
+		std::vector<std::uint32_t> mPixels;
+	};
+}
+
+#include "Framebuffer.inl"
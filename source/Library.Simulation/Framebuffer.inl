@@ -0,0 +1,29 @@
+#pragma once
+
+namespace Simulation
+{
+	inline std::uint32_t Framebuffer::Width() const
+	{
+		return mWidth;
+	}
+
+	inline std::uint32_t Framebuffer::Height() const
+	{
+		return mHeight;
+	}
+
+	inline std::uint32_t* Framebuffer::Row(std::uint32_t y)
+	{
+		return &mPixels[static_cast<std::size_t>(y) * mWidth];
+	}
+
+	inline const std::uint32_t* Framebuffer::Row(std::uint32_t y) const
+	{
+		return &mPixels[static_cast<std::size_t>(y) * mWidth];
+	}
+
+	inline std::uint32_t Framebuffer::Pixel(std::uint32_t x, std::uint32_t y) const
+	{
+		return Row(y)[x];
+	}
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Simulation
+{
+	// The set of empty board cells, kept as a dense array of cell indices plus each cell's
+	// slot in that array. Insert and Remove swap with the last entry, so both are O(1), and
+	// a uniformly random empty cell is one array read however full the board is.
+	template <std::uint32_t MaxCells>
+	class FreeCellSet final
+	{
+	public:
+		static const std::uint32_t NoCell = 0xFFFFFFFF;
+
+		// Starts with every cell free.
+		FreeCellSet();
+		FreeCellSet(const FreeCellSet&) = default;
+		FreeCellSet& operator=(const FreeCellSet&) = default;
+		FreeCellSet(FreeCellSet&&) = default;
+		FreeCellSet& operator=(FreeCellSet&&) = default;
+		~FreeCellSet() = default;
+
+		std::uint32_t CellCount() const;
+		std::uint32_t Count() const;
+		bool Contains(std::uint32_t cell) const;
+
+		void Insert(std::uint32_t cell);
+		void Remove(std::uint32_t cell);
+		void Reset();
+
+		// Maps a 32-bit random value onto one of the free cells, skipping excluded if it is
+		// free. Returns NoCell when there is nothing to choose from.
+		std::uint32_t Sample(std::uint32_t random, std::uint32_t excluded = NoCell) const;
+
+	private:
+		std::uint16_t mCells[MaxCells];
+		std::uint16_t mSlots[MaxCells];
+		std::uint32_t mCount;
+	};
+}
+
+#include "FreeCellSet.inl"
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cassert>
+
+namespace Simulation
+{
+	template <std::uint32_t MaxCells>
+	const std::uint32_t FreeCellSet<MaxCells>::NoCell;
+
+	template <std::uint32_t MaxCells>
+	inline FreeCellSet<MaxCells>::FreeCellSet() :
+		mCount(0)
+	{
+		static_assert(MaxCells > 0 && MaxCells <= 0xFFFF, "Cell indices are stored in 16 bits.");
+		Reset();
+	}
+
+	template <std::uint32_t MaxCells>
+	inline std::uint32_t FreeCellSet<MaxCells>::CellCount() const
+	{
+		return MaxCells;
+	}
+
+	template <std::uint32_t MaxCells>
+	inline std::uint32_t FreeCellSet<MaxCells>::Count() const
+	{
+		return mCount;
+	}
+
+	template <std::uint32_t MaxCells>
+	inline bool FreeCellSet<MaxCells>::Contains(std::uint32_t cell) const
+	{
+		assert(cell < CellCount());
+		return mSlots[cell] < mCount;
+	}
+
+	template <std::uint32_t MaxCells>
+	inline void FreeCellSet<MaxCells>::Insert(std::uint32_t cell)
+	{
+		assert(!Contains(cell));
+
+		// Swap the cell into the first occupied slot and grow the free range over it.
+		const std::uint32_t slot = mSlots[cell];
+		const std::uint16_t displaced = mCells[mCount];
+		mCells[slot] = displaced;
+		mSlots[displaced] = static_cast<std::uint16_t>(slot);
+		mCells[mCount] = static_cast<std::uint16_t>(cell);
+		mSlots[cell] = static_cast<std::uint16_t>(mCount);
+		++mCount;
+	}
+
+	template <std::uint32_t MaxCells>
+	inline void FreeCellSet<MaxCells>::Remove(std::uint32_t cell)
+	{
+		assert(Contains(cell));
+
+		// Swap the cell with the last free one and shrink the free range past it.
+		--mCount;
+		const std::uint32_t slot = mSlots[cell];
+		const std::uint16_t displaced = mCells[mCount];
+		mCells[slot] = displaced;
+		mSlots[displaced] = static_cast<std::uint16_t>(slot);
+		mCells[mCount] = static_cast<std::uint16_t>(cell);
+		mSlots[cell] = static_cast<std::uint16_t>(mCount);
+	}
+
+	template <std::uint32_t MaxCells>
+	inline std::uint32_t FreeCellSet<MaxCells>::Sample(std::uint32_t random, std::uint32_t excluded) const
+	{
+		// Leave the excluded cell out of the draw by standing the last free cell in for it.
+		std::uint32_t count = mCount;
+		const bool exclude = excluded != NoCell && Contains(excluded);
+		if (exclude)
+		{
+			--count;
+		}
+
+		if (count == 0)
+		{
+			return NoCell;
+		}
+
+		// Multiply-shift maps the full 32-bit range onto [0, count) without a division.
+		std::uint32_t slot = static_cast<std::uint32_t>((static_cast<std::uint64_t>(random) * count) >> 32);
+		if (exclude && slot == mSlots[excluded])
+		{
+			slot = count;
+		}
+
+		return mCells[slot];
+	}
+
+	template <std::uint32_t MaxCells>
+	inline void FreeCellSet<MaxCells>::Reset()
+	{
+		for (std::uint32_t cell = 0; cell < MaxCells; cell++)
+		{
+			mCells[cell] = static_cast<std::uint16_t>(cell);
+			mSlots[cell] = static_cast<std::uint16_t>(cell);
+		}
+		mCount = MaxCells;
+	}
+}
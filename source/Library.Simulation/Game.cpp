@@ -0,0 +1,208 @@
+#include "pch.h"
+#include "Game.h"
+#include "Board.h"
+#include "Replay.h"
+
+using namespace std;
+
+namespace Simulation
+{
+	const uint32_t Game::DefaultSeed;
+	const uint64_t Game::MaxCatchUpNanoseconds;
+
+	// Time is kept in whole nanoseconds so that tick boundaries land exactly where they
+	// should, rather than drifting with the rounding of a running floating-point sum. Frames
+	// like 1/30 s are no whole number of nanoseconds, so what each one rounds away is carried
+	// into the next.
+	uint64_t Game::ToNanoseconds(double seconds, double& remainder)
+	{
+		const double nanoseconds = max(seconds, 0.0) * 1e9 + remainder;
+		const int64_t whole = max<int64_t>(llround(nanoseconds), 0);
+		remainder = nanoseconds - static_cast<double>(whole);
+		return static_cast<uint64_t>(whole);
+	}
+
+	Game::Game(uint32_t seed) :
+		mState(seed), mRecorder(nullptr)
+	{
+		PlacePowerups();
+	}
+
+	const Snake& Game::GetSnake() const
+	{
+		return mState.Snake;
+	}
+
+	const Powerups& Game::GetPowerups() const
+	{
+		return mState.Powerups;
+	}
+
+	const OccupancyGrid& Game::Occupancy() const
+	{
+		return mState.Occupancy;
+	}
+
+	uint64_t Game::StepCount() const
+	{
+		return mState.StepCount;
+	}
+
+	uint32_t Game::Seed() const
+	{
+		return mState.Seed;
+	}
+
+	const GameState& Game::State() const
+	{
+		return mState;
+	}
+
+	uint64_t Game::StepInterval() const
+	{
+		// Speeds are authored in milliseconds; rounding to the microsecond recovers the value
+		// meant rather than the float nearest it.
+		const int64_t microseconds = llround(static_cast<double>(mState.Snake.Speed()) * 1e6);
+		return static_cast<uint64_t>(max<int64_t>(microseconds, 1)) * 1000;
+	}
+
+	float Game::TickProgress() const
+	{
+		if (!mState.Snake.Alive())
+		{
+			return 0.0f;
+		}
+
+		return min(static_cast<float>(static_cast<double>(mState.NanosecondsSinceUpdate) / static_cast<double>(StepInterval())), 1.0f);
+	}
+
+	void Game::Snapshot(GameState& state) const
+	{
+		memcpy(&state, &mState, sizeof(GameState));
+	}
+
+	void Game::Restore(const GameState& state)
+	{
+		memcpy(&mState, &state, sizeof(GameState));
+	}
+
+	void Game::SetRecorder(ReplayRecorder* recorder)
+	{
+		mRecorder = recorder;
+	}
+
+	void Game::Move(Direction direction)
+	{
+		if (mRecorder != nullptr)
+		{
+			mRecorder->RecordMove(mState.StepCount, direction);
+		}
+
+		mState.Snake.Move(direction);
+	}
+
+	void Game::IncreaseTail()
+	{
+		if (mRecorder != nullptr)
+		{
+			mRecorder->RecordGrow(mState.StepCount);
+		}
+
+		mState.Snake.IncreaseTail();
+	}
+
+	void Game::Update(double elapsedSeconds)
+	{
+		if (!mState.Snake.Alive())
+		{
+			mState.NanosecondsSinceUpdate = 0;
+			return;
+		}
+
+		const uint64_t elapsed = ToNanoseconds(elapsedSeconds, mState.NanosecondRemainder);
+		mState.NanosecondsSinceUpdate = min(mState.NanosecondsSinceUpdate + elapsed, MaxCatchUpNanoseconds);
+
+		// Eating speeds the snake up, so the interval is looked up again every tick.
+		while (mState.Snake.Alive() && mState.NanosecondsSinceUpdate >= StepInterval())
+		{
+			mState.NanosecondsSinceUpdate -= StepInterval();
+			Step();
+		}
+	}
+
+	void Game::Step()
+	{
+		if (!mState.Snake.Alive())
+		{
+			return;
+		}
+
+		mState.Snake.Advance(mState.Occupancy);
+		HandleCollisions();
+		++mState.StepCount;
+	}
+
+	void Game::HandleCollisions()
+	{
+		const Cell& position = mState.Snake.Position();
+		const int32_t x = position.x;
+		const int32_t y = position.y;
+
+		// Handle boundary collisions
+		if (!mState.Occupancy.Contains(x, y))
+		{
+			mState.Snake.Kill();
+			return;
+		}
+
+		// Handle cherry collisions
+		if (mState.Occupancy.HasFlag(x, y, OccupancyGrid::CherryFlag))
+		{
+			RespawnCherry();
+			mState.Snake.IncreaseTail();
+		}
+
+		// Handle coin collisions
+		if (mState.Occupancy.HasFlag(x, y, OccupancyGrid::CoinFlag))
+		{
+			RespawnCoin();
+			mState.Snake.IncreaseTail();
+		}
+
+		// Handle body collisions. The newest tail segment always shares the head's cell.
+		if (mState.Occupancy.BodyCount(x, y) > 1)
+		{
+			mState.Snake.Kill();
+		}
+	}
+
+	void Game::PlacePowerups()
+	{
+		const Cell& cherry = mState.Powerups.GetCherryPosition();
+		mState.Occupancy.SetFlag(cherry.x, cherry.y, OccupancyGrid::CherryFlag);
+
+		const Cell& coin = mState.Powerups.GetCoinPosition();
+		mState.Occupancy.SetFlag(coin.x, coin.y, OccupancyGrid::CoinFlag);
+	}
+
+	// The head is kept out of the draw because it is not yet on the grid while the tail is empty.
+	void Game::RespawnCherry()
+	{
+		const Cell& cherry = mState.Powerups.GetCherryPosition();
+		mState.Occupancy.ClearFlag(cherry.x, cherry.y, OccupancyGrid::CherryFlag);
+		if (mState.Powerups.RespawnCherry(mState.Occupancy, mState.Random, mState.Snake.Position()))
+		{
+			mState.Occupancy.SetFlag(cherry.x, cherry.y, OccupancyGrid::CherryFlag);
+		}
+	}
+
+	void Game::RespawnCoin()
+	{
+		const Cell& coin = mState.Powerups.GetCoinPosition();
+		mState.Occupancy.ClearFlag(coin.x, coin.y, OccupancyGrid::CoinFlag);
+		if (mState.Powerups.RespawnCoin(mState.Occupancy, mState.Random, mState.Snake.Position()))
+		{
+			mState.Occupancy.SetFlag(coin.x, coin.y, OccupancyGrid::CoinFlag);
+		}
+	}
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "GameState.h"
+#include <cstdint>
+
+namespace Simulation
+{
+	class ReplayRecorder;
+
+	// The complete rules of a single game, independent of any platform or renderer.
+	// Update() is fed wall-clock time and advances as many ticks as it covers at the snake's
+	// speed, carrying the remainder over; Step() advances exactly one tick for headless
+	// callers. Given the same seed and the same inputs on the same ticks, two games play out
+	// identically. All of that state lives in one GameState, which Snapshot() and Restore()
+	// copy in and out whole.
+	class Game final
+	{
+	public:
+		static const std::uint32_t DefaultSeed = 1;
+
+		// Update() runs every tick the time fed to it covers. Only owed time past this is
+		// dropped, as a stall such as a breakpoint or a suspended window rather than frames
+		// to catch up on; with Snake::MinSpeed that bounds the ticks one Update() can run.
+		static const std::uint64_t MaxCatchUpNanoseconds = 2000000000;
+
+		// Seconds as whole nanoseconds, carrying what rounding leaves over in remainder, so a
+		// run of calls adds up to the rounded total rather than the sum of rounded parts.
+		static std::uint64_t ToNanoseconds(double seconds, double& remainder);
+
+		explicit Game(std::uint32_t seed = DefaultSeed);
+		Game(const Game&) = default;
+		Game& operator=(const Game&) = default;
+		Game(Game&&) = default;
+		Game& operator=(Game&&) = default;
+		~Game() = default;
+
+		const Snake& GetSnake() const;
+		const Powerups& GetPowerups() const;
+		const OccupancyGrid& Occupancy() const;
+		std::uint64_t StepCount() const;
+		std::uint32_t Seed() const;
+		const GameState& State() const;
+
+		// The time between ticks at the snake's current speed, in nanoseconds.
+		std::uint64_t StepInterval() const;
+
+		// How far Update() has got towards the next tick, from 0 to 1, for drawing the snake
+		// between ticks.
+		float TickProgress() const;
+
+		void Snapshot(GameState& state) const;
+		void Restore(const GameState& state);
+
+		// Inputs are passed on to the recorder, if any, stamped with the current tick.
+		void SetRecorder(ReplayRecorder* recorder);
+
+		void Move(Direction direction);
+		void IncreaseTail();
+		void Update(double elapsedSeconds);
+		void Step();
+
+	private:
+		void HandleCollisions();
+		void PlacePowerups();
+		void RespawnCherry();
+		void RespawnCoin();
+
+		GameState mState;
+		ReplayRecorder* mRecorder;
+	};
+}
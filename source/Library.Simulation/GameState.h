@@ -0,0 +1,34 @@
+#pragma once
+
+#include "OccupancyGrid.h"
+#include "Powerups.h"
+#include "Random.h"
+#include "Snake.h"
+#include <cstdint>
+#include <type_traits>
+
+namespace Simulation
+{
+	// Everything that decides how a game plays out from this point on, in one contiguous
+	// block with no pointers or heap storage. Copying it with memcpy is a complete
+	// snapshot, which is what search, rewind and rollback rely on.
+	struct GameState final
+	{
+		explicit GameState(std::uint32_t seed) :
+			Occupancy(), Snake(), Powerups(), Random(seed), NanosecondsSinceUpdate(0), NanosecondRemainder(0.0), StepCount(0), Seed(seed)
+		{
+		}
+
+		OccupancyGrid Occupancy;
+		Simulation::Snake Snake;
+		Simulation::Powerups Powerups;
+		Simulation::Random Random;
+		std::uint64_t NanosecondsSinceUpdate;
+		double NanosecondRemainder;
+		std::uint64_t StepCount;
+		std::uint32_t Seed;
+	};
+
+	static_assert(std::is_trivially_copyable<GameState>::value, "GameState must stay copyable with memcpy.");
+	static_assert(std::is_standard_layout<GameState>::value, "GameState must stay a flat block of data.");
+}
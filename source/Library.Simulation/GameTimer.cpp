@@ -0,0 +1,52 @@
+#include "pch.h"
+#include "GameTimer.h"
+
+using namespace std;
+
+namespace Simulation
+{
+	const uint64_t GameTimer::TicksPerSecond;
+
+	GameTimer::GameTimer() :
+		GameTimer(Clock::CreateDefault())
+	{
+	}
+
+	GameTimer::GameTimer(const shared_ptr<Clock>& clock) :
+		mClock(clock), mClockFrequency(clock->Frequency()), mLastClockTime(clock->Now()), mMaxClockDelta(mClockFrequency / 10),
+		mElapsedTicks(0), mTotalTicks(0), mLeftOverTicks(0),
+		mFrameCount(0), mFramesPerSecond(0), mFramesThisSecond(0), mSecondCounter(0),
+		mIsFixedTimeStep(false), mTargetElapsedTicks(TicksPerSecond / 60)
+	{
+	}
+
+	void GameTimer::ResetElapsedTime()
+	{
+		mLastClockTime = mClock->Now();
+		mLeftOverTicks = 0;
+		mFramesPerSecond = 0;
+		mFramesThisSecond = 0;
+		mSecondCounter = 0;
+	}
+
+	uint64_t GameTimer::Advance()
+	{
+		const uint64_t currentTime = mClock->Now();
+		uint64_t timeDelta = currentTime - mLastClockTime;
+
+		mLastClockTime = currentTime;
+		mSecondCounter += timeDelta;
+
+		// Clamp excessively large time deltas (e.g. after paused in the debugger).
+		if (timeDelta > mMaxClockDelta)
+		{
+			timeDelta = mMaxClockDelta;
+		}
+
+		// Convert clock units into a canonical tick format. This cannot overflow due to the previous clamp.
+		timeDelta *= TicksPerSecond;
+		timeDelta /= mClockFrequency;
+
+		return timeDelta;
+	}
+}
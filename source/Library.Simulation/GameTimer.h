@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Clock.h"
+#include <cstdint>
+#include <memory>
+
+namespace Simulation
+{
+	// Animation and simulation timing in fixed or variable steps, read from whichever Clock
+	// it is given. On a VirtualClock, hours of game time take as long as the updates do, and
+	// the same sequence of Advance() calls always produces the same updates.
+	class GameTimer
+	{
+	public:
+		// Integer format represents time using 10,000,000 ticks per second.
+		static const std::uint64_t TicksPerSecond = 10000000;
+
+		static double TicksToSeconds(std::uint64_t ticks);
+		static std::uint64_t SecondsToTicks(double seconds);
+
+		GameTimer();
+		explicit GameTimer(const std::shared_ptr<Clock>& clock);
+		GameTimer(const GameTimer&) = default;
+		GameTimer& operator=(const GameTimer&) = default;
+		GameTimer(GameTimer&&) = default;
+		GameTimer& operator=(GameTimer&&) = default;
+		virtual ~GameTimer() = default;
+
+		const std::shared_ptr<Clock>& GetClock() const;
+
+		// Get elapsed time since the previous Update call.
+		std::uint64_t GetElapsedTicks() const;
+		double GetElapsedSeconds() const;
+
+		// Get total time since the start of the program.
+		std::uint64_t GetTotalTicks() const;
+		double GetTotalSeconds() const;
+
+		// Get total number of updates since start of the program.
+		std::uint32_t GetFrameCount() const;
+
+		// Get the current framerate.
+		std::uint32_t GetFramesPerSecond() const;
+
+		// Set whether to use fixed or variable timestep mode.
+		void SetFixedTimeStep(bool isFixedTimestep);
+
+		// Set how often to call Update when in fixed timestep mode.
+		void SetTargetElapsedTicks(std::uint64_t targetElapsed);
+		void SetTargetElapsedSeconds(double targetElapsed);
+
+		// After an intentional timing discontinuity (for instance a blocking IO operation)
+		// call this to avoid having the fixed timestep logic attempt a set of catch-up
+		// Update calls.
+		void ResetElapsedTime();
+
+		// Update timer state, calling the specified Update function the appropriate number of times.
+		template <typename TUpdate>
+		void Tick(const TUpdate& update);
+
+	private:
+		// Reads the clock and returns the time since the last reading in canonical ticks.
+		std::uint64_t Advance();
+
+		std::shared_ptr<Clock> mClock;
+
+		// Source timing data uses the clock's units.
+		std::uint64_t mClockFrequency;
+		std::uint64_t mLastClockTime;
+		// Deltas are clamped to 1/10 of a second.
+		std::uint64_t mMaxClockDelta;
+
+		// Derived timing data uses a canonical tick format.
+		std::uint64_t mElapsedTicks;
+		std::uint64_t mTotalTicks;
+		std::uint64_t mLeftOverTicks;
+
+		// Members for tracking the framerate.
+		std::uint32_t mFrameCount;
+		std::uint32_t mFramesPerSecond;
+		std::uint32_t mFramesThisSecond;
+		std::uint64_t mSecondCounter;
+
+		// Members for configuring fixed timestep mode.
+		bool mIsFixedTimeStep;
+		std::uint64_t mTargetElapsedTicks;
+	};
+}
+
+#include "GameTimer.inl"
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdlib>
+
+namespace Simulation
+{
+	inline double GameTimer::TicksToSeconds(std::uint64_t ticks)
+	{
+		return static_cast<double>(ticks) / TicksPerSecond;
+	}
+
+	inline std::uint64_t GameTimer::SecondsToTicks(double seconds)
+	{
+		return static_cast<std::uint64_t>(seconds * TicksPerSecond);
+	}
+
+	inline const std::shared_ptr<Clock>& GameTimer::GetClock() const
+	{
+		return mClock;
+	}
+
+	inline std::uint64_t GameTimer::GetElapsedTicks() const
+	{
+		return mElapsedTicks;
+	}
+
+	inline double GameTimer::GetElapsedSeconds() const
+	{
+		return TicksToSeconds(mElapsedTicks);
+	}
+
+	inline std::uint64_t GameTimer::GetTotalTicks() const
+	{
+		return mTotalTicks;
+	}
+
+	inline double GameTimer::GetTotalSeconds() const
+	{
+		return TicksToSeconds(mTotalTicks);
+	}
+
+	inline std::uint32_t GameTimer::GetFrameCount() const
+	{
+		return mFrameCount;
+	}
+
+	inline std::uint32_t GameTimer::GetFramesPerSecond() const
+	{
+		return mFramesPerSecond;
+	}
+
+	inline void GameTimer::SetFixedTimeStep(bool isFixedTimestep)
+	{
+		mIsFixedTimeStep = isFixedTimestep;
+	}
+
+	inline void GameTimer::SetTargetElapsedTicks(std::uint64_t targetElapsed)
+	{
+		mTargetElapsedTicks = targetElapsed;
+	}
+
+	inline void GameTimer::SetTargetElapsedSeconds(double targetElapsed)
+	{
+		mTargetElapsedTicks = SecondsToTicks(targetElapsed);
+	}
+
+	template <typename TUpdate>
+	inline void GameTimer::Tick(const TUpdate& update)
+	{
+		std::uint64_t timeDelta = Advance();
+		const std::uint32_t lastFrameCount = mFrameCount;
+
+		if (mIsFixedTimeStep)
+		{
+			// If the app is running very close to the target elapsed time (within 1/4 of a millisecond) just clamp
+			// the clock to exactly match the target value. This prevents tiny and irrelevant errors
+			// from accumulating over time. Without this clamping, a game that requested a 60 fps
+			// fixed update, running with vsync enabled on a 59.94 NTSC display, would eventually
+			// accumulate enough tiny errors that it would drop a frame. It is better to just round
+			// small deviations down to zero to leave things running smoothly.
+			if (std::llabs(static_cast<long long>(timeDelta - mTargetElapsedTicks)) < static_cast<long long>(TicksPerSecond / 4000))
+			{
+				timeDelta = mTargetElapsedTicks;
+			}
+
+			mLeftOverTicks += timeDelta;
+
+			while (mLeftOverTicks >= mTargetElapsedTicks)
+			{
+				mElapsedTicks = mTargetElapsedTicks;
+				mTotalTicks += mTargetElapsedTicks;
+				mLeftOverTicks -= mTargetElapsedTicks;
+				mFrameCount++;
+
+				update();
+			}
+		}
+		else
+		{
+			// Variable timestep update logic.
+			mElapsedTicks = timeDelta;
+			mTotalTicks += timeDelta;
+			mLeftOverTicks = 0;
+			mFrameCount++;
+
+			update();
+		}
+
+		// Track the current framerate.
+		if (mFrameCount != lastFrameCount)
+		{
+			mFramesThisSecond++;
+		}
+
+		if (mSecondCounter >= mClockFrequency)
+		{
+			mFramesPerSecond = mFramesThisSecond;
+			mFramesThisSecond = 0;
+			mSecondCounter %= mClockFrequency;
+		}
+	}
+}
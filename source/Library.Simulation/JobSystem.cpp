@@ -0,0 +1,171 @@
+#include "pch.h"
+#include "JobSystem.h"
+
+using namespace std;
+
+namespace Simulation
+{
+	namespace
+	{
+		// Which pool, if any, the current thread works for, and which queue is its own.
+		thread_local const JobSystem* tJobSystem = nullptr;
+		thread_local uint32_t tQueueIndex = 0;
+	}
+
+	shared_ptr<JobSystem> JobSystem::sInstance = nullptr;
+
+	shared_ptr<JobSystem> JobSystem::Init(uint32_t threadCount)
+	{
+		if (sInstance == nullptr)
+		{
+			sInstance = make_shared<JobSystem>(threadCount);
+		}
+		return sInstance;
+	}
+
+	shared_ptr<JobSystem> JobSystem::GetInstance()
+	{
+		return sInstance;
+	}
+
+	JobSystem::JobSystem(uint32_t threadCount) :
+		mQueuedJobs(0), mStopping(false)
+	{
+		if (threadCount == 0)
+		{
+			threadCount = max(thread::hardware_concurrency(), 1u);
+		}
+		for (uint32_t i = 0; i < threadCount; i++)
+		{
+			mQueues.push_back(make_unique<Queue>());
+		}
+		for (uint32_t i = 1; i < threadCount; i++)
+		{
+			mWorkers.emplace_back(&JobSystem::WorkerLoop, this, i);
+		}
+	}
+
+	JobSystem::~JobSystem()
+	{
+		{
+			lock_guard<mutex> lock(mSleepMutex);
+			mStopping = true;
+		}
+		mWorkReady.notify_all();
+
+		for (thread& worker : mWorkers)
+		{
+			worker.join();
+		}
+	}
+
+	void JobSystem::Run(const Job& job, Counter& counter)
+	{
+		counter.mPending.fetch_add(1, memory_order_relaxed);
+
+		Queue& queue = *mQueues[CurrentQueue()];
+		{
+			lock_guard<mutex> lock(queue.Mutex);
+			queue.Jobs.push_back({ job, &counter });
+		}
+		mQueuedJobs.fetch_add(1, memory_order_release);
+
+		if (!mWorkers.empty())
+		{
+			// Taking the lock orders this against a worker between checking for jobs and
+			// going to sleep, so the notification can't be missed.
+			{
+				lock_guard<mutex> lock(mSleepMutex);
+			}
+			mWorkReady.notify_one();
+		}
+	}
+
+	void JobSystem::Wait(const Counter& counter)
+	{
+		const uint32_t queueIndex = CurrentQueue();
+		while (!counter.Done())
+		{
+			// What's left is running on other threads.
+			if (!RunQueuedJob(queueIndex))
+			{
+				this_thread::yield();
+			}
+		}
+	}
+
+	void JobSystem::WorkerLoop(uint32_t queueIndex)
+	{
+		tJobSystem = this;
+		tQueueIndex = queueIndex;
+
+		for (;;)
+		{
+			if (RunQueuedJob(queueIndex))
+			{
+				continue;
+			}
+
+			unique_lock<mutex> lock(mSleepMutex);
+			mWorkReady.wait(lock, [this]() { return mStopping || mQueuedJobs.load(memory_order_acquire) > 0; });
+			if (mStopping)
+			{
+				return;
+			}
+		}
+	}
+
+	uint32_t JobSystem::CurrentQueue() const
+	{
+		return tJobSystem == this ? tQueueIndex : 0;
+	}
+
+	bool JobSystem::RunQueuedJob(uint32_t queueIndex)
+	{
+		QueuedJob job;
+		if (!Pop(queueIndex, job) && !Steal(queueIndex, job))
+		{
+			return false;
+		}
+
+		job.Work();
+		job.Pending->mPending.fetch_sub(1, memory_order_release);
+		return true;
+	}
+
+	bool JobSystem::Pop(uint32_t queueIndex, QueuedJob& job)
+	{
+		Queue& queue = *mQueues[queueIndex];
+		lock_guard<mutex> lock(queue.Mutex);
+		if (queue.Jobs.empty())
+		{
+			return false;
+		}
+
+		job = move(queue.Jobs.back());
+		queue.Jobs.pop_back();
+		mQueuedJobs.fetch_sub(1, memory_order_relaxed);
+		return true;
+	}
+
+	bool JobSystem::Steal(uint32_t thiefIndex, QueuedJob& job)
+	{
+		const uint32_t queueCount = static_cast<uint32_t>(mQueues.size());
+		for (uint32_t offset = 1; offset < queueCount; offset++)
+		{
+			Queue& queue = *mQueues[(thiefIndex + offset) % queueCount];
+			lock_guard<mutex> lock(queue.Mutex);
+			if (queue.Jobs.empty())
+			{
+				continue;
+			}
+
+			job = move(queue.Jobs.front());
+			queue.Jobs.pop_front();
+			mQueuedJobs.fetch_sub(1, memory_order_relaxed);
+			return true;
+		}
+
+		return false;
+	}
+}
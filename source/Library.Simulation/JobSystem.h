@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Simulation
+{
+	// A pool of threads, each with a queue of jobs of its own. A thread runs the newest job
+	// in its queue first and, when the queue is empty, steals the oldest job from another's,
+	// so work spreads out without every thread contending for one queue. Threads outside the
+	// pool, the game's main thread among them, share one more queue. Jobs may run jobs of
+	// their own and wait for them; a waiting thread runs queued jobs rather than sleeping.
+	// Jobs must not throw.
+	class JobSystem final
+	{
+	public:
+		typedef std::function<void()> Job;
+
+		// Counts the jobs run against it that have yet to finish.
+		class Counter final
+		{
+		public:
+			Counter();
+			Counter(const Counter&) = delete;
+			Counter& operator=(const Counter&) = delete;
+			Counter(Counter&&) = delete;
+			Counter& operator=(Counter&&) = delete;
+			~Counter() = default;
+
+			bool Done() const;
+
+		private:
+			friend class JobSystem;
+
+			std::atomic<std::uint32_t> mPending;
+		};
+
+		static std::shared_ptr<JobSystem> Init(std::uint32_t threadCount = 0);
+		static std::shared_ptr<JobSystem> GetInstance();
+
+		// threadCount includes a thread calling Wait(); 0 picks one per core.
+		explicit JobSystem(std::uint32_t threadCount = 0);
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+		JobSystem(JobSystem&&) = delete;
+		JobSystem& operator=(JobSystem&&) = delete;
+		~JobSystem();
+
+		std::uint32_t ThreadCount() const;
+
+		// Queues the job on the calling thread's queue.
+		void Run(const Job& job, Counter& counter);
+
+		// Runs queued jobs, counter's or any other's, until counter's are all done.
+		void Wait(const Counter& counter);
+
+		// Calls body(first, last) on consecutive ranges of at most grainSize covering
+		// [begin, end), one job each, and returns once every range is done. The calling
+		// thread takes the first range itself.
+		template <typename TBody>
+		void ParallelFor(std::uint32_t begin, std::uint32_t end, std::uint32_t grainSize, const TBody& body);
+
+	private:
+		struct QueuedJob final
+		{
+			Job Work;
+			Counter* Pending;
+		};
+
+		struct Queue final
+		{
+			std::mutex Mutex;
+			std::deque<QueuedJob> Jobs;
+		};
+
+		void WorkerLoop(std::uint32_t queueIndex);
+		std::uint32_t CurrentQueue() const;
+		bool RunQueuedJob(std::uint32_t queueIndex);
+		bool Pop(std::uint32_t queueIndex, QueuedJob& job);
+		bool Steal(std::uint32_t thiefIndex, QueuedJob& job);
+
+		static std::shared_ptr<JobSystem> sInstance;
+
+		// Queue 0 belongs to threads outside the pool, queue i to worker i.
+		std::vector<std::unique_ptr<Queue>> mQueues;
+		std::vector<std::thread> mWorkers;
+		std::atomic<std::uint32_t> mQueuedJobs;
+		std::mutex mSleepMutex;
+		std::condition_variable mWorkReady;
+		bool mStopping;
+	};
+}
+
+#include "JobSystem.inl"
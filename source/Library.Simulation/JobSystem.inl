@@ -0,0 +1,43 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+
+namespace Simulation
+{
+	inline JobSystem::Counter::Counter() :
+		mPending(0)
+	{
+	}
+
+	inline bool JobSystem::Counter::Done() const
+	{
+		return mPending.load(std::memory_order_acquire) == 0;
+	}
+
+	inline std::uint32_t JobSystem::ThreadCount() const
+	{
+		return static_cast<std::uint32_t>(mWorkers.size()) + 1;
+	}
+
+	template <typename TBody>
+	inline void JobSystem::ParallelFor(std::uint32_t begin, std::uint32_t end, std::uint32_t grainSize, const TBody& body)
+	{
+		assert(grainSize > 0);
+		if (begin >= end)
+		{
+			return;
+		}
+
+		const std::uint32_t firstEnd = begin + std::min(grainSize, end - begin);
+		Counter counter;
+		for (std::uint32_t first = firstEnd; first < end; first += std::min(grainSize, end - first))
+		{
+			const std::uint32_t last = first + std::min(grainSize, end - first);
+			Run([&body, first, last]() { body(first, last); }, counter);
+		}
+
+		body(begin, firstEnd);
+		Wait(counter);
+	}
+}
@@ -0,0 +1,18 @@
+#include "pch.h"
+#include "OccupancyGrid.h"
+
+using namespace std;
+
+namespace Simulation
+{
+	OccupancyGrid::OccupancyGrid() :
+		mCells(), mFreeCells()
+	{
+	}
+
+	void OccupancyGrid::Clear()
+	{
+		memset(mCells, 0, sizeof(mCells));
+		mFreeCells.Reset();
+	}
+}
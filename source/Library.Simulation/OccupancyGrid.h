@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Board.h"
+#include "Cell.h"
+#include "FreeCellSet.h"
+#include <cstdint>
+
+namespace Simulation
+{
+	// One byte per board cell, updated incrementally as the snake moves so that collision
+	// queries are a single lookup. The low bits count the body segments in the cell and the
+	// high bits flag the powerups lying on it. Cells with neither are also tracked in a
+	// FreeCellSet so that a random empty cell can be drawn in constant time. All storage is
+	// inline and sized for the Board, so the grid is trivially copyable.
+	class OccupancyGrid final
+	{
+	public:
+		static const std::uint8_t BodyMask = 0x3F;
+		static const std::uint8_t CherryFlag = 0x40;
+		static const std::uint8_t CoinFlag = 0x80;
+
+		OccupancyGrid();
+		OccupancyGrid(const OccupancyGrid&) = default;
+		OccupancyGrid& operator=(const OccupancyGrid&) = default;
+		OccupancyGrid(OccupancyGrid&&) = default;
+		OccupancyGrid& operator=(OccupancyGrid&&) = default;
+		~OccupancyGrid() = default;
+
+		std::int32_t Width() const;
+		std::int32_t Height() const;
+		bool Contains(std::int32_t x, std::int32_t y) const;
+
+		std::uint8_t At(std::int32_t x, std::int32_t y) const;
+		std::uint32_t BodyCount(std::int32_t x, std::int32_t y) const;
+		bool HasFlag(std::int32_t x, std::int32_t y, std::uint8_t flag) const;
+
+		// Cells outside the board are ignored so callers need not bounds check first.
+		void AddBody(std::int32_t x, std::int32_t y);
+		void RemoveBody(std::int32_t x, std::int32_t y);
+		void SetFlag(std::int32_t x, std::int32_t y, std::uint8_t flag);
+		void ClearFlag(std::int32_t x, std::int32_t y, std::uint8_t flag);
+
+		void Clear();
+
+		std::uint32_t FreeCount() const;
+
+		// Uniformly random cell holding neither body nor powerup, other than excluded.
+		// Returns false when the board has no such cell.
+		bool SampleFreeCell(std::uint32_t random, const Cell& excluded, Cell& cell) const;
+
+	private:
+		std::uint32_t CellIndex(std::int32_t x, std::int32_t y) const;
+
+		std::uint8_t mCells[Board::CellCount];
+		FreeCellSet<Board::CellCount> mFreeCells;
+	};
+}
+
+#include "OccupancyGrid.inl"
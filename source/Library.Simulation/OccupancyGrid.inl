@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cassert>
+
+namespace Simulation
+{
+	inline std::int32_t OccupancyGrid::Width() const
+	{
+		return Board::Width;
+	}
+
+	inline std::int32_t OccupancyGrid::Height() const
+	{
+		return Board::Height;
+	}
+
+	inline bool OccupancyGrid::Contains(std::int32_t x, std::int32_t y) const
+	{
+		return static_cast<std::uint32_t>(x) < static_cast<std::uint32_t>(Board::Width) &&
+			static_cast<std::uint32_t>(y) < static_cast<std::uint32_t>(Board::Height);
+	}
+
+	inline std::uint8_t OccupancyGrid::At(std::int32_t x, std::int32_t y) const
+	{
+		return Contains(x, y) ? mCells[CellIndex(x, y)] : 0;
+	}
+
+	inline std::uint32_t OccupancyGrid::BodyCount(std::int32_t x, std::int32_t y) const
+	{
+		return At(x, y) & BodyMask;
+	}
+
+	inline bool OccupancyGrid::HasFlag(std::int32_t x, std::int32_t y, std::uint8_t flag) const
+	{
+		return (At(x, y) & flag) != 0;
+	}
+
+	inline void OccupancyGrid::AddBody(std::int32_t x, std::int32_t y)
+	{
+		if (Contains(x, y))
+		{
+			const std::uint32_t index = CellIndex(x, y);
+			assert((mCells[index] & BodyMask) != BodyMask);
+			if (mCells[index]++ == 0)
+			{
+				mFreeCells.Remove(index);
+			}
+		}
+	}
+
+	inline void OccupancyGrid::RemoveBody(std::int32_t x, std::int32_t y)
+	{
+		if (Contains(x, y))
+		{
+			const std::uint32_t index = CellIndex(x, y);
+			assert((mCells[index] & BodyMask) != 0);
+			if (--mCells[index] == 0)
+			{
+				mFreeCells.Insert(index);
+			}
+		}
+	}
+
+	inline void OccupancyGrid::SetFlag(std::int32_t x, std::int32_t y, std::uint8_t flag)
+	{
+		if (Contains(x, y))
+		{
+			const std::uint32_t index = CellIndex(x, y);
+			if (mCells[index] == 0)
+			{
+				mFreeCells.Remove(index);
+			}
+			mCells[index] |= flag;
+		}
+	}
+
+	inline void OccupancyGrid::ClearFlag(std::int32_t x, std::int32_t y, std::uint8_t flag)
+	{
+		if (Contains(x, y))
+		{
+			const std::uint32_t index = CellIndex(x, y);
+			if (mCells[index] != 0)
+			{
+				mCells[index] &= static_cast<std::uint8_t>(~flag);
+				if (mCells[index] == 0)
+				{
+					mFreeCells.Insert(index);
+				}
+			}
+		}
+	}
+
+	inline std::uint32_t OccupancyGrid::FreeCount() const
+	{
+		return mFreeCells.Count();
+	}
+
+	inline bool OccupancyGrid::SampleFreeCell(std::uint32_t random, const Cell& excluded, Cell& cell) const
+	{
+		const std::uint32_t index = mFreeCells.Sample(random, Contains(excluded.x, excluded.y) ? CellIndex(excluded.x, excluded.y) : FreeCellSet<Board::CellCount>::NoCell);
+		if (index == FreeCellSet<Board::CellCount>::NoCell)
+		{
+			return false;
+		}
+
+		cell = Cell(static_cast<std::int32_t>(index) % Board::Width, static_cast<std::int32_t>(index) / Board::Width);
+		return true;
+	}
+
+	inline std::uint32_t OccupancyGrid::CellIndex(std::int32_t x, std::int32_t y) const
+	{
+		return static_cast<std::uint32_t>(y * Board::Width + x);
+	}
+}
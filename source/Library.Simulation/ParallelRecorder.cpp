@@ -0,0 +1,139 @@
+#include "pch.h"
+#include "ParallelRecorder.h"
+
+using namespace std;
+
+namespace Simulation
+{
+	ParallelRecorder::ParallelRecorder(uint32_t threadCount) :
+		mNextSlot(0), mGeneration(0), mBusyWorkers(0), mStarted(false), mStopping(false)
+	{
+		if (threadCount == 0)
+		{
+			threadCount = max(thread::hardware_concurrency(), 1u);
+		}
+		for (uint32_t i = 1; i < threadCount; i++)
+		{
+			mWorkers.emplace_back(&ParallelRecorder::WorkerLoop, this);
+		}
+	}
+
+	ParallelRecorder::~ParallelRecorder()
+	{
+		if (mStarted)
+		{
+			Wait();
+		}
+
+		{
+			lock_guard<mutex> lock(mMutex);
+			mStopping = true;
+		}
+		mWorkReady.notify_all();
+
+		for (thread& worker : mWorkers)
+		{
+			worker.join();
+		}
+	}
+
+	uint32_t ParallelRecorder::Add(const RecordFunction& record)
+	{
+		assert(!mStarted);
+		mRecords.push_back(record);
+		if (mBuffers.size() < mRecords.size())
+		{
+			mBuffers.emplace_back();
+		}
+
+		return static_cast<uint32_t>(mRecords.size() - 1);
+	}
+
+	void ParallelRecorder::Start()
+	{
+		assert(!mStarted);
+		mStarted = true;
+		mNextSlot.store(0, memory_order_relaxed);
+
+		// A single slot is not worth waking anybody for; Wait() records it.
+		if (!mWorkers.empty() && mRecords.size() > 1)
+		{
+			{
+				lock_guard<mutex> lock(mMutex);
+				mBusyWorkers = static_cast<uint32_t>(mWorkers.size());
+				++mGeneration;
+			}
+			mWorkReady.notify_all();
+		}
+	}
+
+	void ParallelRecorder::Wait()
+	{
+		assert(mStarted);
+		RecordSlots();
+
+		unique_lock<mutex> lock(mMutex);
+		mWorkDone.wait(lock, [this]() { return mBusyWorkers == 0; });
+		mStarted = false;
+	}
+
+	void ParallelRecorder::Record()
+	{
+		Start();
+		Wait();
+	}
+
+	void ParallelRecorder::ReplayAll(RenderBackend& target) const
+	{
+		for (uint32_t slot = 0; slot < mRecords.size(); slot++)
+		{
+			Replay(slot, target);
+		}
+	}
+
+	void ParallelRecorder::Clear()
+	{
+		assert(!mStarted);
+		mRecords.clear();
+	}
+
+	void ParallelRecorder::WorkerLoop()
+	{
+		uint64_t generation = 0;
+		for (;;)
+		{
+			{
+				unique_lock<mutex> lock(mMutex);
+				mWorkReady.wait(lock, [&]() { return mStopping || mGeneration != generation; });
+				if (mStopping)
+				{
+					return;
+				}
+				generation = mGeneration;
+			}
+
+			RecordSlots();
+
+			bool last;
+			{
+				lock_guard<mutex> lock(mMutex);
+				last = --mBusyWorkers == 0;
+			}
+			if (last)
+			{
+				mWorkDone.notify_one();
+			}
+		}
+	}
+
+	void ParallelRecorder::RecordSlots()
+	{
+		const uint32_t count = static_cast<uint32_t>(mRecords.size());
+		for (uint32_t slot = mNextSlot.fetch_add(1, memory_order_relaxed); slot < count; slot = mNextSlot.fetch_add(1, memory_order_relaxed))
+		{
+			CommandBuffer& buffer = mBuffers[slot];
+			buffer.Reset();
+			mRecords[slot](buffer);
+		}
+	}
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CommandBuffer.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Simulation
+{
+	// Records the independent parts of a frame on a pool of threads, each part into a
+	// CommandBuffer of its own, and replays them in the order they were added. Which thread
+	// recorded what never shows in the result. A record function may only draw into the
+	// backend it is given and must not throw.
+	class ParallelRecorder final
+	{
+	public:
+		typedef std::function<void(RenderBackend& backend)> RecordFunction;
+
+		// threadCount includes the thread calling Wait(); 0 picks one per core.
+		explicit ParallelRecorder(std::uint32_t threadCount = 0);
+		ParallelRecorder(const ParallelRecorder&) = delete;
+		ParallelRecorder& operator=(const ParallelRecorder&) = delete;
+		ParallelRecorder(ParallelRecorder&&) = delete;
+		ParallelRecorder& operator=(ParallelRecorder&&) = delete;
+		~ParallelRecorder();
+
+		std::uint32_t ThreadCount() const;
+		std::uint32_t Count() const;
+
+		// Returns the slot to Replay() once recorded.
+		std::uint32_t Add(const RecordFunction& record);
+
+		// The workers start recording; the caller is free to do other work until Wait().
+		void Start();
+
+		// Helps record whatever is left and returns once every slot is recorded.
+		void Wait();
+
+		// Start() and Wait() in one.
+		void Record();
+
+		const CommandBuffer& Buffer(std::uint32_t slot) const;
+		void Replay(std::uint32_t slot, RenderBackend& target) const;
+		void ReplayAll(RenderBackend& target) const;
+
+		// Drops the record functions; the buffers keep their memory for the next frame.
+		void Clear();
+
+	private:
+		void WorkerLoop();
+		void RecordSlots();
+
+		std::vector<RecordFunction> mRecords;
+		std::vector<CommandBuffer> mBuffers;
+
+		std::vector<std::thread> mWorkers;
+		std::mutex mMutex;
+		std::condition_variable mWorkReady;
+		std::condition_variable mWorkDone;
+		std::atomic<std::uint32_t> mNextSlot;
+		std::uint64_t mGeneration;
+		std::uint32_t mBusyWorkers;
+		bool mStarted;
+		bool mStopping;
+	};
+}
+
+#include "ParallelRecorder.inl"
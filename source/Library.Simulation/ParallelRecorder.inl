@@ -0,0 +1,24 @@
+#pragma once
+
+namespace Simulation
+{
+	inline std::uint32_t ParallelRecorder::ThreadCount() const
+	{
+		return static_cast<std::uint32_t>(mWorkers.size()) + 1;
+	}
+
+	inline std::uint32_t ParallelRecorder::Count() const
+	{
+		return static_cast<std::uint32_t>(mRecords.size());
+	}
+
+	inline const CommandBuffer& ParallelRecorder::Buffer(std::uint32_t slot) const
+	{
+		return mBuffers[slot];
+	}
+
+	inline void ParallelRecorder::Replay(std::uint32_t slot, RenderBackend& target) const
+	{
+		mBuffers[slot].Execute(target);
+	}
+}
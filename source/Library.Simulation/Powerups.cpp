@@ -0,0 +1,45 @@
+#include "pch.h"
+#include "Powerups.h"
+#include "Board.h"
+#include "OccupancyGrid.h"
+#include "Random.h"
+
+namespace Simulation
+{
+	Powerups::Powerups() :
+		mCherryPosition(Board::Center() + Cell(4, 4)), mCoinPosition(Board::Center() + Cell(2, 2))
+	{
+	}
+
+	const Cell& Powerups::GetCherryPosition() const
+	{
+		return mCherryPosition;
+	}
+
+	const Cell& Powerups::GetCoinPosition() const
+	{
+		return mCoinPosition;
+	}
+
+	bool Powerups::RespawnCherry(const OccupancyGrid& occupancy, Random& random, const Cell& avoid)
+	{
+		if (!occupancy.SampleFreeCell(random.Next(), avoid, mCherryPosition))
+		{
+			mCherryPosition = Cell(-1, -1);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool Powerups::RespawnCoin(const OccupancyGrid& occupancy, Random& random, const Cell& avoid)
+	{
+		if (!occupancy.SampleFreeCell(random.Next(), avoid, mCoinPosition))
+		{
+			mCoinPosition = Cell(-1, -1);
+			return false;
+		}
+
+		return true;
+	}
+}
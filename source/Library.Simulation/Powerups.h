@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Cell.h"
+
+namespace Simulation
+{
+	class OccupancyGrid;
+	class Random;
+
+	class Powerups final
+	{
+	public:
+		Powerups();
+		Powerups(const Powerups&) = default;
+		Powerups& operator=(const Powerups&) = default;
+		Powerups(Powerups&&) = default;
+		Powerups& operator=(Powerups&&) = default;
+		~Powerups() = default;
+
+		const Cell& GetCherryPosition() const;
+		const Cell& GetCoinPosition() const;
+
+		// Moves the powerup to a random empty cell other than avoid. Returns false, leaving
+		// the powerup off the board, when every cell is taken.
+		bool RespawnCherry(const OccupancyGrid& occupancy, Random& random, const Cell& avoid);
+		bool RespawnCoin(const OccupancyGrid& occupancy, Random& random, const Cell& avoid);
+
+	private:
+		Cell mCherryPosition;
+		Cell mCoinPosition;
+	};
+}
@@ -0,0 +1,180 @@
+#include "pch.h"
+#include "Profiler.h"
+#include <cstdio>
+#include <ostream>
+
+using namespace std;
+
+namespace Simulation
+{
+	namespace
+	{
+		// Which profiler the current thread last recorded into, and its buffer there. Serials
+		// rather than addresses, so a profiler created where another was can't be mistaken for it.
+		thread_local uint64_t tProfilerSerial = 0;
+		thread_local void* tBuffer = nullptr;
+
+		atomic<uint64_t> sNextSerial(1);
+
+		void WriteEscaped(ostream& stream, const char* text)
+		{
+			for (const char* c = text; *c != '\0'; c++)
+			{
+				if (*c == '"' || *c == '\\')
+				{
+					stream << '\\' << *c;
+				}
+				else if (static_cast<unsigned char>(*c) < 0x20)
+				{
+					char escaped[8];
+					snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(*c));
+					stream << escaped;
+				}
+				else
+				{
+					stream << *c;
+				}
+			}
+		}
+
+		// Nanoseconds as microseconds, the unit Chrome traces use.
+		void WriteMicroseconds(ostream& stream, int64_t nanoseconds)
+		{
+			char text[32];
+			snprintf(text, sizeof(text), "%.3f", static_cast<double>(nanoseconds) / 1000.0);
+			stream << text;
+		}
+	}
+
+	const uint32_t Profiler::DefaultEventsPerThread;
+
+	Profiler& Profiler::GetInstance()
+	{
+		static Profiler sInstance;
+		return sInstance;
+	}
+
+	Profiler::Profiler(uint32_t eventsPerThread) :
+		mSerial(sNextSerial.fetch_add(1, memory_order_relaxed)), mEventsPerThread(eventsPerThread), mEpoch(Now()), mEnabled(false)
+	{
+	}
+
+	void Profiler::Record(const char* name, uint64_t start, uint64_t end)
+	{
+		ThreadBuffer& buffer = CurrentBuffer();
+		const uint32_t count = buffer.Count.load(memory_order_relaxed);
+		if (count == mEventsPerThread)
+		{
+			buffer.Dropped.fetch_add(1, memory_order_relaxed);
+			return;
+		}
+
+		Event& event = buffer.Events[count];
+		event.Name = name;
+		event.Start = start;
+		event.Duration = end - start;
+		buffer.Count.store(count + 1, memory_order_release);
+	}
+
+	void Profiler::Clear()
+	{
+		lock_guard<mutex> lock(mBuffersMutex);
+		for (auto& buffer : mBuffers)
+		{
+			buffer->Count.store(0, memory_order_relaxed);
+			buffer->Dropped.store(0, memory_order_relaxed);
+		}
+	}
+
+	uint64_t Profiler::EventCount() const
+	{
+		uint64_t count = 0;
+		for (const ThreadBuffer* buffer : Buffers())
+		{
+			count += buffer->Count.load(memory_order_acquire);
+		}
+		return count;
+	}
+
+	uint64_t Profiler::DroppedCount() const
+	{
+		uint64_t dropped = 0;
+		for (const ThreadBuffer* buffer : Buffers())
+		{
+			dropped += buffer->Dropped.load(memory_order_relaxed);
+		}
+		return dropped;
+	}
+
+	void Profiler::WriteChromeTrace(ostream& stream) const
+	{
+		stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+		bool first = true;
+		ForEachEvent([&](uint32_t threadId, const Event& event)
+		{
+			stream << (first ? "\n" : ",\n") << "{\"name\":\"";
+			WriteEscaped(stream, event.Name);
+			stream << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadId << ",\"ts\":";
+			WriteMicroseconds(stream, static_cast<int64_t>(event.Start - mEpoch));
+			stream << ",\"dur\":";
+			WriteMicroseconds(stream, static_cast<int64_t>(event.Duration));
+			stream << '}';
+			first = false;
+		});
+		stream << "\n]}\n";
+	}
+
+	Profiler::ThreadBuffer& Profiler::CurrentBuffer()
+	{
+		if (tProfilerSerial == mSerial)
+		{
+			return *static_cast<ThreadBuffer*>(tBuffer);
+		}
+		return Register();
+	}
+
+	// A thread that comes back after recording into another profiler finds its old buffer.
+	Profiler::ThreadBuffer& Profiler::Register()
+	{
+		const thread::id current = this_thread::get_id();
+		ThreadBuffer* found = nullptr;
+		{
+			lock_guard<mutex> lock(mBuffersMutex);
+			for (auto& buffer : mBuffers)
+			{
+				if (buffer->Thread == current)
+				{
+					found = buffer.get();
+					break;
+				}
+			}
+			if (found == nullptr)
+			{
+				auto buffer = make_unique<ThreadBuffer>();
+				buffer->Thread = current;
+				buffer->Id = static_cast<uint32_t>(mBuffers.size()) + 1;
+				buffer->Events = make_unique<Event[]>(mEventsPerThread);
+				buffer->Count.store(0, memory_order_relaxed);
+				buffer->Dropped.store(0, memory_order_relaxed);
+				found = buffer.get();
+				mBuffers.push_back(move(buffer));
+			}
+		}
+
+		tProfilerSerial = mSerial;
+		tBuffer = found;
+		return *found;
+	}
+
+	vector<const Profiler::ThreadBuffer*> Profiler::Buffers() const
+	{
+		lock_guard<mutex> lock(mBuffersMutex);
+		vector<const ThreadBuffer*> buffers;
+		buffers.reserve(mBuffers.size());
+		for (auto& buffer : mBuffers)
+		{
+			buffers.push_back(buffer.get());
+		}
+		return buffers;
+	}
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Zones are compiled into debug builds and any build that defines SIMULATION_PROFILING.
+// Everywhere else SIMULATION_PROFILE_ZONE expands to nothing, name expression included.
+#if defined(_DEBUG) && !defined(SIMULATION_PROFILING)
+#define SIMULATION_PROFILING
+#endif
+
+#if defined(SIMULATION_PROFILING)
+#define SIMULATION_PROFILE_CONCAT_INNER(a, b) a##b
+#define SIMULATION_PROFILE_CONCAT(a, b) SIMULATION_PROFILE_CONCAT_INNER(a, b)
+#define SIMULATION_PROFILE_ZONE(name) ::Simulation::ProfileZone SIMULATION_PROFILE_CONCAT(profileZone, __LINE__)(name)
+#else
+#define SIMULATION_PROFILE_ZONE(name) ((void)0)
+#endif
+
+namespace Simulation
+{
+	// Records how long zones of code take, on any number of threads, and writes them out as
+	// a Chrome trace for chrome://tracing or Perfetto. Each thread appends to a buffer of its
+	// own without taking a lock; only its first zone registers the buffer. A full buffer
+	// drops further zones and counts them. Recording starts disabled.
+	class Profiler final
+	{
+	public:
+		struct Event final
+		{
+			// Must outlive the profiler: a string literal, or a type's name.
+			const char* Name;
+			std::uint64_t Start;
+			std::uint64_t Duration;
+		};
+
+		static const std::uint32_t DefaultEventsPerThread = 1 << 16;
+
+		static Profiler& GetInstance();
+
+		// Nanoseconds on a steady clock.
+		static std::uint64_t Now();
+
+		explicit Profiler(std::uint32_t eventsPerThread = DefaultEventsPerThread);
+		Profiler(const Profiler&) = delete;
+		Profiler& operator=(const Profiler&) = delete;
+		Profiler(Profiler&&) = delete;
+		Profiler& operator=(Profiler&&) = delete;
+		~Profiler() = default;
+
+		bool Enabled() const;
+		void SetEnabled(bool enabled);
+
+		// Adds a zone that ran on the calling thread from start to end.
+		void Record(const char* name, std::uint64_t start, std::uint64_t end);
+
+		// Forgets every zone recorded so far. Only call it while no thread is recording, for
+		// instance between frames.
+		void Clear();
+
+		std::uint64_t EventCount() const;
+		std::uint64_t DroppedCount() const;
+
+		// Calls visitor(threadId, event) for every zone recorded, thread by thread; ids count
+		// from 1 in the order threads first recorded.
+		template <typename TVisitor>
+		void ForEachEvent(const TVisitor& visitor) const;
+
+		// Writes every zone as a complete ("X") event, with microsecond timestamps relative to
+		// the profiler's creation. Safe while other threads keep recording.
+		void WriteChromeTrace(std::ostream& stream) const;
+
+	private:
+		struct ThreadBuffer final
+		{
+			std::thread::id Thread;
+			std::uint32_t Id;
+			std::unique_ptr<Event[]> Events;
+			// Published with a release store once the event below it is written.
+			std::atomic<std::uint32_t> Count;
+			std::atomic<std::uint64_t> Dropped;
+		};
+
+		ThreadBuffer& CurrentBuffer();
+		ThreadBuffer& Register();
+		std::vector<const ThreadBuffer*> Buffers() const;
+
+		std::uint64_t mSerial;
+		std::uint32_t mEventsPerThread;
+		std::uint64_t mEpoch;
+		std::atomic<bool> mEnabled;
+		mutable std::mutex mBuffersMutex;
+		std::vector<std::unique_ptr<ThreadBuffer>> mBuffers;
+	};
+
+	// Times its own lifetime into Profiler::GetInstance() if recording was enabled when it
+	// began. Use it through SIMULATION_PROFILE_ZONE so release builds leave it out.
+	class ProfileZone final
+	{
+	public:
+		explicit ProfileZone(const char* name);
+		ProfileZone(const ProfileZone&) = delete;
+		ProfileZone& operator=(const ProfileZone&) = delete;
+		ProfileZone(ProfileZone&&) = delete;
+		ProfileZone& operator=(ProfileZone&&) = delete;
+		~ProfileZone();
+
+	private:
+		const char* mName;
+		Profiler* mProfiler;
+		std::uint64_t mStart;
+	};
+}
+
+#include "Profiler.inl"
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <chrono>
+
+namespace Simulation
+{
+	inline std::uint64_t Profiler::Now()
+	{
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	inline bool Profiler::Enabled() const
+	{
+		return mEnabled.load(std::memory_order_relaxed);
+	}
+
+	inline void Profiler::SetEnabled(bool enabled)
+	{
+		mEnabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	template <typename TVisitor>
+	inline void Profiler::ForEachEvent(const TVisitor& visitor) const
+	{
+		for (const ThreadBuffer* buffer : Buffers())
+		{
+			const std::uint32_t count = buffer->Count.load(std::memory_order_acquire);
+			for (std::uint32_t i = 0; i < count; i++)
+			{
+				visitor(buffer->Id, buffer->Events[i]);
+			}
+		}
+	}
+
+	inline ProfileZone::ProfileZone(const char* name) :
+		mName(name), mProfiler(nullptr), mStart(0)
+	{
+		Profiler& profiler = Profiler::GetInstance();
+		if (profiler.Enabled())
+		{
+			mProfiler = &profiler;
+			mStart = Profiler::Now();
+		}
+	}
+
+	inline ProfileZone::~ProfileZone()
+	{
+		if (mProfiler != nullptr)
+		{
+			mProfiler->Record(mName, mStart, Profiler::Now());
+		}
+	}
+}
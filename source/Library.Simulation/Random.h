@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Simulation
+{
+	// Small xorshift generator. Gameplay draws from this rather than <random> so that a seed
+	// produces the same game on every compiler and platform.
+	class Random final
+	{
+	public:
+		explicit Random(std::uint32_t seed);
+		Random(const Random&) = default;
+		Random& operator=(const Random&) = default;
+		Random(Random&&) = default;
+		Random& operator=(Random&&) = default;
+		~Random() = default;
+
+		// Advances a state kept outside any Random, such as one of many held side by side in
+		// an array, and returns it. The same sequence Random produces.
+		static std::uint32_t Next(std::uint32_t& state);
+
+		std::uint32_t State() const;
+		std::uint32_t Next();
+
+	private:
+		std::uint32_t mState;
+	};
+}
+
+#include "Random.inl"
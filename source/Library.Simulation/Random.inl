@@ -0,0 +1,32 @@
+#pragma once
+
+namespace Simulation
+{
+	inline Random::Random(std::uint32_t seed)
+	{
+		// Scramble the seed so that neighbouring seeds start far apart; the state must never be zero.
+		seed *= 0x9E3779B9u;
+		seed ^= seed >> 16;
+		seed *= 0x85EBCA6Bu;
+		seed ^= seed >> 13;
+		mState = seed != 0 ? seed : 1;
+	}
+
+	inline std::uint32_t Random::Next(std::uint32_t& state)
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+
+	inline std::uint32_t Random::State() const
+	{
+		return mState;
+	}
+
+	inline std::uint32_t Random::Next()
+	{
+		return Next(mState);
+	}
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Simulation
+{
+	enum class Topology : std::uint8_t
+	{
+		TriangleList,
+		TriangleStrip,
+		LineList,
+		LineStrip
+	};
+
+	// Laid out like DX::VertexPositionColor and DX::VertexPositionTexture, so either
+	// backend can copy them straight into its buffers.
+	struct ColorVertex final
+	{
+		float Position[4];
+		float Color[4];
+	};
+
+	struct TextureVertex final
+	{
+		float Position[4];
+		float TextureCoordinates[2];
+	};
+
+	// Splits a draw of count vertices, or indices, into pieces of at most capacity that end on
+	// whole primitives, calling visitor(first, count) for each. A strip piece starts on the
+	// last vertices of the one before so no primitive goes missing, and triangle strip pieces
+	// advance by an even count so every triangle keeps its winding.
+	template <typename TVisitor>
+	void ForEachPrimitiveChunk(Topology topology, std::uint32_t count, std::uint32_t capacity, const TVisitor& visitor);
+
+	// Row-vector convention, as DirectXMath: clip = position * M.
+	struct Matrix4 final
+	{
+		float M[4][4];
+	};
+
+	// Where components send what they draw: solid and per-vertex-colored triangles and
+	// lines, and alpha-blended textured geometry. DX::D3D11RenderBackend draws on the GPU;
+	// SoftwareRasterizer draws into memory, so whole frames can be rendered, timed and
+	// compared pixel for pixel without one.
+	class RenderBackend
+	{
+	public:
+		typedef std::uint32_t TextureId;
+		static const TextureId NoTexture = 0;
+
+		RenderBackend() = default;
+		RenderBackend(const RenderBackend&) = default;
+		RenderBackend& operator=(const RenderBackend&) = default;
+		RenderBackend(RenderBackend&&) = default;
+		RenderBackend& operator=(RenderBackend&&) = default;
+		virtual ~RenderBackend() = default;
+
+		virtual void Clear(float red, float green, float blue, float alpha) = 0;
+		virtual void SetViewProjection(const Matrix4& viewProjection) = 0;
+
+		virtual void Draw(Topology topology, const ColorVertex* vertices, std::uint32_t vertexCount) = 0;
+		virtual void DrawIndexed(Topology topology, const ColorVertex* vertices, std::uint32_t vertexCount, const std::uint16_t* indices, std::uint32_t indexCount) = 0;
+
+		// Texels are 8-bit RGBA, red in the lowest byte. Returns NoTexture on failure.
+		virtual TextureId CreateTexture(std::uint32_t width, std::uint32_t height, const std::uint32_t* texels) = 0;
+		virtual void DrawTextured(TextureId texture, Topology topology, const TextureVertex* vertices, std::uint32_t vertexCount) = 0;
+
+		// Everything drawn since the last Submit() reaches the render target.
+		virtual void Submit() = 0;
+	};
+}
+
+#include "RenderBackend.inl"
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cassert>
+
+namespace Simulation
+{
+	template <typename TVisitor>
+	inline void ForEachPrimitiveChunk(Topology topology, std::uint32_t count, std::uint32_t capacity, const TVisitor& visitor)
+	{
+		if (count <= capacity)
+		{
+			visitor(0u, count);
+			return;
+		}
+
+		const bool triangles = topology == Topology::TriangleList || topology == Topology::TriangleStrip;
+		const bool strip = topology == Topology::TriangleStrip || topology == Topology::LineStrip;
+		const std::uint32_t overlap = strip ? (triangles ? 2 : 1) : 0;
+		const std::uint32_t step = strip ? (triangles ? 2 : 1) : (triangles ? 3 : 2);
+		const std::uint32_t chunk = capacity - capacity % step;
+		assert(chunk > overlap);
+
+		std::uint32_t first = 0;
+		while (count - first > chunk)
+		{
+			visitor(first, chunk);
+			first += chunk - overlap;
+		}
+		visitor(first, count - first);
+	}
+}
@@ -0,0 +1,131 @@
+#include "pch.h"
+#include "RenderQueue.h"
+
+using namespace std;
+
+namespace Simulation
+{
+	RenderQueue::Statistics RenderQueue::Execute(Executor& executor)
+	{
+		Statistics statistics = { 0, 0, 0 };
+		Sort();
+
+		DrawState bound = {};
+		bool valid = false;
+		for (uint32_t index : mOrder)
+		{
+			const Item& item = mItems[index];
+			++statistics.Draws;
+			if (item.Opaque)
+			{
+				executor.Draw(item.Command);
+				valid = false;
+				continue;
+			}
+
+			const DrawState& state = item.State;
+			uint32_t changes = 0;
+			if (!valid || state.Pipeline != bound.Pipeline)
+			{
+				executor.BindPipeline(state.Pipeline);
+				++changes;
+			}
+			if (!valid || state.Topology != bound.Topology)
+			{
+				executor.BindTopology(state.Topology);
+				++changes;
+			}
+			if (!valid || state.Texture != bound.Texture)
+			{
+				executor.BindTexture(state.Texture);
+				++changes;
+			}
+			if (!valid || state.Geometry != bound.Geometry)
+			{
+				executor.BindGeometry(state.Geometry);
+				++changes;
+			}
+			if (!valid || state.Constants != bound.Constants)
+			{
+				executor.BindConstants(state.Constants);
+				++changes;
+			}
+			executor.Draw(item.Command);
+
+			statistics.StateChanges += changes;
+			statistics.ElidedStateChanges += SlotCount - changes;
+			bound = state;
+			valid = true;
+		}
+
+		Clear();
+		return statistics;
+	}
+
+	// Least significant digit radix sort over the key bytes that differ at all; each pass is
+	// stable, so ties stay in submission order.
+	void RenderQueue::Sort()
+	{
+		const uint32_t count = static_cast<uint32_t>(mItems.size());
+		mOrder.resize(count);
+		mScratch.resize(count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			mOrder[i] = i;
+		}
+		if (count < 2)
+		{
+			return;
+		}
+
+		// A frame of a few draws is cheaper to insertion sort than to count 256 digits for.
+		if (count <= InsertionSortLimit)
+		{
+			for (uint32_t i = 1; i < count; i++)
+			{
+				const uint32_t index = mOrder[i];
+				uint32_t j = i;
+				for (; j > 0 && mItems[mOrder[j - 1]].Key > mItems[index].Key; j--)
+				{
+					mOrder[j] = mOrder[j - 1];
+				}
+				mOrder[j] = index;
+			}
+			return;
+		}
+
+		uint64_t differing = 0;
+		for (const Item& item : mItems)
+		{
+			differing |= item.Key ^ mItems[0].Key;
+		}
+
+		for (uint32_t shift = 0; shift < 64; shift += 8)
+		{
+			if (((differing >> shift) & 0xFF) == 0)
+			{
+				continue;
+			}
+
+			uint32_t offsets[256] = {};
+			for (const Item& item : mItems)
+			{
+				++offsets[(item.Key >> shift) & 0xFF];
+			}
+
+			uint32_t total = 0;
+			for (uint32_t& offset : offsets)
+			{
+				const uint32_t digitCount = offset;
+				offset = total;
+				total += digitCount;
+			}
+
+			for (uint32_t index : mOrder)
+			{
+				mScratch[offsets[(mItems[index].Key >> shift) & 0xFF]++] = index;
+			}
+			mOrder.swap(mScratch);
+		}
+	}
+}
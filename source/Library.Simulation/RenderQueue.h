@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Simulation
+{
+	// Collects a frame's draws, sorts them by the state they need and replays them through
+	// an Executor that hears only about state that actually changes. Draws are grouped by
+	// layer first, so layers keep their painter's order; within a layer they are ordered by
+	// pipeline, topology and texture, and draws that tie keep their submission order.
+	// Geometry and constants are not part of the key; they are compared with the draw before.
+	class RenderQueue final
+	{
+	public:
+		static const std::uint32_t SlotCount = 5;
+
+		// Pipeline, topology and texture are small ids that make up the sort key; geometry
+		// and constants are opaque handles only compared for equality.
+		struct DrawState final
+		{
+			std::uint8_t Layer;
+			std::uint8_t Pipeline;
+			std::uint8_t Topology;
+			std::uint16_t Texture;
+			std::uintptr_t Geometry;
+			std::uintptr_t Constants;
+		};
+
+		struct Statistics final
+		{
+			std::uint32_t Draws;
+			std::uint32_t StateChanges;
+			std::uint32_t ElidedStateChanges;
+		};
+
+		// Applies state and issues draws for Execute(). command is whatever the submitter
+		// passed along with the draw.
+		class Executor
+		{
+		public:
+			Executor() = default;
+			Executor(const Executor&) = default;
+			Executor& operator=(const Executor&) = default;
+			Executor(Executor&&) = default;
+			Executor& operator=(Executor&&) = default;
+			virtual ~Executor() = default;
+
+			virtual void BindPipeline(std::uint8_t pipeline) = 0;
+			virtual void BindTopology(std::uint8_t topology) = 0;
+			virtual void BindTexture(std::uint16_t texture) = 0;
+			virtual void BindGeometry(std::uintptr_t geometry) = 0;
+			virtual void BindConstants(std::uintptr_t constants) = 0;
+			virtual void Draw(std::uint32_t command) = 0;
+		};
+
+		// Layer, pipeline, topology and texture from the most significant byte down.
+		static std::uint64_t SortKey(const DrawState& state);
+
+		RenderQueue() = default;
+		RenderQueue(const RenderQueue&) = default;
+		RenderQueue& operator=(const RenderQueue&) = default;
+		RenderQueue(RenderQueue&&) = default;
+		RenderQueue& operator=(RenderQueue&&) = default;
+		~RenderQueue() = default;
+
+		std::uint32_t Count() const;
+
+		void Submit(const DrawState& state, std::uint32_t command);
+
+		// A draw that sets its own state. It goes after the layer's other draws, and
+		// everything is bound again after it.
+		void SubmitOpaque(std::uint8_t layer, std::uint32_t command);
+
+		// Sorts, replays and empties the queue.
+		Statistics Execute(Executor& executor);
+
+		void Clear();
+
+	private:
+		struct Item final
+		{
+			std::uint64_t Key;
+			DrawState State;
+			std::uint32_t Command;
+			bool Opaque;
+		};
+
+		static const std::uint32_t InsertionSortLimit = 32;
+
+		void Sort();
+
+		std::vector<Item> mItems;
+		std::vector<std::uint32_t> mOrder;
+		std::vector<std::uint32_t> mScratch;
+	};
+}
+
+#include "RenderQueue.inl"
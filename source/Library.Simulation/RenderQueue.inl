@@ -0,0 +1,32 @@
+#pragma once
+
+namespace Simulation
+{
+	inline std::uint64_t RenderQueue::SortKey(const DrawState& state)
+	{
+		return (static_cast<std::uint64_t>(state.Layer) << 56) | (static_cast<std::uint64_t>(state.Pipeline) << 48) |
+			(static_cast<std::uint64_t>(state.Topology) << 40) | (static_cast<std::uint64_t>(state.Texture) << 24);
+	}
+
+	inline std::uint32_t RenderQueue::Count() const
+	{
+		return static_cast<std::uint32_t>(mItems.size());
+	}
+
+	inline void RenderQueue::Submit(const DrawState& state, std::uint32_t command)
+	{
+		mItems.push_back({ SortKey(state), state, command, false });
+	}
+
+	inline void RenderQueue::SubmitOpaque(std::uint8_t layer, std::uint32_t command)
+	{
+		// Past every real pipeline id, so it sorts behind the layer's other draws.
+		const DrawState state = { layer, 0xFF, 0xFF, 0xFFFF, 0, 0 };
+		mItems.push_back({ SortKey(state), state, command, true });
+	}
+
+	inline void RenderQueue::Clear()
+	{
+		mItems.clear();
+	}
+}
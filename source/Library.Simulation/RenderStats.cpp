@@ -0,0 +1,26 @@
+#include "pch.h"
+#include "RenderStats.h"
+
+namespace Simulation
+{
+	RenderStats& RenderStats::GetInstance()
+	{
+		static RenderStats sInstance;
+		return sInstance;
+	}
+
+	RenderStats::RenderStats() :
+		mCurrentFrame(), mLastFrame(), mFrameCount(0)
+	{
+	}
+
+	void RenderStats::BeginFrame()
+	{
+		if (mFrameCount > 0)
+		{
+			mLastFrame = mCurrentFrame;
+		}
+		mCurrentFrame = Counters();
+		++mFrameCount;
+	}
+}
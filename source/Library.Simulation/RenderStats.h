@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Simulation
+{
+	// Counts what the renderer hands to the graphics API each frame: draw calls, the
+	// instances they cover, buffer uploads and pipeline state changes. It knows nothing
+	// about any particular API, so a headless run counts exactly what the game would submit
+	// and draw-count budgets can be checked without a GPU.
+	class RenderStats final
+	{
+	public:
+		struct Counters final
+		{
+			std::uint32_t DrawCalls;
+			std::uint32_t Instances;
+			std::uint32_t BufferUploads;
+			std::uint32_t ConstantBufferUploads;
+			std::uint64_t UploadBytes;
+			std::uint32_t StateChanges;
+			std::uint32_t ElidedStateChanges;
+		};
+
+		static RenderStats& GetInstance();
+
+		RenderStats();
+		RenderStats(const RenderStats&) = default;
+		RenderStats& operator=(const RenderStats&) = default;
+		RenderStats(RenderStats&&) = default;
+		RenderStats& operator=(RenderStats&&) = default;
+		~RenderStats() = default;
+
+		// Closes the frame in progress; its counters become LastFrame().
+		void BeginFrame();
+		void RecordDraw(std::uint32_t instanceCount = 1);
+		void RecordUpload(std::uint64_t byteCount);
+
+		// A buffer upload that also counts toward ConstantBufferUploads.
+		void RecordConstantBufferUpload(std::uint64_t byteCount);
+
+		// elided counts the bindings skipped because the state was already set; applied plus
+		// elided is what rebinding everything for every draw would have cost.
+		void RecordStateChanges(std::uint32_t applied, std::uint32_t elided);
+
+		const Counters& CurrentFrame() const;
+		const Counters& LastFrame() const;
+		std::uint64_t FrameCount() const;
+
+	private:
+		Counters mCurrentFrame;
+		Counters mLastFrame;
+		std::uint64_t mFrameCount;
+	};
+}
+
+#include "RenderStats.inl"
@@ -0,0 +1,43 @@
+#pragma once
+
+namespace Simulation
+{
+	inline void RenderStats::RecordDraw(std::uint32_t instanceCount)
+	{
+		++mCurrentFrame.DrawCalls;
+		mCurrentFrame.Instances += instanceCount;
+	}
+
+	inline void RenderStats::RecordUpload(std::uint64_t byteCount)
+	{
+		++mCurrentFrame.BufferUploads;
+		mCurrentFrame.UploadBytes += byteCount;
+	}
+
+	inline void RenderStats::RecordConstantBufferUpload(std::uint64_t byteCount)
+	{
+		RecordUpload(byteCount);
+		++mCurrentFrame.ConstantBufferUploads;
+	}
+
+	inline void RenderStats::RecordStateChanges(std::uint32_t applied, std::uint32_t elided)
+	{
+		mCurrentFrame.StateChanges += applied;
+		mCurrentFrame.ElidedStateChanges += elided;
+	}
+
+	inline const RenderStats::Counters& RenderStats::CurrentFrame() const
+	{
+		return mCurrentFrame;
+	}
+
+	inline const RenderStats::Counters& RenderStats::LastFrame() const
+	{
+		return mLastFrame;
+	}
+
+	inline std::uint64_t RenderStats::FrameCount() const
+	{
+		return mFrameCount;
+	}
+}
@@ -0,0 +1,209 @@
+#include "pch.h"
+#include "Replay.h"
+#include "Board.h"
+#include <istream>
+#include <iterator>
+#include <ostream>
+
+using namespace std;
+
+namespace Simulation
+{
+	const uint32_t ReplayHeader::MagicValue;
+	const uint32_t ReplayHeader::CurrentVersion;
+
+	namespace
+	{
+		const uint32_t MaxRun = 62;
+		const uint8_t SkipByte = 0xFC;
+		const uint8_t ExtendedByte = 0xFD;
+		const uint32_t SkipTicks = 63;
+	}
+
+	ReplayRecorder::ReplayRecorder(uint32_t seed) :
+		mSeed(seed), mLastTick(0)
+	{
+	}
+
+	uint32_t ReplayRecorder::Seed() const
+	{
+		return mSeed;
+	}
+
+	const vector<uint8_t>& ReplayRecorder::Stream() const
+	{
+		return mStream;
+	}
+
+	void ReplayRecorder::RecordMove(uint64_t tick, Direction direction)
+	{
+		switch (direction)
+		{
+		case Direction::Up:
+			Record(tick, ReplayInput::Up);
+			break;
+		case Direction::Down:
+			Record(tick, ReplayInput::Down);
+			break;
+		case Direction::Left:
+			Record(tick, ReplayInput::Left);
+			break;
+		case Direction::Right:
+			Record(tick, ReplayInput::Right);
+			break;
+		default:
+			Record(tick, ReplayInput::Stop);
+			break;
+		}
+	}
+
+	void ReplayRecorder::RecordGrow(uint64_t tick)
+	{
+		Record(tick, ReplayInput::Grow);
+	}
+
+	void ReplayRecorder::Clear()
+	{
+		mLastTick = 0;
+		mStream.clear();
+	}
+
+	vector<uint8_t> ReplayRecorder::Image(uint64_t tickCount) const
+	{
+		ReplayHeader header;
+		header.Magic = ReplayHeader::MagicValue;
+		header.Version = ReplayHeader::CurrentVersion;
+		header.Seed = mSeed;
+		header.BoardWidth = static_cast<uint16_t>(Board::Width);
+		header.BoardHeight = static_cast<uint16_t>(Board::Height);
+		header.TickCount = tickCount;
+		header.StreamSize = static_cast<uint32_t>(mStream.size());
+		header.Reserved = 0;
+
+		vector<uint8_t> image(sizeof(ReplayHeader) + mStream.size());
+		memcpy(image.data(), &header, sizeof(ReplayHeader));
+		if (!mStream.empty())
+		{
+			memcpy(image.data() + sizeof(ReplayHeader), mStream.data(), mStream.size());
+		}
+
+		return image;
+	}
+
+	bool ReplayRecorder::Write(ostream& stream, uint64_t tickCount) const
+	{
+		const vector<uint8_t> image = Image(tickCount);
+		stream.write(reinterpret_cast<const char*>(image.data()), static_cast<streamsize>(image.size()));
+		return stream.good();
+	}
+
+	void ReplayRecorder::Record(uint64_t tick, ReplayInput input)
+	{
+		assert(tick >= mLastTick);
+
+		uint64_t run = tick - mLastTick;
+		while (run > MaxRun)
+		{
+			mStream.push_back(SkipByte);
+			run -= SkipTicks;
+		}
+
+		if (input == ReplayInput::Grow || input == ReplayInput::Stop)
+		{
+			mStream.push_back(ExtendedByte);
+			mStream.push_back(static_cast<uint8_t>((run << 2) | (input == ReplayInput::Grow ? 0 : 1)));
+		}
+		else
+		{
+			mStream.push_back(static_cast<uint8_t>((run << 2) | static_cast<uint8_t>(input)));
+		}
+
+		mLastTick = tick;
+	}
+
+	ReplayReader::ReplayReader() :
+		mHeader(), mStream(nullptr), mValid(false)
+	{
+	}
+
+	ReplayReader::ReplayReader(const void* data, size_t size) :
+		mHeader(), mStream(nullptr), mValid(false)
+	{
+		if (data == nullptr || size < sizeof(ReplayHeader))
+		{
+			return;
+		}
+
+		// Copied out rather than cast in place, as a mapped file need not be aligned.
+		memcpy(&mHeader, data, sizeof(ReplayHeader));
+		mStream = static_cast<const uint8_t*>(data) + sizeof(ReplayHeader);
+		mValid = mHeader.Magic == ReplayHeader::MagicValue && mHeader.Version == ReplayHeader::CurrentVersion &&
+			mHeader.BoardWidth == Board::Width && mHeader.BoardHeight == Board::Height &&
+			mHeader.StreamSize <= size - sizeof(ReplayHeader);
+	}
+
+	bool ReplayReader::Read(istream& stream, vector<uint8_t>& image)
+	{
+		image.assign(istreambuf_iterator<char>(stream), istreambuf_iterator<char>());
+		return !stream.bad();
+	}
+
+	bool ReplayReader::IsValid() const
+	{
+		return mValid;
+	}
+
+	uint32_t ReplayReader::Seed() const
+	{
+		return mHeader.Seed;
+	}
+
+	uint64_t ReplayReader::TickCount() const
+	{
+		return mHeader.TickCount;
+	}
+
+	uint32_t ReplayReader::StreamSize() const
+	{
+		return mValid ? mHeader.StreamSize : 0;
+	}
+
+	bool ReplayReader::Next(size_t& offset, uint64_t& tick, ReplayInput& input) const
+	{
+		const size_t size = StreamSize();
+		while (offset < size)
+		{
+			const uint8_t value = mStream[offset++];
+			if (value == SkipByte)
+			{
+				tick += SkipTicks;
+				continue;
+			}
+
+			if (value == ExtendedByte)
+			{
+				if (offset == size)
+				{
+					return false;
+				}
+
+				const uint8_t extended = mStream[offset++];
+				tick += extended >> 2;
+				input = (extended & 0x3) == 0 ? ReplayInput::Grow : ReplayInput::Stop;
+				return true;
+			}
+
+			// The remaining codes with a run of 63 are reserved.
+			if ((value >> 2) > MaxRun)
+			{
+				return false;
+			}
+
+			tick += value >> 2;
+			input = static_cast<ReplayInput>(value & 0x3);
+			return true;
+		}
+
+		return false;
+	}
+}
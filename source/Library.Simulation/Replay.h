@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Snake.h"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+namespace Simulation
+{
+	// A replay is the game's seed plus every input it received, each stamped with the tick
+	// it arrived before. The simulation is deterministic, so that is enough to rebuild the
+	// whole game.
+	//
+	// The file is a ReplayHeader followed by the input stream, byte for byte as it sits in
+	// memory (little-endian), so a mapped file can be read in place. Each stream byte is
+	// (run << 2) | code:
+	//   run 0-62       code is a move Up/Down/Left/Right, arriving run ticks after the previous input
+	//   0xFC           no input for 63 ticks
+	//   0xFD           extended input; the next byte is (run << 2) | code with code 0 Grow, 1 Stop
+	// Idle play costs a byte per 63 ticks, so an hour of play takes a few kilobytes.
+	struct ReplayHeader final
+	{
+		static const std::uint32_t MagicValue = 0x4C505253; // "SRPL"
+		static const std::uint32_t CurrentVersion = 1;
+
+		std::uint32_t Magic;
+		std::uint32_t Version;
+		std::uint32_t Seed;
+		std::uint16_t BoardWidth;
+		std::uint16_t BoardHeight;
+		std::uint64_t TickCount;
+		std::uint32_t StreamSize;
+		std::uint32_t Reserved;
+	};
+
+	enum class ReplayInput : std::uint8_t
+	{
+		Up, Down, Left, Right, Stop, Grow
+	};
+
+	class ReplayRecorder final
+	{
+	public:
+		explicit ReplayRecorder(std::uint32_t seed);
+		ReplayRecorder(const ReplayRecorder&) = default;
+		ReplayRecorder& operator=(const ReplayRecorder&) = default;
+		ReplayRecorder(ReplayRecorder&&) = default;
+		ReplayRecorder& operator=(ReplayRecorder&&) = default;
+		~ReplayRecorder() = default;
+
+		std::uint32_t Seed() const;
+		const std::vector<std::uint8_t>& Stream() const;
+
+		// Inputs must be recorded in tick order.
+		void RecordMove(std::uint64_t tick, Direction direction);
+		void RecordGrow(std::uint64_t tick);
+		void Clear();
+
+		// The complete file contents for a game that ran for tickCount ticks.
+		std::vector<std::uint8_t> Image(std::uint64_t tickCount) const;
+		bool Write(std::ostream& stream, std::uint64_t tickCount) const;
+
+	private:
+		void Record(std::uint64_t tick, ReplayInput input);
+
+		std::uint32_t mSeed;
+		std::uint64_t mLastTick;
+		std::vector<std::uint8_t> mStream;
+	};
+
+	// Decodes a replay image without copying it; the bytes must outlive the reader.
+	class ReplayReader final
+	{
+	public:
+		ReplayReader();
+		ReplayReader(const void* data, std::size_t size);
+		ReplayReader(const ReplayReader&) = default;
+		ReplayReader& operator=(const ReplayReader&) = default;
+		ReplayReader(ReplayReader&&) = default;
+		ReplayReader& operator=(ReplayReader&&) = default;
+		~ReplayReader() = default;
+
+		static bool Read(std::istream& stream, std::vector<std::uint8_t>& image);
+
+		// False for a truncated image, the wrong magic or version, or a different board size.
+		bool IsValid() const;
+		std::uint32_t Seed() const;
+		std::uint64_t TickCount() const;
+		std::uint32_t StreamSize() const;
+
+		// Decodes the input at offset and moves offset past it. tick is advanced by the input's
+		// run. Returns false at the end of the stream.
+		bool Next(std::size_t& offset, std::uint64_t& tick, ReplayInput& input) const;
+
+	private:
+		ReplayHeader mHeader;
+		const std::uint8_t* mStream;
+		bool mValid;
+	};
+}
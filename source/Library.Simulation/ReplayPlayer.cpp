@@ -0,0 +1,103 @@
+#include "pch.h"
+#include "ReplayPlayer.h"
+
+using namespace std;
+
+namespace Simulation
+{
+	ReplayPlayer::ReplayPlayer(const ReplayReader& replay) :
+		mReplay(replay), mGame(replay.Seed()), mOffset(0), mInputTick(0), mInput(ReplayInput::Up), mHasInput(false), mNanosecondsSinceUpdate(0), mNanosecondRemainder(0.0)
+	{
+		mHasInput = mReplay.Next(mOffset, mInputTick, mInput);
+	}
+
+	const Game& ReplayPlayer::GetGame() const
+	{
+		return mGame;
+	}
+
+	bool ReplayPlayer::Finished() const
+	{
+		return !mReplay.IsValid() || mGame.StepCount() >= mReplay.TickCount() || !mGame.GetSnake().Alive();
+	}
+
+	bool ReplayPlayer::Step()
+	{
+		if (Finished())
+		{
+			return false;
+		}
+
+		ApplyPendingInputs();
+		mGame.Step();
+		return true;
+	}
+
+	uint64_t ReplayPlayer::RunToEnd()
+	{
+		uint64_t ticks = 0;
+		while (Step())
+		{
+			++ticks;
+		}
+
+		return ticks;
+	}
+
+	void ReplayPlayer::Update(double elapsedSeconds, double playbackSpeed)
+	{
+		// Kept in whole nanoseconds, like Game::Update(), so playback lands on the same tick
+		// boundaries. The interval is looked up every tick since eating or a grow input speeds
+		// the snake up.
+		mNanosecondsSinceUpdate += Game::ToNanoseconds(elapsedSeconds * playbackSpeed, mNanosecondRemainder);
+
+		ApplyPendingInputs();
+		while (!Finished() && mNanosecondsSinceUpdate >= mGame.StepInterval())
+		{
+			mNanosecondsSinceUpdate -= mGame.StepInterval();
+			Step();
+			ApplyPendingInputs();
+		}
+	}
+
+	void ReplayPlayer::ApplyPendingInputs()
+	{
+		if (Finished())
+		{
+			return;
+		}
+
+		while (mHasInput && mInputTick == mGame.StepCount())
+		{
+			Apply(mInput);
+			mHasInput = mReplay.Next(mOffset, mInputTick, mInput);
+		}
+	}
+
+	void ReplayPlayer::Apply(ReplayInput input)
+	{
+		switch (input)
+		{
+		case ReplayInput::Up:
+			mGame.Move(Direction::Up);
+			break;
+		case ReplayInput::Down:
+			mGame.Move(Direction::Down);
+			break;
+		case ReplayInput::Left:
+			mGame.Move(Direction::Left);
+			break;
+		case ReplayInput::Right:
+			mGame.Move(Direction::Right);
+			break;
+		case ReplayInput::Stop:
+			mGame.Move(Direction::Stop);
+			break;
+		case ReplayInput::Grow:
+			mGame.IncreaseTail();
+			break;
+		default:
+			break;
+		}
+	}
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Game.h"
+#include "Replay.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Simulation
+{
+	// Rebuilds a recorded game by feeding its inputs back into a fresh Game seeded the same
+	// way. Step() and RunToEnd() go as fast as the simulation allows; Update() paces the
+	// ticks by Game::StepInterval(), scaled by playbackSpeed, for watching a replay. The
+	// inputs recorded for a tick are applied as soon as the tick before it ends, so at normal
+	// speed playback ticks on the same frames as a live game whose inputs came then.
+	class ReplayPlayer final
+	{
+	public:
+		explicit ReplayPlayer(const ReplayReader& replay);
+		ReplayPlayer(const ReplayPlayer&) = default;
+		ReplayPlayer& operator=(const ReplayPlayer&) = default;
+		ReplayPlayer(ReplayPlayer&&) = default;
+		ReplayPlayer& operator=(ReplayPlayer&&) = default;
+		~ReplayPlayer() = default;
+
+		const Game& GetGame() const;
+		bool Finished() const;
+
+		// Applies the inputs recorded for the current tick and advances one tick. Returns
+		// false once the recording is exhausted.
+		bool Step();
+		std::uint64_t RunToEnd();
+		void Update(double elapsedSeconds, double playbackSpeed = 1.0);
+
+	private:
+		void Apply(ReplayInput input);
+		void ApplyPendingInputs();
+
+		ReplayReader mReplay;
+		Game mGame;
+		std::size_t mOffset;
+		std::uint64_t mInputTick;
+		ReplayInput mInput;
+		bool mHasInput;
+		std::uint64_t mNanosecondsSinceUpdate;
+		double mNanosecondRemainder;
+	};
+}
@@ -0,0 +1,16 @@
+#include "pch.h"
+#include "RingAllocator.h"
+
+namespace Simulation
+{
+	RingAllocator::RingAllocator(std::uint32_t capacity) :
+		mCapacity(capacity), mPosition(0), mDiscardNext(true)
+	{
+	}
+
+	void RingAllocator::Reset()
+	{
+		mPosition = 0;
+		mDiscardNext = true;
+	}
+}
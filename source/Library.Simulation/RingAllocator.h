@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Simulation
+{
+	// Hands out ranges of a fixed-size streaming buffer that the GPU may still be reading
+	// from. Ranges follow one another, so a write never touches data already handed to a
+	// draw and can be mapped without waiting (D3D11_MAP_WRITE_NO_OVERWRITE). When a range
+	// no longer fits after the last one the ring starts over at zero and marks the range
+	// Discard, so the caller orphans the old contents (D3D11_MAP_WRITE_DISCARD) instead.
+	class RingAllocator final
+	{
+	public:
+		struct Range final
+		{
+			std::uint32_t Offset;
+			std::uint32_t Count;
+			bool Discard;
+		};
+
+		explicit RingAllocator(std::uint32_t capacity);
+		RingAllocator(const RingAllocator&) = default;
+		RingAllocator& operator=(const RingAllocator&) = default;
+		RingAllocator(RingAllocator&&) = default;
+		RingAllocator& operator=(RingAllocator&&) = default;
+		~RingAllocator() = default;
+
+		std::uint32_t Capacity() const;
+		std::uint32_t Position() const;
+
+		// Never more than Capacity() elements; callers with more split them over several
+		// ranges.
+		Range Allocate(std::uint32_t count);
+
+		// The buffer behind the ring was recreated; the next range discards.
+		void Reset();
+
+	private:
+		std::uint32_t mCapacity;
+		std::uint32_t mPosition;
+		bool mDiscardNext;
+	};
+}
+
+#include "RingAllocator.inl"
@@ -0,0 +1,26 @@
+#pragma once
+
+namespace Simulation
+{
+	inline std::uint32_t RingAllocator::Capacity() const
+	{
+		return mCapacity;
+	}
+
+	inline std::uint32_t RingAllocator::Position() const
+	{
+		return mPosition;
+	}
+
+	inline RingAllocator::Range RingAllocator::Allocate(std::uint32_t count)
+	{
+		Range range;
+		range.Count = count < mCapacity ? count : mCapacity;
+		range.Discard = mDiscardNext || range.Count > mCapacity - mPosition;
+		range.Offset = range.Discard ? 0 : mPosition;
+
+		mPosition = range.Offset + range.Count;
+		mDiscardNext = false;
+		return range;
+	}
+}
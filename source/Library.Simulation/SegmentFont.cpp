@@ -0,0 +1,57 @@
+#include "pch.h"
+#include "SegmentFont.h"
+
+using namespace std;
+
+namespace Simulation
+{
+	const uint32_t SegmentFont::SegmentCount;
+	const uint32_t SegmentFont::Advance;
+
+	const SegmentFont::Line SegmentFont::sSegments[SegmentCount] =
+	{
+		{ 4, 81, 22, 81 },
+		{ 24, 81, 42, 81 },
+		{ 43, 80, 43, 43 },
+		{ 43, 41, 43, 4 },
+		{ 24, 3, 42, 3 },
+		{ 4, 3, 22, 3 },
+		{ 3, 5, 3, 41 },
+		{ 3, 44, 3, 80 },
+		{ 6, 78, 19, 44 },
+		{ 23, 43, 23, 80 },
+		{ 27, 45, 40, 78 },
+		{ 24, 42, 42, 42 },
+		{ 26, 39, 41, 5 },
+		{ 23, 5, 23, 40 },
+		{ 20, 39, 6, 5 },
+		{ 4, 42, 22, 42 },
+	};
+
+	uint32_t SegmentFont::AppendLines(const char* text, float x, float y, vector<Line>& lines)
+	{
+		uint32_t count = 0;
+		for (const char* c = text; *c != '\0'; c++, x += Advance)
+		{
+			count += AppendLines(Mask(*c), x, y, lines);
+		}
+
+		return count;
+	}
+
+	uint32_t SegmentFont::AppendLines(uint16_t mask, float x, float y, vector<Line>& lines)
+	{
+		uint32_t count = 0;
+		for (uint32_t segment = 0; mask != 0; segment++, mask >>= 1)
+		{
+			if (mask & 1)
+			{
+				const Line& line = sSegments[segment];
+				lines.push_back({ x + line.FromX, y + line.FromY, x + line.ToX, y + line.ToY });
+				++count;
+			}
+		}
+
+		return count;
+	}
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Simulation
+{
+	// The sixteen-segment display font: which segments each character lights and where
+	// each segment's line lies inside a character cell. Characters are 50 units apart;
+	// anything without a glyph (spaces included) lights nothing.
+	class SegmentFont final
+	{
+	public:
+		struct Line final
+		{
+			float FromX;
+			float FromY;
+			float ToX;
+			float ToY;
+		};
+
+		static const std::uint32_t SegmentCount = 16;
+		static const std::uint32_t Advance = 50;
+
+		// Bit n lights segment n.
+		static const std::uint16_t ZERO =		/*0100 0100 1111 1111*/ 0x44FF;
+		static const std::uint16_t ONE =		/*0010 0010 0000 0000*/ 0x2200;
+		static const std::uint16_t TWO =		/*1000 1000 0111 0111*/ 0x8877;
+		static const std::uint16_t THREE =		/*1000 1000 0011 1111*/ 0x883F;
+		static const std::uint16_t FOUR =		/*1000 1000 1000 1100*/ 0x888C;
+		static const std::uint16_t FIVE =		/*1000 1000 1011 1011*/ 0x88BB;
+		static const std::uint16_t SIX =		/*1000 1000 1111 1011*/ 0x88FB;
+		static const std::uint16_t SEVEN =		/*0000 0000 0000 1111*/ 0x000F;
+		static const std::uint16_t EIGHT =		/*1000 1000 1111 1111*/ 0x88FF;
+		static const std::uint16_t NINE =		/*1000 1000 1000 1111*/ 0x888F;
+
+		static const std::uint16_t A =			/*1000 1000 1100 1111*/ 0x88CF;
+		static const std::uint16_t B =			/*1001 0100 1111 0011*/ 0x94F3;
+		static const std::uint16_t C =			/*0000 0000 1111 0011*/ 0x00F3;
+		static const std::uint16_t D =			/*0101 0001 1100 0000*/ 0x41C0;
+		static const std::uint16_t E =			/*1000 0000 1111 0011*/ 0x80F3;
+		static const std::uint16_t F =			/*1000 0000 1100 0011*/ 0x80C3;
+		static const std::uint16_t G =			/*0000 1000 1111 1011*/ 0x08FB;
+		static const std::uint16_t H =			/*1000 1000 1100 1100*/ 0x88CC;
+		static const std::uint16_t I =			/*0010 0010 0011 0011*/ 0x2233;
+		static const std::uint16_t J =			/*0000 0000 0011 1100*/ 0x003C;
+		static const std::uint16_t K =			/*1001 0100 1100 0000*/ 0x94C0;
+		static const std::uint16_t L =			/*0000 0000 1111 0000*/ 0x00F0;
+		static const std::uint16_t M =			/*0000 0101 1100 1100*/ 0x05CC;
+		static const std::uint16_t N =			/*0001 0001 1100 1100*/ 0x11CC;
+		static const std::uint16_t O =			/*0000 0000 1111 1111*/ 0x00FF;
+		static const std::uint16_t P =			/*1000 1000 1100 0111*/ 0x88C7;
+		static const std::uint16_t Q =			/*0001 0000 1111 1111*/ 0x10FF;
+		static const std::uint16_t R =			/*1001 1000 1100 0111*/ 0x98C7;
+		static const std::uint16_t S =			/*1000 1000 1011 1011*/ 0x88BB;
+		static const std::uint16_t T =			/*0010 0010 0000 0011*/ 0x2203;
+		static const std::uint16_t U =			/*0000 0000 1111 1100*/ 0x00FC;
+		static const std::uint16_t V =			/*0100 0100 1100 0000*/ 0x44C0;
+		static const std::uint16_t W =			/*0101 0000 1100 1100*/ 0x50CC;
+		static const std::uint16_t X =			/*0101 0101 0000 0000*/ 0x5500;
+		static const std::uint16_t Y =			/*0010 0101 0000 0000*/ 0x2500;
+		static const std::uint16_t Z =			/*0100 0100 0011 0011*/ 0x4433;
+
+		static std::uint16_t Mask(char c);
+
+		// Relative to the character's lower-left corner.
+		static const Line& Segment(std::uint32_t segment);
+
+		// Appends one line per lit segment of text laid out from (x, y) and returns how
+		// many were added.
+		static std::uint32_t AppendLines(const char* text, float x, float y, std::vector<Line>& lines);
+		static std::uint32_t AppendLines(std::uint16_t mask, float x, float y, std::vector<Line>& lines);
+
+		SegmentFont() = delete;
+		SegmentFont(const SegmentFont&) = delete;
+		SegmentFont& operator=(const SegmentFont&) = delete;
+		SegmentFont(SegmentFont&&) = delete;
+		SegmentFont& operator=(SegmentFont&&) = delete;
+		~SegmentFont() = default;
+
+	private:
+		static const Line sSegments[SegmentCount];
+	};
+}
+
+#include "SegmentFont.inl"
@@ -0,0 +1,59 @@
+#pragma once
+
+namespace Simulation
+{
+	namespace SegmentFontTables
+	{
+		struct MaskTable final
+		{
+			std::uint16_t Masks[128];
+		};
+
+		// Upper and lower case share glyphs.
+		constexpr MaskTable BuildMaskTable()
+		{
+			const std::uint16_t digits[] =
+			{
+				SegmentFont::ZERO, SegmentFont::ONE, SegmentFont::TWO, SegmentFont::THREE, SegmentFont::FOUR,
+				SegmentFont::FIVE, SegmentFont::SIX, SegmentFont::SEVEN, SegmentFont::EIGHT, SegmentFont::NINE
+			};
+			const std::uint16_t letters[] =
+			{
+				SegmentFont::A, SegmentFont::B, SegmentFont::C, SegmentFont::D, SegmentFont::E, SegmentFont::F,
+				SegmentFont::G, SegmentFont::H, SegmentFont::I, SegmentFont::J, SegmentFont::K, SegmentFont::L,
+				SegmentFont::M, SegmentFont::N, SegmentFont::O, SegmentFont::P, SegmentFont::Q, SegmentFont::R,
+				SegmentFont::S, SegmentFont::T, SegmentFont::U, SegmentFont::V, SegmentFont::W, SegmentFont::X,
+				SegmentFont::Y, SegmentFont::Z
+			};
+
+			MaskTable table = {};
+			for (std::uint32_t i = 0; i < 10; i++)
+			{
+				table.Masks['0' + i] = digits[i];
+			}
+			for (std::uint32_t i = 0; i < 26; i++)
+			{
+				table.Masks['a' + i] = letters[i];
+				table.Masks['A' + i] = letters[i];
+			}
+
+			return table;
+		}
+
+		static_assert(BuildMaskTable().Masks['Q'] == SegmentFont::Q && BuildMaskTable().Masks['q'] == SegmentFont::Q, "Letters must ignore case");
+		static_assert(BuildMaskTable().Masks['9'] == SegmentFont::NINE && BuildMaskTable().Masks[' '] == 0, "Unknown characters must be blank");
+	}
+
+	inline std::uint16_t SegmentFont::Mask(char c)
+	{
+		static constexpr SegmentFontTables::MaskTable table = SegmentFontTables::BuildMaskTable();
+
+		const unsigned char index = static_cast<unsigned char>(c);
+		return index < 128 ? table.Masks[index] : 0;
+	}
+
+	inline const SegmentFont::Line& SegmentFont::Segment(std::uint32_t segment)
+	{
+		return sSegments[segment];
+	}
+}
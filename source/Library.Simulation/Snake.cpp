@@ -0,0 +1,125 @@
+#include "pch.h"
+#include "Snake.h"
+#include "Board.h"
+#include "OccupancyGrid.h"
+
+using namespace std;
+
+namespace Simulation
+{
+	const uint32_t Snake::MaxLength;
+	const uint32_t Snake::GrowthPerPowerup;
+	const float Snake::MinSpeed = 0.005f;
+
+	Snake::Snake() :
+		mPosition(Board::Center()), mTail(), mVelocity(0, 0),
+		mDirection(Direction::Stop), mAlive(true), mSpeed(0.25f), mDirectionLocked(false)
+	{
+	}
+
+	const Cell& Snake::Position() const
+	{
+		return mPosition;
+	}
+
+	Direction Snake::CurrentDirection() const
+	{
+		return mDirection;
+	}
+
+	float Snake::Speed() const
+	{
+		return mSpeed;
+	}
+
+	void Snake::Move(Direction direction)
+	{
+		switch (direction)
+		{
+		case Direction::Up:
+			if ((!mDirectionLocked && mDirection == Direction::Left) || mDirection == Direction::Right || (mDirection == Direction::Stop &&
+				(mTail.IsEmpty() || mTail[0] != Cell(mPosition.x, mPosition.y + 1))))
+			{
+				mVelocity = Cell(0, 1);
+				mDirection = Direction::Up;
+			}
+			break;
+		case Direction::Down:
+			if ((!mDirectionLocked && mDirection == Direction::Left) || mDirection == Direction::Right || (mDirection == Direction::Stop &&
+				(mTail.IsEmpty() || mTail[0] != Cell(mPosition.x, mPosition.y - 1))))
+			{
+				mVelocity = Cell(0, -1);
+				mDirection = Direction::Down;
+			}
+			break;
+		case Direction::Left:
+			if ((!mDirectionLocked && mDirection == Direction::Up) || mDirection == Direction::Down || (mDirection == Direction::Stop &&
+				(mTail.IsEmpty() || mTail[0] != Cell(mPosition.x - 1, mPosition.y))))
+			{
+				mVelocity = Cell(-1, 0);
+				mDirection = Direction::Left;
+			}
+			break;
+		case Direction::Right:
+			if ((!mDirectionLocked && mDirection == Direction::Up) || mDirection == Direction::Down || (mDirection == Direction::Stop &&
+				(mTail.IsEmpty() || mTail[0] != Cell(mPosition.x + 1, mPosition.y))))
+			{
+				mVelocity = Cell(1, 0);
+				mDirection = Direction::Right;
+			}
+			break;
+		default:
+			break;
+		}
+		mDirectionLocked = true;
+	}
+
+	void Snake::Advance(OccupancyGrid& occupancy)
+	{
+		mPosition += mVelocity;
+		mDirectionLocked = false;
+
+		Cell retracted;
+		if (mTail.Advance(mPosition, &retracted))
+		{
+			occupancy.RemoveBody(retracted.x, retracted.y);
+		}
+
+		if (!mTail.IsEmpty())
+		{
+			occupancy.AddBody(mPosition.x, mPosition.y);
+		}
+	}
+
+	void Snake::IncreaseTail()
+	{
+		mTail.Grow(GrowthPerPowerup);
+		mSpeed = max(mSpeed - 0.005f, MinSpeed);
+	}
+
+	uint32_t Snake::GetTailSize() const
+	{
+		return mTail.Size();
+	}
+
+	const Cell& Snake::GetTailAt(uint32_t index) const
+	{
+		return mTail[index];
+	}
+
+	bool Snake::Alive() const
+	{
+		return mAlive;
+	}
+
+	void Snake::Kill()
+	{
+		mAlive = !mAlive;
+	}
+
+	void Snake::Respawn()
+	{
+		mPosition = Board::Center();
+		mDirection = Direction::Stop;
+	}
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Cell.h"
+#include "SnakeBody.h"
+#include <cstdint>
+
+namespace Simulation
+{
+	class OccupancyGrid;
+
+	enum class Direction
+	{
+		Stop, Up, Down, Left, Right
+	};
+
+	class Snake final
+	{
+	public:
+		static const std::uint32_t MaxLength = 1296;
+		static const std::uint32_t GrowthPerPowerup = 10;
+
+		// Seconds per tick. Every powerup speeds the snake up until it reaches this.
+		static const float MinSpeed;
+
+		Snake();
+		Snake(const Snake&) = default;
+		Snake& operator=(const Snake&) = default;
+		Snake(Snake&&) = default;
+		Snake& operator=(Snake&&) = default;
+		~Snake() = default;
+
+		const Cell& Position() const;
+		Direction CurrentDirection() const;
+		float Speed() const;
+
+		void Move(Direction direction);
+		void Advance(OccupancyGrid& occupancy);
+		void IncreaseTail();
+		uint32_t GetTailSize() const;
+		const Cell& GetTailAt(uint32_t index) const;
+		bool Alive() const;
+
+		// Flips Alive(), so only call it on a live snake.
+		void Kill();
+		void Respawn();
+
+	private:
+		Cell mPosition;
+		SnakeBody<Cell, MaxLength> mTail;
+		Cell mVelocity;
+		Direction mDirection;
+		bool mAlive;
+		float mSpeed;
+		bool mDirectionLocked;
+	};
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Simulation
+{
+	// Fixed-capacity ring buffer holding the segments that trail the snake's head.
+	// Advancing the snake writes the new segment over the oldest one, so a move costs
+	// the same no matter how long the snake is. Growth is deferred: Grow() only bumps a
+	// counter and the body lengthens by one segment on each of the following moves.
+	// The segments are stored inline, so a body of trivially copyable T is itself
+	// trivially copyable.
+	template <typename T, std::uint32_t MaxSegments>
+	class SnakeBody final
+	{
+	public:
+		SnakeBody();
+		SnakeBody(const SnakeBody&) = default;
+		SnakeBody& operator=(const SnakeBody&) = default;
+		SnakeBody(SnakeBody&&) = default;
+		SnakeBody& operator=(SnakeBody&&) = default;
+		~SnakeBody() = default;
+
+		std::uint32_t Capacity() const;
+		std::uint32_t Size() const;
+		std::uint32_t PendingGrowth() const;
+		bool IsEmpty() const;
+
+		// Index 0 is the most recently laid segment, Size() - 1 the oldest.
+		const T& operator[](std::uint32_t index) const;
+		const T& Front() const;
+		const T& Back() const;
+
+		// Lays a new segment at the front. Returns true when the oldest segment was dropped to
+		// make room, copying it into retracted if one is supplied.
+		bool Advance(const T& segment, T* retracted = nullptr);
+		void Grow(std::uint32_t segmentCount);
+		void Clear();
+
+	private:
+		T mSegments[MaxSegments];
+		std::uint32_t mHead;
+		std::uint32_t mSize;
+		std::uint32_t mPendingGrowth;
+	};
+}
+
+#include "SnakeBody.inl"
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cassert>
+
+namespace Simulation
+{
+	template <typename T, std::uint32_t MaxSegments>
+	inline SnakeBody<T, MaxSegments>::SnakeBody() :
+		mSegments(), mHead(0), mSize(0), mPendingGrowth(0)
+	{
+		static_assert(MaxSegments > 0, "A snake body needs room for at least one segment.");
+	}
+
+	template <typename T, std::uint32_t MaxSegments>
+	inline std::uint32_t SnakeBody<T, MaxSegments>::Capacity() const
+	{
+		return MaxSegments;
+	}
+
+	template <typename T, std::uint32_t MaxSegments>
+	inline std::uint32_t SnakeBody<T, MaxSegments>::Size() const
+	{
+		return mSize;
+	}
+
+	template <typename T, std::uint32_t MaxSegments>
+	inline std::uint32_t SnakeBody<T, MaxSegments>::PendingGrowth() const
+	{
+		return mPendingGrowth;
+	}
+
+	template <typename T, std::uint32_t MaxSegments>
+	inline bool SnakeBody<T, MaxSegments>::IsEmpty() const
+	{
+		return mSize == 0;
+	}
+
+	template <typename T, std::uint32_t MaxSegments>
+	inline const T& SnakeBody<T, MaxSegments>::operator[](std::uint32_t index) const
+	{
+		assert(index < mSize);
+		return mSegments[index <= mHead ? mHead - index : mHead + Capacity() - index];
+	}
+
+	template <typename T, std::uint32_t MaxSegments>
+	inline const T& SnakeBody<T, MaxSegments>::Front() const
+	{
+		return (*this)[0];
+	}
+
+	template <typename T, std::uint32_t MaxSegments>
+	inline const T& SnakeBody<T, MaxSegments>::Back() const
+	{
+		return (*this)[mSize - 1];
+	}
+
+	template <typename T, std::uint32_t MaxSegments>
+	inline bool SnakeBody<T, MaxSegments>::Advance(const T& segment, T* retracted)
+	{
+		bool grew = false;
+		if (mPendingGrowth > 0 && mSize < Capacity())
+		{
+			--mPendingGrowth;
+			++mSize;
+			grew = true;
+		}
+
+		if (mSize == 0)
+		{
+			return false;
+		}
+
+		if (!grew && retracted != nullptr)
+		{
+			*retracted = Back();
+		}
+
+		if (++mHead == Capacity())
+		{
+			mHead = 0;
+		}
+		mSegments[mHead] = segment;
+
+		return !grew;
+	}
+
+	template <typename T, std::uint32_t MaxSegments>
+	inline void SnakeBody<T, MaxSegments>::Grow(std::uint32_t segmentCount)
+	{
+		mPendingGrowth += segmentCount;
+	}
+
+	template <typename T, std::uint32_t MaxSegments>
+	inline void SnakeBody<T, MaxSegments>::Clear()
+	{
+		mHead = 0;
+		mSize = 0;
+		mPendingGrowth = 0;
+	}
+}
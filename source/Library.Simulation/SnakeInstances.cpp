@@ -0,0 +1,68 @@
+#include "pch.h"
+#include "SnakeInstances.h"
+#include "Board.h"
+#include "Game.h"
+
+namespace Simulation
+{
+	SnakeInstances::SnakeInstances() :
+		mCount(0), mStepCount(0), mHeadKey(0), mMoving(false), mValid(false)
+	{
+	}
+
+	bool SnakeInstances::Update(const Game& game)
+	{
+		// The newest tail segment always shares the head's cell, so once the snake has a tail
+		// the tail alone covers it; drawing the head as well would stack two instances there.
+		const Snake& snake = game.GetSnake();
+		const std::uint32_t tailSize = snake.GetTailSize();
+		const std::uint32_t count = std::max(tailSize, 1u);
+		const bool moving = snake.Alive() && snake.CurrentDirection() != Direction::Stop;
+
+		// The step count alone would miss a restored snapshot, so the head and length are
+		// compared as well.
+		if (mValid && game.StepCount() == mStepCount && snake.Position().Key() == mHeadKey && count == mCount && moving == mMoving)
+		{
+			return false;
+		}
+
+		// Every segment but the last was, a tick ago, where the one behind it is now. The last
+		// left a cell that is only known if a single tick has passed and the snake didn't grow.
+		const bool oneTick = mValid && game.StepCount() == mStepCount + 1 && count == mCount;
+		Vector2f vacated;
+		if (oneTick)
+		{
+			vacated = mInstances[mCount - 1].To;
+		}
+
+		if (tailSize == 0)
+		{
+			mInstances[0].To = Board::ToWorld(snake.Position());
+		}
+		for (std::uint32_t i = 0; i < tailSize; i++)
+		{
+			mInstances[i].To = Board::ToWorld(snake.GetTailAt(i));
+		}
+		if (!oneTick)
+		{
+			vacated = mInstances[count - 1].To;
+		}
+
+		for (std::uint32_t i = 0; i < count; i++)
+		{
+			const Vector2f& to = mInstances[i].To;
+			const Vector2f& from = (i + 1 < count) ? mInstances[i + 1].To : vacated;
+
+			// Only a step to a neighboring cell is drawn in between; a respawn just jumps.
+			const float distance = std::fabs(to.x - from.x) + std::fabs(to.y - from.y);
+			mInstances[i].From = (!moving || distance > static_cast<float>(Board::CellSize)) ? to : from;
+		}
+
+		mCount = count;
+		mStepCount = game.StepCount();
+		mHeadKey = snake.Position().Key();
+		mMoving = moving;
+		mValid = true;
+		return true;
+	}
+}
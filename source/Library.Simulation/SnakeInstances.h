@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Snake.h"
+#include "StructDefinitions.h"
+#include <cstdint>
+
+namespace Simulation
+{
+	class Game;
+
+	// Where every cell the snake covers was a tick ago and where it is now, in world space and
+	// head first, laid out as a per-instance vertex stream so the whole body draws as one
+	// instanced quad. Update() rebuilds the list, and tells the caller to upload it, only when
+	// the game has changed since the last call. The vertex shader draws each segment a blend
+	// of the way from one to the other, so a moving snake glides between ticks, one tick
+	// behind the game, without the list being touched between them.
+	class SnakeInstances final
+	{
+	public:
+		struct Instance final
+		{
+			Vector2f From;
+			Vector2f To;
+		};
+
+		static const std::uint32_t MaxCount = Snake::MaxLength;
+
+		SnakeInstances();
+		SnakeInstances(const SnakeInstances&) = default;
+		SnakeInstances& operator=(const SnakeInstances&) = default;
+		SnakeInstances(SnakeInstances&&) = default;
+		SnakeInstances& operator=(SnakeInstances&&) = default;
+		~SnakeInstances() = default;
+
+		std::uint32_t Count() const;
+		const Instance* Data() const;
+		std::uint32_t ByteCount() const;
+
+		// Where the vertex shader draws instance index at the given blend.
+		Vector2f Position(std::uint32_t index, float blend) const;
+
+		// Returns true if the instances were rebuilt and need uploading.
+		bool Update(const Game& game);
+		void Invalidate();
+
+	private:
+		Instance mInstances[MaxCount];
+		std::uint32_t mCount;
+		std::uint64_t mStepCount;
+		std::uint32_t mHeadKey;
+		bool mMoving;
+		bool mValid;
+	};
+}
+
+#include "SnakeInstances.inl"
@@ -0,0 +1,30 @@
+#pragma once
+
+namespace Simulation
+{
+	inline std::uint32_t SnakeInstances::Count() const
+	{
+		return mCount;
+	}
+
+	inline const SnakeInstances::Instance* SnakeInstances::Data() const
+	{
+		return mInstances;
+	}
+
+	inline std::uint32_t SnakeInstances::ByteCount() const
+	{
+		return mCount * sizeof(Instance);
+	}
+
+	inline Vector2f SnakeInstances::Position(std::uint32_t index, float blend) const
+	{
+		const Instance& instance = mInstances[index];
+		return Vector2f(instance.From.x + (instance.To.x - instance.From.x) * blend, instance.From.y + (instance.To.y - instance.From.y) * blend);
+	}
+
+	inline void SnakeInstances::Invalidate()
+	{
+		mValid = false;
+	}
+}
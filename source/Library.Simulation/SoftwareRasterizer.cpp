@@ -0,0 +1,567 @@
+#include "pch.h"
+#include "SoftwareRasterizer.h"
+#include <cstdlib>
+
+using namespace std;
+
+namespace Simulation
+{
+	const uint32_t SoftwareRasterizer::TileSize;
+	const int32_t SoftwareRasterizer::SubpixelBits;
+
+	namespace
+	{
+		const int32_t PixelCenter = 1 << 7;
+
+		// Keeps fixed-point positions, and the edge products made from them, well inside 64 bits.
+		const float ScreenLimit = 32768.0f;
+
+		int32_t ToSubpixels(float pixels)
+		{
+			const float clamped = pixels < -ScreenLimit ? -ScreenLimit : (pixels > ScreenLimit ? ScreenLimit : pixels);
+			return static_cast<int32_t>(floor(clamped * 256.0f + 0.5f));
+		}
+
+		int32_t ToByte(float channel)
+		{
+			const float clamped = channel < 0.0f ? 0.0f : (channel > 1.0f ? 1.0f : channel);
+			return static_cast<int32_t>(clamped * 255.0f + 0.5f);
+		}
+
+		// Rounds toward negative infinity, unlike integer division.
+		int64_t FloorDivide(int64_t numerator, int64_t denominator)
+		{
+			const int64_t quotient = numerator / denominator;
+			return (numerator % denominator != 0 && ((numerator < 0) != (denominator < 0))) ? quotient - 1 : quotient;
+		}
+
+		int32_t FloorToPixel(int64_t subpixels)
+		{
+			return static_cast<int32_t>(FloorDivide(subpixels, 256));
+		}
+
+		uint32_t PackColor(const int32_t (&color)[4])
+		{
+			return static_cast<uint32_t>(color[0]) | (static_cast<uint32_t>(color[1]) << 8) |
+				(static_cast<uint32_t>(color[2]) << 16) | (static_cast<uint32_t>(color[3]) << 24);
+		}
+
+		uint32_t Blend(uint32_t source, uint32_t destination)
+		{
+			const uint32_t alpha = source >> 24;
+			if (alpha == 255)
+			{
+				return source;
+			}
+
+			uint32_t result = destination & 0xFF000000;
+			for (uint32_t shift = 0; shift < 24; shift += 8)
+			{
+				const uint32_t s = (source >> shift) & 0xFF;
+				const uint32_t d = (destination >> shift) & 0xFF;
+				result |= ((s * alpha + d * (255 - alpha) + 127) / 255) << shift;
+			}
+
+			return result;
+		}
+	}
+
+	SoftwareRasterizer::SoftwareRasterizer(uint32_t width, uint32_t height, uint32_t threadCount) :
+		mFramebuffer(width, height), mViewProjection(),
+		mTilesX((width + TileSize - 1) / TileSize), mTilesY((height + TileSize - 1) / TileSize),
+		mClearPixel(0), mClearPending(false), mBins(mTilesX * mTilesY),
+		mNextTile(0), mGeneration(0), mBusyWorkers(0), mStopping(false)
+	{
+		for (uint32_t i = 0; i < 4; i++)
+		{
+			mViewProjection.M[i][i] = 1.0f;
+		}
+
+		if (threadCount == 0)
+		{
+			threadCount = max(thread::hardware_concurrency(), 1u);
+		}
+		for (uint32_t i = 1; i < threadCount; i++)
+		{
+			mWorkers.emplace_back(&SoftwareRasterizer::WorkerLoop, this);
+		}
+	}
+
+	SoftwareRasterizer::~SoftwareRasterizer()
+	{
+		{
+			lock_guard<mutex> lock(mMutex);
+			mStopping = true;
+		}
+		mWorkReady.notify_all();
+
+		for (thread& worker : mWorkers)
+		{
+			worker.join();
+		}
+	}
+
+	void SoftwareRasterizer::Clear(float red, float green, float blue, float alpha)
+	{
+		// Nothing drawn before a clear would survive it.
+		mVertices.clear();
+		mPrimitives.clear();
+		for (vector<uint32_t>& bin : mBins)
+		{
+			bin.clear();
+		}
+
+		mClearPixel = Framebuffer::Pack(red, green, blue, alpha);
+		mClearPending = true;
+	}
+
+	void SoftwareRasterizer::SetViewProjection(const Matrix4& viewProjection)
+	{
+		mViewProjection = viewProjection;
+	}
+
+	void SoftwareRasterizer::Draw(Topology topology, const ColorVertex* vertices, uint32_t vertexCount)
+	{
+		DrawIndexed(topology, vertices, vertexCount, nullptr, vertexCount);
+	}
+
+	void SoftwareRasterizer::DrawIndexed(Topology topology, const ColorVertex* vertices, uint32_t vertexCount, const uint16_t* indices, uint32_t indexCount)
+	{
+		mTransformed.resize(vertexCount);
+		for (uint32_t i = 0; i < vertexCount; i++)
+		{
+			ScreenVertex& transformed = mTransformed[i];
+			transformed = Transform(vertices[i].Position);
+			for (uint32_t channel = 0; channel < 4; channel++)
+			{
+				transformed.Color[channel] = ToByte(vertices[i].Color[channel]);
+			}
+		}
+
+		Assemble(topology, mTransformed.data(), indices, indexCount, NoTexture);
+	}
+
+	RenderBackend::TextureId SoftwareRasterizer::CreateTexture(uint32_t width, uint32_t height, const uint32_t* texels)
+	{
+		if (width == 0 || height == 0 || texels == nullptr)
+		{
+			return NoTexture;
+		}
+
+		mTextures.push_back({ width, height, vector<uint32_t>(texels, texels + static_cast<size_t>(width) * height) });
+		return static_cast<TextureId>(mTextures.size());
+	}
+
+	void SoftwareRasterizer::DrawTextured(TextureId texture, Topology topology, const TextureVertex* vertices, uint32_t vertexCount)
+	{
+		if (texture == NoTexture || texture > mTextures.size())
+		{
+			return;
+		}
+
+		mTransformed.resize(vertexCount);
+		for (uint32_t i = 0; i < vertexCount; i++)
+		{
+			ScreenVertex& transformed = mTransformed[i];
+			transformed = Transform(vertices[i].Position);
+			transformed.U = vertices[i].TextureCoordinates[0];
+			transformed.V = vertices[i].TextureCoordinates[1];
+		}
+
+		Assemble(topology, mTransformed.data(), nullptr, vertexCount, texture);
+	}
+
+	void SoftwareRasterizer::Submit()
+	{
+		if (!mClearPending && mPrimitives.empty())
+		{
+			return;
+		}
+
+		mNextTile.store(0, memory_order_relaxed);
+		if (!mWorkers.empty())
+		{
+			{
+				lock_guard<mutex> lock(mMutex);
+				mBusyWorkers = static_cast<uint32_t>(mWorkers.size());
+				++mGeneration;
+			}
+			mWorkReady.notify_all();
+		}
+
+		RasterizeTiles();
+
+		if (!mWorkers.empty())
+		{
+			unique_lock<mutex> lock(mMutex);
+			mWorkDone.wait(lock, [this]() { return mBusyWorkers == 0; });
+		}
+
+		mVertices.clear();
+		mPrimitives.clear();
+		for (vector<uint32_t>& bin : mBins)
+		{
+			bin.clear();
+		}
+		mClearPending = false;
+	}
+
+	SoftwareRasterizer::ScreenVertex SoftwareRasterizer::Transform(const float (&position)[4]) const
+	{
+		float clip[4];
+		for (uint32_t column = 0; column < 4; column++)
+		{
+			clip[column] = position[0] * mViewProjection.M[0][column] + position[1] * mViewProjection.M[1][column] +
+				position[2] * mViewProjection.M[2][column] + position[3] * mViewProjection.M[3][column];
+		}
+
+		const float width = static_cast<float>(mFramebuffer.Width());
+		const float height = static_cast<float>(mFramebuffer.Height());
+
+		ScreenVertex vertex = {};
+		vertex.X = ToSubpixels((clip[0] / clip[3] + 1.0f) * 0.5f * width);
+		vertex.Y = ToSubpixels((1.0f - clip[1] / clip[3]) * 0.5f * height);
+		for (int32_t& channel : vertex.Color)
+		{
+			channel = 255;
+		}
+
+		return vertex;
+	}
+
+	void SoftwareRasterizer::Assemble(Topology topology, const ScreenVertex* vertices, const uint16_t* indices, uint32_t count, TextureId texture)
+	{
+		ScreenVertex primitive[3];
+		auto gather = [&](uint32_t first, uint32_t vertexCount) {
+			for (uint32_t i = 0; i < vertexCount; i++)
+			{
+				primitive[i] = vertices[indices != nullptr ? indices[first + i] : first + i];
+			}
+			AddPrimitive(primitive, vertexCount, texture);
+		};
+
+		switch (topology)
+		{
+		case Topology::TriangleList:
+			for (uint32_t i = 0; i + 2 < count; i += 3)
+			{
+				gather(i, 3);
+			}
+			break;
+
+		case Topology::TriangleStrip:
+			for (uint32_t i = 0; i + 2 < count; i++)
+			{
+				gather(i, 3);
+			}
+			break;
+
+		case Topology::LineList:
+			for (uint32_t i = 0; i + 1 < count; i += 2)
+			{
+				gather(i, 2);
+			}
+			break;
+
+		case Topology::LineStrip:
+			for (uint32_t i = 0; i + 1 < count; i++)
+			{
+				gather(i, 2);
+			}
+			break;
+		}
+	}
+
+	void SoftwareRasterizer::AddPrimitive(const ScreenVertex* vertices, uint32_t vertexCount, TextureId texture)
+	{
+		Primitive primitive;
+		primitive.FirstVertex = static_cast<uint32_t>(mVertices.size());
+		primitive.Texture = texture;
+		primitive.Line = vertexCount == 2;
+		primitive.Flat = true;
+
+		int32_t minX = vertices[0].X;
+		int32_t minY = vertices[0].Y;
+		int32_t maxX = minX;
+		int32_t maxY = minY;
+		for (uint32_t i = 1; i < vertexCount; i++)
+		{
+			minX = min(minX, vertices[i].X);
+			minY = min(minY, vertices[i].Y);
+			maxX = max(maxX, vertices[i].X);
+			maxY = max(maxY, vertices[i].Y);
+			primitive.Flat = primitive.Flat && memcmp(vertices[i].Color, vertices[0].Color, sizeof(vertices[0].Color)) == 0;
+		}
+
+		// Every pixel whose center could be covered, clamped to the screen.
+		primitive.MinX = max(FloorToPixel(minX), 0);
+		primitive.MinY = max(FloorToPixel(minY), 0);
+		primitive.MaxX = min(FloorToPixel(maxX), static_cast<int32_t>(mFramebuffer.Width()) - 1);
+		primitive.MaxY = min(FloorToPixel(maxY), static_cast<int32_t>(mFramebuffer.Height()) - 1);
+		if (primitive.MinX > primitive.MaxX || primitive.MinY > primitive.MaxY)
+		{
+			return;
+		}
+
+		const uint32_t index = static_cast<uint32_t>(mPrimitives.size());
+		mVertices.insert(mVertices.end(), vertices, vertices + vertexCount);
+		mPrimitives.push_back(primitive);
+
+		for (uint32_t tileY = primitive.MinY / TileSize; tileY <= primitive.MaxY / TileSize; tileY++)
+		{
+			for (uint32_t tileX = primitive.MinX / TileSize; tileX <= primitive.MaxX / TileSize; tileX++)
+			{
+				mBins[tileY * mTilesX + tileX].push_back(index);
+			}
+		}
+	}
+
+	void SoftwareRasterizer::WorkerLoop()
+	{
+		uint64_t generation = 0;
+		for (;;)
+		{
+			{
+				unique_lock<mutex> lock(mMutex);
+				mWorkReady.wait(lock, [&]() { return mStopping || mGeneration != generation; });
+				if (mStopping)
+				{
+					return;
+				}
+				generation = mGeneration;
+			}
+
+			RasterizeTiles();
+
+			bool last;
+			{
+				lock_guard<mutex> lock(mMutex);
+				last = --mBusyWorkers == 0;
+			}
+			if (last)
+			{
+				mWorkDone.notify_one();
+			}
+		}
+	}
+
+	void SoftwareRasterizer::RasterizeTiles()
+	{
+		const uint32_t tileCount = mTilesX * mTilesY;
+		for (uint32_t tile = mNextTile.fetch_add(1, memory_order_relaxed); tile < tileCount; tile = mNextTile.fetch_add(1, memory_order_relaxed))
+		{
+			RasterizeTile(tile);
+		}
+	}
+
+	void SoftwareRasterizer::RasterizeTile(uint32_t tileIndex)
+	{
+		Tile tile;
+		tile.Left = static_cast<int32_t>((tileIndex % mTilesX) * TileSize);
+		tile.Top = static_cast<int32_t>((tileIndex / mTilesX) * TileSize);
+		tile.Right = min(tile.Left + static_cast<int32_t>(TileSize), static_cast<int32_t>(mFramebuffer.Width()));
+		tile.Bottom = min(tile.Top + static_cast<int32_t>(TileSize), static_cast<int32_t>(mFramebuffer.Height()));
+
+		if (mClearPending)
+		{
+			for (int32_t y = tile.Top; y < tile.Bottom; y++)
+			{
+				uint32_t* row = mFramebuffer.Row(y);
+				fill(row + tile.Left, row + tile.Right, mClearPixel);
+			}
+		}
+
+		for (uint32_t index : mBins[tileIndex])
+		{
+			const Primitive& primitive = mPrimitives[index];
+			if (primitive.Line)
+			{
+				RasterizeLine(primitive, tile);
+			}
+			else
+			{
+				RasterizeTriangle(primitive, tile);
+			}
+		}
+	}
+
+	void SoftwareRasterizer::RasterizeTriangle(const Primitive& primitive, const Tile& tile)
+	{
+		ScreenVertex vertices[3] = { mVertices[primitive.FirstVertex], mVertices[primitive.FirstVertex + 1], mVertices[primitive.FirstVertex + 2] };
+
+		int64_t area = static_cast<int64_t>(vertices[1].X - vertices[0].X) * (vertices[2].Y - vertices[0].Y) -
+			static_cast<int64_t>(vertices[1].Y - vertices[0].Y) * (vertices[2].X - vertices[0].X);
+		if (area == 0)
+		{
+			return;
+		}
+		if (area < 0)
+		{
+			swap(vertices[1], vertices[2]);
+			area = -area;
+		}
+
+		const int32_t minX = max(primitive.MinX, tile.Left);
+		const int32_t minY = max(primitive.MinY, tile.Top);
+		const int32_t maxX = min(primitive.MaxX, tile.Right - 1);
+		const int32_t maxY = min(primitive.MaxY, tile.Bottom - 1);
+		if (minX > maxX || minY > maxY)
+		{
+			return;
+		}
+
+		// Edge i runs between the two vertices other than i and is positive on the inside,
+		// so its value at a pixel is that pixel's weight for vertex i. Pixels exactly on an
+		// edge belong to it only if it is a top or left edge.
+		const int64_t startX = (static_cast<int64_t>(minX) << SubpixelBits) + PixelCenter;
+		const int64_t startY = (static_cast<int64_t>(minY) << SubpixelBits) + PixelCenter;
+		int64_t rowWeights[3];
+		int64_t stepX[3];
+		int64_t stepY[3];
+		int64_t bias[3];
+		for (uint32_t i = 0; i < 3; i++)
+		{
+			const ScreenVertex& from = vertices[(i + 1) % 3];
+			const ScreenVertex& to = vertices[(i + 2) % 3];
+			const int64_t dx = to.X - from.X;
+			const int64_t dy = to.Y - from.Y;
+
+			rowWeights[i] = dx * (startY - from.Y) - dy * (startX - from.X);
+			stepX[i] = -dy << SubpixelBits;
+			stepY[i] = dx << SubpixelBits;
+			bias[i] = (dy < 0 || (dy == 0 && dx > 0)) ? 0 : -1;
+		}
+
+		const bool flat = primitive.Flat && primitive.Texture == NoTexture;
+		const uint32_t flatPixel = PackColor(vertices[0].Color);
+
+		for (int32_t y = minY; y <= maxY; y++)
+		{
+			uint32_t* row = mFramebuffer.Row(y);
+			int64_t weights[3] = { rowWeights[0], rowWeights[1], rowWeights[2] };
+			for (int32_t x = minX; x <= maxX; x++)
+			{
+				if (weights[0] + bias[0] >= 0 && weights[1] + bias[1] >= 0 && weights[2] + bias[2] >= 0)
+				{
+					if (flat)
+					{
+						row[x] = flatPixel;
+					}
+					else
+					{
+						Shade(row[x], primitive, vertices, weights, 3, area);
+					}
+				}
+
+				for (uint32_t i = 0; i < 3; i++)
+				{
+					weights[i] += stepX[i];
+				}
+			}
+
+			for (uint32_t i = 0; i < 3; i++)
+			{
+				rowWeights[i] += stepY[i];
+			}
+		}
+	}
+
+	void SoftwareRasterizer::RasterizeLine(const Primitive& primitive, const Tile& tile)
+	{
+		const ScreenVertex* vertices = &mVertices[primitive.FirstVertex];
+		const ScreenVertex& from = vertices[0];
+		const ScreenVertex& to = vertices[1];
+		if (from.X == to.X && from.Y == to.Y)
+		{
+			return;
+		}
+
+		// Steps one pixel at a time along the longer axis, over the pixel centers from the
+		// start up to (not including) the end, and takes the pixel the line crosses at each.
+		const bool xMajor = abs(to.X - from.X) >= abs(to.Y - from.Y);
+		const int64_t majorFrom = xMajor ? from.X : from.Y;
+		const int64_t majorTo = xMajor ? to.X : to.Y;
+		const int64_t minorFrom = xMajor ? from.Y : from.X;
+		const int64_t minorTo = xMajor ? to.Y : to.X;
+		const int64_t majorLength = majorTo - majorFrom;
+		const int64_t minorLength = minorTo - minorFrom;
+
+		int32_t first;
+		int32_t last;
+		if (majorLength > 0)
+		{
+			first = static_cast<int32_t>(-FloorDivide(PixelCenter - majorFrom, 256));
+			last = static_cast<int32_t>(-FloorDivide(PixelCenter - majorTo, 256)) - 1;
+		}
+		else
+		{
+			first = FloorToPixel(majorTo - PixelCenter) + 1;
+			last = FloorToPixel(majorFrom - PixelCenter);
+		}
+
+		first = max(first, xMajor ? tile.Left : tile.Top);
+		last = min(last, (xMajor ? tile.Right : tile.Bottom) - 1);
+		const int32_t minorMin = xMajor ? tile.Top : tile.Left;
+		const int32_t minorMax = (xMajor ? tile.Bottom : tile.Right) - 1;
+
+		const bool flat = primitive.Flat && primitive.Texture == NoTexture;
+		const uint32_t flatPixel = PackColor(from.Color);
+		const int64_t length = majorLength > 0 ? majorLength : -majorLength;
+		for (int32_t major = first; major <= last; major++)
+		{
+			const int64_t travelled = (static_cast<int64_t>(major) << SubpixelBits) + PixelCenter - majorFrom;
+			const int32_t minor = FloorToPixel(minorFrom + FloorDivide(travelled * minorLength, majorLength));
+			if (minor < minorMin || minor > minorMax)
+			{
+				continue;
+			}
+
+			uint32_t& pixel = xMajor ? mFramebuffer.Row(minor)[major] : mFramebuffer.Row(major)[minor];
+			if (flat)
+			{
+				pixel = flatPixel;
+			}
+			else
+			{
+				const int64_t along = travelled > 0 ? travelled : -travelled;
+				const int64_t weights[2] = { length - along, along };
+				Shade(pixel, primitive, vertices, weights, 2, length);
+			}
+		}
+	}
+
+	void SoftwareRasterizer::Shade(uint32_t& pixel, const Primitive& primitive, const ScreenVertex* vertices, const int64_t* weights, uint32_t vertexCount, int64_t totalWeight) const
+	{
+		if (primitive.Texture == NoTexture)
+		{
+			uint32_t color = 0;
+			for (uint32_t channel = 0; channel < 4; channel++)
+			{
+				int64_t sum = totalWeight / 2;
+				for (uint32_t i = 0; i < vertexCount; i++)
+				{
+					sum += weights[i] * vertices[i].Color[channel];
+				}
+				color |= static_cast<uint32_t>(sum / totalWeight) << (channel * 8);
+			}
+			pixel = color;
+			return;
+		}
+
+		double u = 0.0;
+		double v = 0.0;
+		for (uint32_t i = 0; i < vertexCount; i++)
+		{
+			u += static_cast<double>(weights[i]) * vertices[i].U;
+			v += static_cast<double>(weights[i]) * vertices[i].V;
+		}
+
+		const Texture& texture = mTextures[primitive.Texture - 1];
+		const int64_t texelX = static_cast<int64_t>(floor(u / totalWeight * texture.Width));
+		const int64_t texelY = static_cast<int64_t>(floor(v / totalWeight * texture.Height));
+		const uint32_t column = static_cast<uint32_t>(min<int64_t>(max<int64_t>(texelX, 0), texture.Width - 1));
+		const uint32_t row = static_cast<uint32_t>(min<int64_t>(max<int64_t>(texelY, 0), texture.Height - 1));
+
+		pixel = Blend(texture.Texels[static_cast<size_t>(row) * texture.Width + column], pixel);
+	}
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "Framebuffer.h"
+#include "RenderBackend.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Simulation
+{
+	// A RenderBackend that draws into a Framebuffer on the CPU. Draw calls only transform
+	// their vertices and sort the primitives into the TileSize-square tiles they touch;
+	// Submit() then rasterizes the tiles on a pool of threads. A tile draws its primitives
+	// in submission order and owns its pixels outright, so the image is the same for any
+	// thread count.
+	//
+	// Positions are snapped to 1/256 pixel and coverage, the top-left fill rule and color
+	// interpolation are done in integers, which keeps images pixel-exact across compilers.
+	// Triangles are drawn two-sided, lines are one pixel wide and leave out their last
+	// pixel, and textures are point-sampled with clamping. Geometry is expected in front
+	// of the camera (positive w); nothing is clipped except to the screen.
+	class SoftwareRasterizer final : public RenderBackend
+	{
+	public:
+		static const std::uint32_t TileSize = 64;
+
+		// threadCount includes the thread calling Submit(); 0 picks one per core.
+		SoftwareRasterizer(std::uint32_t width, std::uint32_t height, std::uint32_t threadCount = 0);
+		SoftwareRasterizer(const SoftwareRasterizer&) = delete;
+		SoftwareRasterizer& operator=(const SoftwareRasterizer&) = delete;
+		SoftwareRasterizer(SoftwareRasterizer&&) = delete;
+		SoftwareRasterizer& operator=(SoftwareRasterizer&&) = delete;
+		~SoftwareRasterizer();
+
+		const Framebuffer& GetFramebuffer() const;
+		std::uint32_t ThreadCount() const;
+		std::uint32_t PendingPrimitiveCount() const;
+
+		virtual void Clear(float red, float green, float blue, float alpha) override;
+		virtual void SetViewProjection(const Matrix4& viewProjection) override;
+
+		virtual void Draw(Topology topology, const ColorVertex* vertices, std::uint32_t vertexCount) override;
+		virtual void DrawIndexed(Topology topology, const ColorVertex* vertices, std::uint32_t vertexCount, const std::uint16_t* indices, std::uint32_t indexCount) override;
+
+		virtual TextureId CreateTexture(std::uint32_t width, std::uint32_t height, const std::uint32_t* texels) override;
+		virtual void DrawTextured(TextureId texture, Topology topology, const TextureVertex* vertices, std::uint32_t vertexCount) override;
+
+		virtual void Submit() override;
+
+	private:
+		static const std::int32_t SubpixelBits = 8;
+
+		// Fixed-point screen position; 8-bit color or float texture coordinates.
+		struct ScreenVertex final
+		{
+			std::int32_t X;
+			std::int32_t Y;
+			std::int32_t Color[4];
+			float U;
+			float V;
+		};
+
+		struct Primitive final
+		{
+			std::uint32_t FirstVertex;
+			TextureId Texture;
+			std::int32_t MinX;
+			std::int32_t MinY;
+			std::int32_t MaxX;
+			std::int32_t MaxY;
+			bool Line;
+			bool Flat;
+		};
+
+		struct Texture final
+		{
+			std::uint32_t Width;
+			std::uint32_t Height;
+			std::vector<std::uint32_t> Texels;
+		};
+
+		struct Tile final
+		{
+			std::int32_t Left;
+			std::int32_t Top;
+			std::int32_t Right;
+			std::int32_t Bottom;
+		};
+
+		ScreenVertex Transform(const float (&position)[4]) const;
+		void Assemble(Topology topology, const ScreenVertex* vertices, const std::uint16_t* indices, std::uint32_t count, TextureId texture);
+		void AddPrimitive(const ScreenVertex* vertices, std::uint32_t vertexCount, TextureId texture);
+
+		void WorkerLoop();
+		void RasterizeTiles();
+		void RasterizeTile(std::uint32_t tileIndex);
+		void RasterizeTriangle(const Primitive& primitive, const Tile& tile);
+		void RasterizeLine(const Primitive& primitive, const Tile& tile);
+
+		// Blends in the primitive's color or texel at the vertices' weighted average.
+		void Shade(std::uint32_t& pixel, const Primitive& primitive, const ScreenVertex* vertices, const std::int64_t* weights, std::uint32_t vertexCount, std::int64_t totalWeight) const;
+
+		Framebuffer mFramebuffer;
+		Matrix4 mViewProjection;
+		std::uint32_t mTilesX;
+		std::uint32_t mTilesY;
+		std::uint32_t mClearPixel;
+		bool mClearPending;
+
+		std::vector<ScreenVertex> mTransformed;
+		std::vector<ScreenVertex> mVertices;
+		std::vector<Primitive> mPrimitives;
+		std::vector<std::vector<std::uint32_t>> mBins;
+		std::vector<Texture> mTextures;
+
+		std::vector<std::thread> mWorkers;
+		std::mutex mMutex;
+		std::condition_variable mWorkReady;
+		std::condition_variable mWorkDone;
+		std::atomic<std::uint32_t> mNextTile;
+		std::uint64_t mGeneration;
+		std::uint32_t mBusyWorkers;
+		bool mStopping;
+	};
+}
+
+#include "SoftwareRasterizer.inl"
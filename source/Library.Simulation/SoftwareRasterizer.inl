@@ -0,0 +1,19 @@
+#pragma once
+
+namespace Simulation
+{
+	inline const Framebuffer& SoftwareRasterizer::GetFramebuffer() const
+	{
+		return mFramebuffer;
+	}
+
+	inline std::uint32_t SoftwareRasterizer::ThreadCount() const
+	{
+		return static_cast<std::uint32_t>(mWorkers.size()) + 1;
+	}
+
+	inline std::uint32_t SoftwareRasterizer::PendingPrimitiveCount() const
+	{
+		return static_cast<std::uint32_t>(mPrimitives.size());
+	}
+}
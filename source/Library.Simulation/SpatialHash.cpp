@@ -0,0 +1,80 @@
+#include "pch.h"
+#include "SpatialHash.h"
+
+using namespace std;
+
+namespace Simulation
+{
+	const uint32_t SpatialHash::EmptyKey;
+
+	namespace
+	{
+		const uint32_t MinimumCapacity = 16;
+	}
+
+	SpatialHash::SpatialHash(uint32_t expectedCount) :
+		mMask(0), mShift(32), mSize(0)
+	{
+		Rehash(MinimumCapacity);
+		Reserve(expectedCount);
+	}
+
+	void SpatialHash::Reserve(uint32_t count)
+	{
+		uint32_t capacity = Capacity();
+		while (count * 2 > capacity)
+		{
+			capacity *= 2;
+		}
+
+		if (capacity != Capacity())
+		{
+			Rehash(capacity);
+		}
+	}
+
+	void SpatialHash::Clear()
+	{
+		for (Slot& slot : mSlots)
+		{
+			slot.Key = EmptyKey;
+		}
+		mSize = 0;
+	}
+
+	void SpatialHash::Rehash(uint32_t capacity)
+	{
+		assert(capacity >= MinimumCapacity && (capacity & (capacity - 1)) == 0);
+
+		vector<Slot> slots(capacity);
+		swap(slots, mSlots);
+		for (Slot& slot : mSlots)
+		{
+			slot.Key = EmptyKey;
+		}
+
+		mMask = capacity - 1;
+		mShift = 32;
+		for (uint32_t bits = capacity; bits > 1; bits >>= 1)
+		{
+			--mShift;
+		}
+
+		mSize = 0;
+		for (const Slot& slot : slots)
+		{
+			if (slot.Key != EmptyKey)
+			{
+				for (uint32_t index = Home(slot.Key); ; index = (index + 1) & mMask)
+				{
+					if (mSlots[index].Key == EmptyKey)
+					{
+						mSlots[index] = slot;
+						++mSize;
+						break;
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Cell.h"
+#include <cstdint>
+#include <vector>
+
+namespace Simulation
+{
+	// Sparse map from occupied cell to the snake segment lying on it, for arenas too large
+	// for a dense grid. Open addressing with linear probing keeps each lookup to one or two
+	// cache lines; erasing shifts the following entries back instead of leaving tombstones,
+	// so a long-running arena with constant churn never degrades. The table doubles when
+	// it passes half full.
+	//
+	// Each cell holds at most one segment. Moving a snake is an Insert() for the new head
+	// and an Erase() for the retracted tail; a Find() on the cell a head is about to enter
+	// answers head-versus-anything collisions.
+	class SpatialHash final
+	{
+	public:
+		struct Occupant final
+		{
+			std::uint32_t SnakeId;
+			std::uint32_t Segment;
+		};
+
+		explicit SpatialHash(std::uint32_t expectedCount = 0);
+		SpatialHash(const SpatialHash&) = default;
+		SpatialHash& operator=(const SpatialHash&) = default;
+		SpatialHash(SpatialHash&&) = default;
+		SpatialHash& operator=(SpatialHash&&) = default;
+		~SpatialHash() = default;
+
+		std::uint32_t Size() const;
+		std::uint32_t Capacity() const;
+
+		const Occupant* Find(const Cell& cell) const;
+
+		// Returns false, leaving the table unchanged, if the cell is already occupied.
+		bool Insert(const Cell& cell, std::uint32_t snakeId, std::uint32_t segment);
+		bool Erase(const Cell& cell);
+
+		void Reserve(std::uint32_t count);
+		void Clear();
+
+	private:
+		struct Slot final
+		{
+			std::uint32_t Key;
+			Occupant Value;
+		};
+
+		// Cell(-1, -1) never lies on an arena, so its key marks an empty slot.
+		static const std::uint32_t EmptyKey = 0xFFFFFFFF;
+
+		std::uint32_t Home(std::uint32_t key) const;
+		void Rehash(std::uint32_t capacity);
+
+		std::vector<Slot> mSlots;
+		std::uint32_t mMask;
+		std::uint32_t mShift;
+		std::uint32_t mSize;
+	};
+}
+
+#include "SpatialHash.inl"
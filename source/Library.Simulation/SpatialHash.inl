@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cassert>
+
+namespace Simulation
+{
+	inline std::uint32_t SpatialHash::Size() const
+	{
+		return mSize;
+	}
+
+	inline std::uint32_t SpatialHash::Capacity() const
+	{
+		return static_cast<std::uint32_t>(mSlots.size());
+	}
+
+	inline const SpatialHash::Occupant* SpatialHash::Find(const Cell& cell) const
+	{
+		const std::uint32_t key = cell.Key();
+		assert(key != EmptyKey);
+
+		for (std::uint32_t index = Home(key); ; index = (index + 1) & mMask)
+		{
+			const Slot& slot = mSlots[index];
+			if (slot.Key == key)
+			{
+				return &slot.Value;
+			}
+			if (slot.Key == EmptyKey)
+			{
+				return nullptr;
+			}
+		}
+	}
+
+	inline bool SpatialHash::Insert(const Cell& cell, std::uint32_t snakeId, std::uint32_t segment)
+	{
+		if ((mSize + 1) * 2 > Capacity())
+		{
+			Rehash(Capacity() * 2);
+		}
+
+		const std::uint32_t key = cell.Key();
+		assert(key != EmptyKey);
+
+		for (std::uint32_t index = Home(key); ; index = (index + 1) & mMask)
+		{
+			Slot& slot = mSlots[index];
+			if (slot.Key == key)
+			{
+				return false;
+			}
+			if (slot.Key == EmptyKey)
+			{
+				slot.Key = key;
+				slot.Value.SnakeId = snakeId;
+				slot.Value.Segment = segment;
+				++mSize;
+				return true;
+			}
+		}
+	}
+
+	inline bool SpatialHash::Erase(const Cell& cell)
+	{
+		const std::uint32_t key = cell.Key();
+		assert(key != EmptyKey);
+
+		std::uint32_t hole = Home(key);
+		while (mSlots[hole].Key != key)
+		{
+			if (mSlots[hole].Key == EmptyKey)
+			{
+				return false;
+			}
+			hole = (hole + 1) & mMask;
+		}
+
+		// Pull back any later entry in the run whose home slot does not lie between the hole
+		// and its current position, so every entry stays reachable from its home.
+		for (std::uint32_t index = (hole + 1) & mMask; mSlots[index].Key != EmptyKey; index = (index + 1) & mMask)
+		{
+			const std::uint32_t home = Home(mSlots[index].Key);
+			if (((index - home) & mMask) >= ((index - hole) & mMask))
+			{
+				mSlots[hole] = mSlots[index];
+				hole = index;
+			}
+		}
+
+		mSlots[hole].Key = EmptyKey;
+		--mSize;
+		return true;
+	}
+
+	inline std::uint32_t SpatialHash::Home(std::uint32_t key) const
+	{
+		// Fibonacci hashing spreads the packed x/y coordinates over the high bits.
+		return (key * 0x9E3779B1u) >> mShift;
+	}
+}
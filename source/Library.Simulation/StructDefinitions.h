@@ -41,12 +41,12 @@ public:
 		return (*this);
 	}
 
-	Vector2f operator+(const Vector2f& rhs)
+	Vector2f operator+(const Vector2f& rhs) const
 	{
 		return Vector2f(x + rhs.x, y + rhs.y);
 	}
 
-	Vector2f operator-(const Vector2f& rhs)
+	Vector2f operator-(const Vector2f& rhs) const
 	{
 		return Vector2f(x - rhs.x, y - rhs.y);
 	}
@@ -65,7 +65,7 @@ public:
 		return (*this);
 	}
 
-	bool operator==(const Vector2f& rhs)
+	bool operator==(const Vector2f& rhs) const
 	{
 		return (x == rhs.x && y == rhs.y);
 	}
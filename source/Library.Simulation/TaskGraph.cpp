@@ -0,0 +1,134 @@
+#include "pch.h"
+#include "TaskGraph.h"
+
+using namespace std;
+
+namespace Simulation
+{
+	const uint32_t TaskGraph::NoTask = UINT32_MAX;
+
+	TaskGraph::TaskGraph() :
+		mPendingCapacity(0)
+	{
+	}
+
+	void TaskGraph::Add(const Task& task, const Access& access)
+	{
+		const uint32_t index = static_cast<uint32_t>(mNodes.size());
+		mNodes.push_back({ task, {}, 0, false });
+
+		for (Resource resource : access.Reads)
+		{
+			ResourceUse& use = mUses.emplace(resource, ResourceUse{ NoTask, {} }).first->second;
+			AddDependency(use.Writer, index);
+			use.Readers.push_back(index);
+		}
+
+		for (Resource resource : access.Writes)
+		{
+			ResourceUse& use = mUses.emplace(resource, ResourceUse{ NoTask, {} }).first->second;
+			AddDependency(use.Writer, index);
+			for (uint32_t reader : use.Readers)
+			{
+				AddDependency(reader, index);
+			}
+			use.Writer = index;
+			use.Readers.clear();
+		}
+	}
+
+	void TaskGraph::AddExclusive(const Task& task)
+	{
+		mNodes.push_back({ task, {}, 0, true });
+
+		// Nothing after this task can overlap anything before it.
+		mUses.clear();
+	}
+
+	void TaskGraph::Run(JobSystem& jobs)
+	{
+		const uint32_t count = Count();
+		if (mPendingCapacity < count)
+		{
+			mPending.reset(new atomic<uint32_t>[count]);
+			mPendingCapacity = count;
+		}
+		for (uint32_t i = 0; i < count; i++)
+		{
+			mPending[i].store(mNodes[i].Dependencies, memory_order_relaxed);
+		}
+
+		// Exclusive tasks split the list into spans whose tasks only depend on each other.
+		uint32_t first = 0;
+		while (first < count)
+		{
+			uint32_t last = first;
+			while (last < count && !mNodes[last].Exclusive)
+			{
+				++last;
+			}
+
+			if (last > first)
+			{
+				JobSystem::Counter counter;
+				for (uint32_t i = first; i < last; i++)
+				{
+					if (mNodes[i].Dependencies == 0)
+					{
+						Schedule(jobs, i, counter);
+					}
+				}
+				jobs.Wait(counter);
+			}
+
+			if (last < count)
+			{
+				mNodes[last].Work();
+			}
+			first = last + 1;
+		}
+	}
+
+	void TaskGraph::Clear()
+	{
+		mNodes.clear();
+		mUses.clear();
+	}
+
+	void TaskGraph::AddDependency(uint32_t before, uint32_t after)
+	{
+		if (before == NoTask || before == after)
+		{
+			return;
+		}
+
+		// Dependencies are only ever added to the newest task, so a repeat is always last.
+		vector<uint32_t>& dependents = mNodes[before].Dependents;
+		if (!dependents.empty() && dependents.back() == after)
+		{
+			return;
+		}
+
+		dependents.push_back(after);
+		++mNodes[after].Dependencies;
+	}
+
+	void TaskGraph::Schedule(JobSystem& jobs, uint32_t index, JobSystem::Counter& counter)
+	{
+		jobs.Run([this, &jobs, &counter, index]()
+		{
+			const Node& node = mNodes[index];
+			node.Work();
+
+			// Dependents are queued before this job counts as done, so the counter can't
+			// reach zero while any task is still to come.
+			for (uint32_t dependent : node.Dependents)
+			{
+				if (mPending[dependent].fetch_sub(1, memory_order_acq_rel) == 1)
+				{
+					Schedule(jobs, dependent, counter);
+				}
+			}
+		}, counter);
+	}
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "JobSystem.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Simulation
+{
+	// Runs a list of tasks on a JobSystem, in parallel wherever the order they were added in
+	// can't show. A task waits only for the earlier tasks that write something it reads or
+	// writes and for the earlier ones that read something it writes. Resources are named by
+	// whatever address the tasks agree on, usually that of the object touched. A task added
+	// exclusively runs on the thread calling Run(), after every task added before it and
+	// before every task added after it.
+	class TaskGraph final
+	{
+	public:
+		typedef std::function<void()> Task;
+		typedef const void* Resource;
+
+		struct Access final
+		{
+			std::vector<Resource> Reads;
+			std::vector<Resource> Writes;
+		};
+
+		TaskGraph();
+		TaskGraph(const TaskGraph&) = delete;
+		TaskGraph& operator=(const TaskGraph&) = delete;
+		TaskGraph(TaskGraph&&) = default;
+		TaskGraph& operator=(TaskGraph&&) = default;
+		~TaskGraph() = default;
+
+		std::uint32_t Count() const;
+
+		void Add(const Task& task, const Access& access);
+		void AddExclusive(const Task& task);
+
+		// Returns once every task has run. Tasks must not throw.
+		void Run(JobSystem& jobs);
+
+		// Drops the tasks; the graph keeps its memory for the next frame.
+		void Clear();
+
+	private:
+		struct Node final
+		{
+			Task Work;
+			std::vector<std::uint32_t> Dependents;
+			std::uint32_t Dependencies;
+			bool Exclusive;
+		};
+
+		// Who last wrote a resource and who has read it since.
+		struct ResourceUse final
+		{
+			std::uint32_t Writer;
+			std::vector<std::uint32_t> Readers;
+		};
+
+		void AddDependency(std::uint32_t before, std::uint32_t after);
+		void Schedule(JobSystem& jobs, std::uint32_t index, JobSystem::Counter& counter);
+
+		static const std::uint32_t NoTask;
+
+		std::vector<Node> mNodes;
+		std::unordered_map<Resource, ResourceUse> mUses;
+		std::unique_ptr<std::atomic<std::uint32_t>[]> mPending;
+		std::uint32_t mPendingCapacity;
+	};
+}
+
+#include "TaskGraph.inl"
@@ -0,0 +1,9 @@
+#pragma once
+
+namespace Simulation
+{
+	inline std::uint32_t TaskGraph::Count() const
+	{
+		return static_cast<std::uint32_t>(mNodes.size());
+	}
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Simulation
+{
+	// Remembers something built from a string drawn at a position (for the renderer, the
+	// geometry of that text) so that drawing it again next frame finds it instead of
+	// rebuilding it. Lookups compare a hash of the text before the text itself. Entries
+	// nobody asked for during the last MaxIdleFrames calls to EndFrame() are dropped, so
+	// text that changes every frame (a score, say) doesn't pile up.
+	template <typename T>
+	class TextCache final
+	{
+	public:
+		static const std::uint32_t DefaultMaxIdleFrames = 60;
+
+		explicit TextCache(std::uint32_t maxIdleFrames = DefaultMaxIdleFrames);
+		TextCache(const TextCache&) = default;
+		TextCache& operator=(const TextCache&) = default;
+		TextCache(TextCache&&) = default;
+		TextCache& operator=(TextCache&&) = default;
+		~TextCache() = default;
+
+		std::uint32_t Count() const;
+
+		// Returns nullptr on a miss. A hit keeps the entry alive for another MaxIdleFrames.
+		T* Find(const char* text, float x, float y);
+		T& Insert(const char* text, float x, float y, T value);
+
+		// Whether predicate holds for the value of any entry.
+		template <typename TPredicate>
+		bool AnyOf(const TPredicate& predicate) const;
+
+		// Returns how many entries were evicted.
+		std::uint32_t EndFrame();
+		void Clear();
+
+		static std::uint32_t Hash(const char* text);
+
+	private:
+		struct Entry final
+		{
+			std::uint32_t Hash;
+			float X;
+			float Y;
+			std::uint64_t LastUsed;
+			std::string Text;
+			T Value;
+		};
+
+		std::vector<Entry> mEntries;
+		std::uint64_t mFrame;
+		std::uint32_t mMaxIdleFrames;
+	};
+}
+
+#include "TextCache.inl"
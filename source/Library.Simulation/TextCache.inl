@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstring>
+#include <utility>
+
+namespace Simulation
+{
+	template <typename T>
+	const std::uint32_t TextCache<T>::DefaultMaxIdleFrames;
+
+	template <typename T>
+	inline TextCache<T>::TextCache(std::uint32_t maxIdleFrames) :
+		mFrame(0), mMaxIdleFrames(maxIdleFrames)
+	{
+	}
+
+	template <typename T>
+	inline std::uint32_t TextCache<T>::Count() const
+	{
+		return static_cast<std::uint32_t>(mEntries.size());
+	}
+
+	template <typename T>
+	inline T* TextCache<T>::Find(const char* text, float x, float y)
+	{
+		const std::uint32_t hash = Hash(text);
+		for (Entry& entry : mEntries)
+		{
+			if (entry.Hash == hash && entry.X == x && entry.Y == y && entry.Text == text)
+			{
+				entry.LastUsed = mFrame;
+				return &entry.Value;
+			}
+		}
+
+		return nullptr;
+	}
+
+	template <typename T>
+	inline T& TextCache<T>::Insert(const char* text, float x, float y, T value)
+	{
+		mEntries.push_back({ Hash(text), x, y, mFrame, text, std::move(value) });
+		return mEntries.back().Value;
+	}
+
+	template <typename T>
+	template <typename TPredicate>
+	inline bool TextCache<T>::AnyOf(const TPredicate& predicate) const
+	{
+		for (const Entry& entry : mEntries)
+		{
+			if (predicate(entry.Value))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	template <typename T>
+	inline std::uint32_t TextCache<T>::EndFrame()
+	{
+		std::uint32_t evicted = 0;
+		for (std::size_t i = 0; i < mEntries.size();)
+		{
+			if (mFrame - mEntries[i].LastUsed >= mMaxIdleFrames)
+			{
+				mEntries[i] = std::move(mEntries.back());
+				mEntries.pop_back();
+				++evicted;
+			}
+			else
+			{
+				++i;
+			}
+		}
+
+		++mFrame;
+		return evicted;
+	}
+
+	template <typename T>
+	inline void TextCache<T>::Clear()
+	{
+		mEntries.clear();
+	}
+
+	// FNV-1a.
+	template <typename T>
+	inline std::uint32_t TextCache<T>::Hash(const char* text)
+	{
+		std::uint32_t hash = 2166136261u;
+		for (const char* c = text; *c != '\0'; c++)
+		{
+			hash = (hash ^ static_cast<unsigned char>(*c)) * 16777619u;
+		}
+
+		return hash;
+	}
+}
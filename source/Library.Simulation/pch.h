@@ -0,0 +1,10 @@
+﻿#pragma once
+
+// Standard
+#include <cassert>
+#include <cstdint>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <algorithm>